@@ -0,0 +1,97 @@
+#include "core/Deck.h"
+#include "engine/BatchScheduler.h"
+#include "interfaces/IBatchActionProvider.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+
+// ────────────────────────────────────────────────────────
+// BatchScheduler throughput on one thread against a provider with a fixed
+// cost per call plus a small cost per decision, as a stand-in for batched
+// network inference. Larger batches amortise the fixed cost.
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+void spinFor(std::chrono::nanoseconds duration) {
+  const auto until = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < until) {
+  }
+}
+
+/// Spins 20 µs per call and 200 ns per decision, then checks or calls.
+class SimulatedInference : public poker::interfaces::IBatchActionProvider {
+public:
+  void getActions(std::span<const poker::interfaces::BatchDecision> decisions,
+                  std::span<Action> actions) override {
+    spinFor(std::chrono::microseconds(20) +
+            std::chrono::nanoseconds(200) * decisions.size());
+    for (size_t i = 0; i < decisions.size(); ++i) {
+      const auto legal = decisions[i].legalActions;
+      actions[i] = legal.front();
+      for (const auto &a : legal) {
+        if (a.type == ActionType::Check || a.type == ActionType::Call) {
+          actions[i] = a;
+          break;
+        }
+      }
+    }
+  }
+};
+
+void run(size_t maxBatch) {
+  constexpr size_t kTables = 1024;
+  constexpr size_t kHandsPerTable = 20;
+  constexpr size_t kPlayers = 6;
+
+  std::vector<GameState> tables(kTables);
+  BatchScheduler scheduler(std::make_shared<SimulatedInference>(),
+                           {maxBatch, std::chrono::milliseconds(5)});
+  for (size_t t = 0; t < kTables; ++t) {
+    std::vector<Player> players;
+    for (size_t i = 0; i < kPlayers; ++i)
+      players.emplace_back(i, "P" + std::to_string(i), 10000);
+    tables[t].setPlayers(std::move(players));
+    tables[t].setSmallBlind(50);
+    tables[t].setBigBlind(100);
+    scheduler.addTable(std::make_shared<Mt19937Generator>(t), tables[t]);
+  }
+
+  std::vector<size_t> hands(kTables, 0);
+  const auto start = std::chrono::steady_clock::now();
+  scheduler.run([&](size_t t, GameState &state) {
+    if (++hands[t] == kHandsPerTable)
+      return false;
+    for (auto &p : state.getMutablePlayers())
+      p.restoreBettingState(10000, 0, false, false);
+    state.setDealerPosition(hands[t] % kPlayers);
+    return true;
+  });
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  const BatchStats &stats = scheduler.getStats();
+  std::printf("  %8zu %12.0f %12.0f %10.1f %9llu\n", maxBatch,
+              static_cast<double>(stats.hands) / elapsed.count(),
+              static_cast<double>(stats.decisions) / elapsed.count(),
+              static_cast<double>(stats.decisions) /
+                  static_cast<double>(stats.batches),
+              static_cast<unsigned long long>(stats.deadlineFlushes));
+}
+
+} // namespace
+
+int main() {
+  std::printf("1024 tables x 20 hands, 6 players, one thread\n");
+  std::printf("  %8s %12s %12s %10s %9s\n", "maxBatch", "hands/s",
+              "decisions/s", "mean batch", "deadline");
+  for (size_t maxBatch : {1, 16, 64, 256, 1024})
+    run(maxBatch);
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include "core/Random.h"
+#include "utils/BucketTable.h"
+#include "utils/HandIndexer.h"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::utils;
+
+// ────────────────────────────────────────────────────────
+// Card abstraction lookups: hand-isomorphism index and mapped bucket
+// lookup per street, in nanoseconds, over random hands; then the cost of
+// the river equity stage per board.
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+struct Hand {
+  CardSet hole;
+  std::array<CardSet, 4> board; ///< By street.
+};
+
+std::vector<Hand> randomHands(size_t n) {
+  PhiloxGenerator rng(42);
+  std::vector<Card> deck(CardSet::fullDeck().begin(),
+                         CardSet::fullDeck().end());
+  std::vector<Hand> hands(n);
+  for (auto &h : hands) {
+    rng.shuffle(deck);
+    h.hole = CardSet::of(deck[0]) | CardSet::of(deck[1]);
+    constexpr size_t kBoardSize[] = {0, 3, 4, 5};
+    for (size_t s = 0; s < 4; ++s)
+      h.board[s] =
+          CardSet(std::span<const Card>(deck.data() + 2, kBoardSize[s]));
+  }
+  return hands;
+}
+
+template <typename Fn>
+double nanosPerHand(const std::vector<Hand> &hands, Fn fn) {
+  uint64_t sink = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto &h : hands)
+    sink += fn(h);
+  const std::chrono::duration<double, std::nano> dt =
+      std::chrono::steady_clock::now() - start;
+  volatile uint64_t keep = sink;
+  (void)keep;
+  return dt.count() / static_cast<double>(hands.size());
+}
+
+} // anonymous namespace
+
+int main() {
+  const auto hands = randomHands(1 << 20);
+  const char *names[] = {"preflop", "flop", "turn", "river"};
+
+  // A synthetic table with every street abstracted (river at two bytes).
+  BucketTable::Buckets buckets;
+  for (size_t s = 0; s < 4; ++s) {
+    const uint64_t n = HandIndexer::forStreet(static_cast<Street>(s)).size();
+    buckets[s].resize(n);
+    for (uint64_t i = 0; i < n; ++i)
+      buckets[s][i] = static_cast<uint16_t>(i % (s == 3 ? 1000 : 200));
+  }
+  const auto path =
+      (std::filesystem::temp_directory_path() / "bench_buckets.bin").string();
+  BucketTable::write(path, buckets);
+  buckets = {};
+  const BucketTable table = BucketTable::open(path);
+
+  std::printf("Lookups over %zu random hands\n", hands.size());
+  for (size_t s = 0; s < 4; ++s) {
+    const auto street = static_cast<Street>(s);
+    const HandIndexer &indexer = HandIndexer::forStreet(street);
+    const double index = nanosPerHand(hands, [&](const Hand &h) {
+      return indexer.index(h.hole, h.board[s]);
+    });
+    auto lookup = [&](const Hand &h) {
+      return table.bucket(street, h.hole, h.board[s]);
+    };
+    (void)nanosPerHand(hands, lookup); // Fault the table in.
+    const double bucket = nanosPerHand(hands, lookup);
+    std::printf("  %-8s %11llu classes  index %6.1f ns  bucket %6.1f ns\n",
+                names[s], static_cast<unsigned long long>(indexer.size()),
+                index, bucket);
+  }
+  std::filesystem::remove(path);
+
+  constexpr size_t kBoards = 2000;
+  std::array<float, Range::kNumCombos> equity;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kBoards; ++i)
+    BucketTable::riverEquities(hands[i].board[3], equity);
+  const std::chrono::duration<double, std::micro> dt =
+      std::chrono::steady_clock::now() - start;
+  std::printf("River equities  %8.1f us per board\n", dt.count() / kBoards);
+  return 0;
+}
@@ -0,0 +1,141 @@
+#include "core/CardSet.h"
+#include "utils/EquityCalculator.h"
+#include "utils/HandEvaluator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace poker::core;
+using namespace poker::utils;
+
+// ────────────────────────────────────────────────────────
+// Monte Carlo equity latency at a fixed accuracy (standard error target),
+// per thread count, for a few typical decision spots, followed by exact
+// enumeration of the spots whose hole cards are all known, and finally
+// range-vs-range equity against a naive pairwise baseline.
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+CardSet cards(const std::string &text) {
+  CardSet set;
+  for (size_t i = 0; i + 1 < text.size(); i += 2) {
+    unsigned rank = std::string("23456789TJQKA").find(text[i]) + 2;
+    unsigned suit = std::string("hdcs").find(text[i + 1]);
+    set.insert(Card(static_cast<Rank>(rank), static_cast<Suit>(suit)));
+  }
+  return set;
+}
+
+/// The obvious range-vs-range loop: evaluate every pair on every board.
+/// Returns seconds per board over the first `boards` rivers.
+double naiveSecondsPerBoard(const Range &hero, const Range &villain,
+                            CardSet turnBoard, size_t boards) {
+  auto start = std::chrono::steady_clock::now();
+  size_t done = 0;
+  double share = 0.0;
+  for (Card river : ~turnBoard) {
+    if (done++ == boards)
+      break;
+    CardSet board = turnBoard | CardSet::of(river);
+    for (size_t h = 0; h < Range::kNumCombos; ++h) {
+      CardSet hc = Range::comboCards(h);
+      if (hero.weight(h) == 0.0 || hc.intersects(board))
+        continue;
+      for (size_t v = 0; v < Range::kNumCombos; ++v) {
+        CardSet vc = Range::comboCards(v);
+        if (villain.weight(v) == 0.0 || vc.intersects(board | hc))
+          continue;
+        auto a = HandEvaluator::evaluateStrength(hc | board);
+        auto b = HandEvaluator::evaluateStrength(vc | board);
+        share += a > b ? 1.0 : (a == b ? 0.5 : 0.0);
+      }
+    }
+  }
+  std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+  volatile double sink = share;
+  (void)sink;
+  return dt.count() / static_cast<double>(boards);
+}
+
+struct Spot {
+  const char *name;
+  EquityQuery query;
+};
+
+} // namespace
+
+int main() {
+  Spot spots[] = {
+      {"AKs vs QQ preflop", {{cards("AsKs"), cards("QdQc")}, {}, {}}},
+      {"AA vs random preflop", {{cards("AsAh"), CardSet()}, {}, {}}},
+      {"3-way flop", {{cards("AsKs"), cards("JhJd"), cards("9c8c")},
+                      cards("Kd7c2s"), {}}},
+  };
+
+  EquityOptions options;
+  options.maxSamples = 0;
+  options.targetStdError = 0.001;
+  options.seed = 7;
+
+  const size_t maxThreads =
+      std::max<size_t>(1, std::thread::hardware_concurrency());
+  std::printf("Equity latency at stderr <= %.4f\n", options.targetStdError);
+  for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+    EquityCalculator calc(threads);
+    std::printf("threads=%zu\n", threads);
+    for (const auto &spot : spots) {
+      (void)calc.calculate(spot.query, options); // Warm up tables and pool.
+      auto r = calc.calculate(spot.query, options);
+      std::printf("  %-22s %8.2f ms  %9llu samples  %7.2f M samples/s  "
+                  "eq0=%.4f\n",
+                  spot.name, r.elapsedSeconds * 1e3,
+                  static_cast<unsigned long long>(r.samples),
+                  static_cast<double>(r.samples) / r.elapsedSeconds / 1e6,
+                  r.players[0].equity);
+    }
+  }
+
+  std::printf("Exact enumeration\n");
+  for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+    EquityCalculator calc(threads);
+    std::printf("threads=%zu\n", threads);
+    for (const auto &spot : spots) {
+      bool known = true;
+      for (const auto &hole : spot.query.holeCards)
+        known = known && hole.size() == 2;
+      if (!known)
+        continue;
+      auto r = calc.enumerate(spot.query);
+      std::printf("  %-22s %8.2f ms  %9llu runouts  %9llu evaluated  "
+                  "eq0=%.6f\n",
+                  spot.name, r.elapsedSeconds * 1e3,
+                  static_cast<unsigned long long>(r.samples),
+                  static_cast<unsigned long long>(r.evaluated),
+                  r.players[0].equity);
+    }
+  }
+
+  RangeEquityQuery rq;
+  rq.hero = Range::parse("22+,A2s+,K9s+,QTs+,JTs,ATo+,KJo+");
+  rq.villain = Range::parse("55+,A8s+,KTs+,QJs,AJo+,KQo");
+  rq.board = cards("Kh9s6d");
+  std::printf("Range vs range (%zu vs %zu combos) on Kh9s6d\n",
+              rq.hero.size(), rq.villain.size());
+  for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+    EquityCalculator calc(threads);
+    auto r = calc.rangeEquity(rq);
+    std::printf("  threads=%zu  %8.2f ms  %5llu boards  %8.1f us/board  "
+                "eq=%.4f\n",
+                threads, r.elapsedSeconds * 1e3,
+                static_cast<unsigned long long>(r.boards),
+                r.elapsedSeconds * 1e6 / static_cast<double>(r.boards),
+                r.equity);
+  }
+  double naive =
+      naiveSecondsPerBoard(rq.hero, rq.villain, rq.board | cards("2c"), 8);
+  std::printf("  naive pairwise       %8.1f us/board\n", naive * 1e6);
+  return 0;
+}
@@ -0,0 +1,170 @@
+#include "core/Random.h"
+#include "engine/HandHistory.h"
+#include "engine/PokerEngine.h"
+#include "engine/Replay.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+
+// ────────────────────────────────────────────────────────
+// Hand-history throughput: 6-handed self-play recorded through the engine
+// observer, then the file scanned hand by hand through the mapping (ids
+// only), decoded in full, and sought into at random decision points.
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kPlayers = 6;
+constexpr size_t kHands = 500000;
+constexpr size_t kScans = 20;
+
+/// Calls or checks most of the time, with occasional raises, all-ins and
+/// folds, so records carry realistic action logs.
+struct MixedPolicy {
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+
+  Action getAction(size_t, const GameState &,
+                   const std::vector<Action> &legal) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    const unsigned roll = static_cast<unsigned>(state % 100);
+    auto pick = [&](ActionType t) -> const Action * {
+      for (const auto &a : legal)
+        if (a.type == t)
+          return &a;
+      return nullptr;
+    };
+    const Action *a = nullptr;
+    if (roll < 15)
+      a = pick(ActionType::Fold);
+    else if (roll < 25)
+      a = pick(ActionType::Raise) ? pick(ActionType::Raise)
+                                  : pick(ActionType::Bet);
+    else if (roll < 27)
+      a = pick(ActionType::AllIn);
+    if (!a)
+      a = pick(ActionType::Check) ? pick(ActionType::Check)
+                                  : pick(ActionType::Call);
+    return a ? *a : legal.front();
+  }
+};
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "bench_hand_history.phh")
+          .string();
+  std::filesystem::remove(path);
+
+  GameState fresh;
+  std::vector<Player> players;
+  for (size_t i = 0; i < kPlayers; ++i)
+    players.emplace_back(i, "P" + std::to_string(i), 10000);
+  fresh.setPlayers(std::move(players));
+  fresh.setSmallBlind(50);
+  fresh.setBigBlind(100);
+
+  // --- Record ---
+  double recordSeconds = 0.0;
+  {
+    HandHistoryWriter writer(path);
+    BasicPokerEngine<MixedPolicy, Xoshiro256Generator, HandHistoryObserver>
+        engine(MixedPolicy{}, Xoshiro256Generator(42),
+               HandHistoryObserver{&writer});
+    GameState state = fresh;
+    const auto start = Clock::now();
+    for (size_t h = 0; h < kHands; ++h) {
+      state = fresh;
+      state.setDealerPosition(h % kPlayers);
+      engine.playHand(state);
+    }
+    writer.flush();
+    recordSeconds = secondsSince(start);
+  }
+
+  HandHistoryReader reader = HandHistoryReader::open(path);
+  const double bytes = static_cast<double>(reader.fileSize());
+  std::printf("%zu hands, %zu players: %.1f MB, %.1f bytes/hand\n",
+              reader.size(), kPlayers, bytes / 1e6,
+              (bytes - hand_history::kHeaderSize) /
+                  static_cast<double>(reader.size()));
+  std::printf("  play + record   %10.0f hands/s\n",
+              static_cast<double>(kHands) / recordSeconds);
+
+  // --- Scan: walk every record and read its id from the mapping ---
+  uint64_t sink = 0;
+  double best = 1e30;
+  for (size_t r = 0; r < kScans; ++r) {
+    const auto start = Clock::now();
+    for (const HandView &view : reader)
+      sink += view.handId() + view.bytes().size();
+    best = std::min(best, secondsSince(start));
+  }
+  std::printf("  scan            %10.2f GB/s   %8.0f M hands/s\n",
+              bytes / best / 1e9,
+              static_cast<double>(reader.size()) / best / 1e6);
+
+  // --- Decode every hand into a reused record ---
+  HandRecord record;
+  auto start = Clock::now();
+  for (const HandView &view : reader) {
+    view.decode(record);
+    sink += record.actions.size();
+  }
+  const double decodeSeconds = secondsSince(start);
+  std::printf("  full decode     %10.2f GB/s   %8.1f M hands/s\n",
+              bytes / decodeSeconds / 1e9,
+              static_cast<double>(reader.size()) / decodeSeconds / 1e6);
+
+  // --- Replay: stateAt() at random (hand, action) points ---
+  constexpr size_t kSeeks = 200000;
+  Replay replay(reader);
+  Xoshiro256Generator rng(9);
+  start = Clock::now();
+  for (size_t i = 0; i < kSeeks; ++i) {
+    const uint64_t hand = rng.below(static_cast<uint32_t>(kHands));
+    const size_t actions = replay.record(hand).actions.size();
+    const auto index = rng.below(static_cast<uint32_t>(actions + 1));
+    sink += replay.stateAt(hand, index).getPot().getTotal();
+  }
+  const double randomSeconds = secondsSince(start);
+
+  // Within one long hand, where the street snapshots bound each seek.
+  uint64_t longest = 0;
+  for (uint64_t hand = 0; hand < 1000; ++hand) {
+    if (replay.record(hand).actions.size() >
+        replay.record(longest).actions.size())
+      longest = hand;
+  }
+  const size_t longestActions = replay.record(longest).actions.size();
+  start = Clock::now();
+  for (size_t i = 0; i < kSeeks; ++i) {
+    const auto index = rng.below(static_cast<uint32_t>(longestActions + 1));
+    sink += replay.stateAt(longest, index).getPot().getTotal();
+  }
+  const double sameHandSeconds = secondsSince(start);
+  std::printf("  stateAt, random hand       %8.2f M seeks/s\n",
+              static_cast<double>(kSeeks) / randomSeconds / 1e6);
+  std::printf("  stateAt, one %2zu-action hand %8.2f M seeks/s\n",
+              longestActions,
+              static_cast<double>(kSeeks) / sameHandSeconds / 1e6);
+
+  std::printf("(checksum %llu)\n", static_cast<unsigned long long>(sink));
+  std::filesystem::remove(path);
+  return 0;
+}
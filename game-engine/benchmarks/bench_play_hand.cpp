@@ -0,0 +1,154 @@
+#include "core/Deck.h"
+#include "core/Random.h"
+#include "engine/PokerEngine.h"
+#include "interfaces/IActionProvider.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+
+// ────────────────────────────────────────────────────────
+// PokerEngine::playHand throughput for 6-handed self-play, with heap
+// allocations per hand counted by a replaced global operator new. The
+// type-erased engines are compared with one whose provider and RNG are
+// concrete template arguments.
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+std::atomic<uint64_t> gAllocations{0};
+
+/// Calls or checks most of the time, with occasional raises, all-ins and
+/// folds. Draws from its own xorshift so it never allocates, and reads the
+/// engine's ActionList directly.
+class MixedProvider final : public poker::interfaces::IActionProvider {
+public:
+  Action getAction(size_t, const GameState &,
+                   const std::vector<Action> &legal) override {
+    return choose(legal);
+  }
+  Action chooseAction(size_t, const GameState &,
+                      const ActionList &legal) override {
+    return choose(legal);
+  }
+
+private:
+  template <typename Legal> Action choose(const Legal &legal) {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 7;
+    state_ ^= state_ << 17;
+    const unsigned roll = static_cast<unsigned>(state_ % 100);
+    auto pick = [&](ActionType t) -> const Action * {
+      for (const auto &a : legal)
+        if (a.type == t)
+          return &a;
+      return nullptr;
+    };
+    const Action *a = nullptr;
+    if (roll < 10)
+      a = pick(ActionType::Fold);
+    else if (roll < 20)
+      a = pick(ActionType::Raise) ? pick(ActionType::Raise)
+                                  : pick(ActionType::Bet);
+    else if (roll < 22)
+      a = pick(ActionType::AllIn);
+    if (!a)
+      a = pick(ActionType::Check) ? pick(ActionType::Check)
+                                  : pick(ActionType::Call);
+    return a ? *a : legal.front();
+  }
+
+  uint64_t state_ = 0x9E3779B97F4A7C15ull;
+};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+/// Plays kRounds x kHands 6-handed hands on the engine from makeEngine()
+/// and reports the best round's throughput (the least disturbed by other
+/// load) and heap allocations per hand over all rounds.
+template <typename MakeEngine>
+void run(const char *label, MakeEngine makeEngine) {
+  constexpr size_t kPlayers = 6;
+  constexpr size_t kHands = 50000;
+  constexpr size_t kRounds = 5;
+
+  auto engine = makeEngine();
+
+  GameState fresh;
+  std::vector<Player> players;
+  for (size_t i = 0; i < kPlayers; ++i)
+    players.emplace_back(i, std::string(1, 'P') += std::to_string(i), 10000);
+  fresh.setPlayers(std::move(players));
+  fresh.setSmallBlind(50);
+  fresh.setBigBlind(100);
+
+  // Stacks are restored each hand so every hand is a full 6-way hand.
+  GameState state = fresh;
+  auto play = [&](size_t hand) {
+    state = fresh;
+    state.setDealerPosition(hand % kPlayers);
+    engine->playHand(state);
+  };
+  for (size_t h = 0; h < 1000; ++h)
+    play(h); // Warm-up: reach steady-state buffer capacities.
+
+  const uint64_t allocBefore = gAllocations.load();
+  double best = 0.0;
+  for (size_t r = 0; r < kRounds; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t h = 0; h < kHands; ++h)
+      play(h);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::max(best, static_cast<double>(kHands) / elapsed.count());
+  }
+  const uint64_t allocs = gAllocations.load() - allocBefore;
+
+  std::printf("%s, %zu players, %zu x %zu hands\n", label, kPlayers, kRounds,
+              kHands);
+  std::printf("  %10.0f hands/s   %6.2f allocations/hand\n", best,
+              static_cast<double>(allocs) /
+                  static_cast<double>(kRounds * kHands));
+}
+
+int main() {
+  run("PokerEngine (no callback)", [] {
+    return std::make_unique<PokerEngine>(
+        std::make_shared<MixedProvider>(),
+        std::make_shared<Mt19937Generator>(42));
+  });
+  run("HeadlessPokerEngine", [] {
+    return std::make_unique<HeadlessPokerEngine>(
+        std::make_shared<MixedProvider>(),
+        std::make_shared<Mt19937Generator>(42));
+  });
+  run("BasicPokerEngine<MixedProvider, Mt19937Generator, NullObserver>", [] {
+    return std::make_unique<
+        BasicPokerEngine<MixedProvider, Mt19937Generator, NullObserver>>(
+        MixedProvider{}, Mt19937Generator(42));
+  });
+  run("BasicPokerEngine<MixedProvider, Xoshiro256Generator, NullObserver>",
+      [] {
+        return std::make_unique<BasicPokerEngine<
+            MixedProvider, Xoshiro256Generator, NullObserver>>(
+            MixedProvider{}, Xoshiro256Generator(42));
+      });
+  return 0;
+}
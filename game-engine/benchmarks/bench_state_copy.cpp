@@ -0,0 +1,107 @@
+#include "core/CompactGameState.h"
+#include "core/Deck.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace poker::core;
+
+// ────────────────────────────────────────────────────────
+// Cost of snapshotting a mid-hand 6-handed state: copying a GameState
+// versus copying a CompactGameState, with heap allocations per copy.
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+std::atomic<uint64_t> gAllocations{0};
+
+using Clock = std::chrono::steady_clock;
+
+/// A turn-street state with blinds, a few actions and hole cards dealt.
+GameState makeState() {
+  GameState state;
+  std::vector<Player> players;
+  for (size_t i = 0; i < 6; ++i)
+    players.emplace_back(i, "Player " + std::to_string(i), 10000);
+  state.setPlayers(std::move(players));
+  state.setSmallBlind(50);
+  state.setBigBlind(100);
+  state.resetForNewHand();
+
+  Deck deck;
+  for (auto &p : state.getMutablePlayers()) {
+    p.dealCard(*deck.deal());
+    p.dealCard(*deck.deal());
+  }
+  for (int i = 0; i < 4; ++i)
+    state.addCommunityCard(*deck.deal());
+  for (size_t round = 0; round < 3; ++round) {
+    for (size_t i = 0; i < 6; ++i) {
+      auto &p = state.getMutablePlayer(i);
+      const int64_t bet = p.placeBet(100);
+      state.getMutablePot().addContribution(i, bet);
+      state.recordAction(Action(ActionType::Call, bet, i));
+    }
+  }
+  state.setStreet(Street::Turn);
+  return state;
+}
+
+template <typename T> void measure(const char *name, const T &source) {
+  constexpr size_t kCopies = 1'000'000;
+  std::vector<T> sink(16, source);
+  const uint64_t before = gAllocations.load();
+  const auto start = Clock::now();
+  for (size_t i = 0; i < kCopies; ++i)
+    sink[i % sink.size()] = source;
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  const uint64_t allocs = gAllocations.load() - before;
+  std::printf("  %-18s %5zu bytes  %8.1f ns/copy  %6.2f allocations/copy\n",
+              name, sizeof(T), elapsed.count() * 1e9 / kCopies,
+              static_cast<double>(allocs) / kCopies);
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+  const GameState state = makeState();
+  const CompactGameState compact = CompactGameState::fromGameState(state);
+
+  std::printf("Snapshot copies, 6 players on the turn\n");
+  // Copy-assignment into live objects reuses their buffers; a fresh copy
+  // (as a search node would make) always allocates.
+  measure("GameState (assign)", state);
+  {
+    constexpr size_t kCopies = 200'000;
+    const uint64_t before = gAllocations.load();
+    const auto start = Clock::now();
+    size_t checksum = 0;
+    for (size_t i = 0; i < kCopies; ++i) {
+      GameState copy = state;
+      checksum += copy.getActionHistory().size();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    std::printf("  %-18s %5zu bytes  %8.1f ns/copy  %6.2f allocations/copy"
+                "  (checksum %zu)\n",
+                "GameState (fresh)", sizeof(GameState),
+                elapsed.count() * 1e9 / kCopies,
+                static_cast<double>(gAllocations.load() - before) / kCopies,
+                checksum);
+  }
+  measure("CompactGameState", compact);
+  return 0;
+}
@@ -20,6 +20,7 @@
 #include <atomic>
 #include <deque>
 #include <map>
+#include <variant>
 
 using namespace poker::core;
 using namespace poker::engine;
@@ -141,21 +142,34 @@ void gameThreadFunc() {
     auto actionProvider = std::make_shared<GuiActionProvider>();
     PokerEngine engine(actionProvider, rng);
 
-    engine.setEventCallback([](const std::string &event, const GameState &state) {
+    engine.setEventCallback([](const HandEvent &event, const GameState &state) {
+        std::string msg = std::visit(Overloaded{
+            [](const HandStarted &) -> std::string { return "--- New Hand ---"; },
+            [](const StreetStarted &e) -> std::string {
+                static const char *names[] = {"Preflop", "Flop", "Turn", "River"};
+                return std::string("--- ") + names[static_cast<size_t>(e.street)] + " ---";
+            },
+            [](const ActionTaken &e) {
+                std::string s = "Player " + std::to_string(e.action.playerId) + ": " +
+                                Action::actionTypeName(e.action.type);
+                if (e.action.amount > 0) s += " " + std::to_string(e.action.amount);
+                return s;
+            },
+            [](const ShowdownStarted &) -> std::string { return "--- Showdown ---"; },
+            [&state](const PotAwarded &e) {
+                std::string s = "Winner:";
+                for (const auto &p : state.getPlayers()) {
+                    if (e.winners & seatBit(p.getId())) s += " " + p.getName();
+                }
+                return s + " (" + std::to_string(e.amount) + ")";
+            },
+            [](const auto &) { return std::string(); },
+        }, event);
+
         std::lock_guard<std::mutex> lock(stateMutex);
         renderState.gs = state;
-        renderState.lastEvent = event;
-        
-        std::string msg = event;
-        if (event == "hand_start") msg = "--- New Hand ---";
-        else if (event.starts_with("street_")) msg = "--- " + event.substr(7) + " ---";
-        else if (event.starts_with("winner_")) msg = "Winner: " + event.substr(7);
-        else if (event == "action") {
-            const auto& a = state.getActionHistory().back();
-            msg = "Player " + std::to_string(a.playerId) + ": " + Action::actionTypeName(a.type);
-            if(a.amount > 0) msg += " " + std::to_string(a.amount);
-        }
-        
+        if (msg.empty()) return;
+        renderState.lastEvent = msg;
         renderState.messages.push_back(msg);
         if (renderState.messages.size() > 20) renderState.messages.pop_front();
     });
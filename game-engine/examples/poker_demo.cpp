@@ -11,6 +11,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <variant>
 
 
 using namespace poker::core;
@@ -172,52 +173,67 @@ private:
 // ────────────────────────────────────────────────────────
 // Event printer — shows game progress
 // ────────────────────────────────────────────────────────
-void printEvent(const std::string &event, const GameState &state) {
-  if (event == "hand_start") {
-    std::cout << "\n--- New Hand ---\n";
-    std::cout << "Dealer: "
-              << state.getPlayer(state.getDealerPosition()).getName() << "\n";
-  } else if (event == "deal_hole_cards") {
-    const auto &you = state.getPlayer(0);
-    std::cout << "Your cards: " << you.getHoleCards()[0] << " "
-              << you.getHoleCards()[1] << "\n";
-  } else if (event.starts_with("street_")) {
-    std::string street = event.substr(7);
-    street[0] = static_cast<char>(std::toupper(street[0]));
-    std::cout << "\n--- " << street << " ---\n";
-    if (!state.getCommunityCards().empty()) {
-      std::cout << "Board: ";
-      for (const auto &c : state.getCommunityCards())
-        std::cout << c << " ";
-      std::cout << "\n";
-    }
-    std::cout << "Pot: " << state.getPot().getTotal()
-              << "  |  You: " << state.getPlayer(0).getChips()
-              << "  Bot: " << state.getPlayer(1).getChips() << "\n";
-  } else if (event == "action") {
-    const auto &a = state.getActionHistory().back();
-    if (a.playerId == 1) {
-      std::cout << "  Bot: " << Action::actionTypeName(a.type);
-      if (a.amount > 0)
-        std::cout << " " << a.amount;
-      std::cout << "\n";
-    }
-  } else if (event == "showdown") {
-    std::cout << "\n=== Showdown ===\n";
-    std::cout << "Board: ";
-    for (const auto &c : state.getCommunityCards())
-      std::cout << c << " ";
-    std::cout << "\n";
-    const auto &bot = state.getPlayer(1);
-    if (!bot.isFolded()) {
-      std::cout << "Bot's cards: " << bot.getHoleCards()[0] << " "
-                << bot.getHoleCards()[1] << "\n";
-    }
-  } else if (event.starts_with("winner_")) {
-    std::cout << "Winner: " << event.substr(7) << "\n";
-  } else if (event == "pot_awarded") {
-    std::cout << "Pot awarded.\n";
-  }
+void printBoard(const GameState &state) {
+  for (const auto &c : state.getCommunityCards())
+    std::cout << c << " ";
+  std::cout << "\n";
+}
+
+void printEvent(const HandEvent &event, const GameState &state) {
+  std::visit(
+      Overloaded{
+          [&](const HandStarted &e) {
+            std::cout << "\n--- New Hand ---\n";
+            std::cout << "Dealer: " << state.getPlayer(e.dealer).getName()
+                      << "\n";
+          },
+          [&](const HoleCardsDealt &) {
+            const auto &you = state.getPlayer(0);
+            std::cout << "Your cards: " << you.getHoleCards()[0] << " "
+                      << you.getHoleCards()[1] << "\n";
+          },
+          [&](const StreetStarted &e) {
+            static constexpr const char *kNames[] = {"Preflop", "Flop",
+                                                     "Turn", "River"};
+            std::cout << "\n--- " << kNames[static_cast<size_t>(e.street)]
+                      << " ---\n";
+            if (!e.board.empty()) {
+              std::cout << "Board: ";
+              printBoard(state);
+            }
+            std::cout << "Pot: " << e.pot
+                      << "  |  You: " << state.getPlayer(0).getChips()
+                      << "  Bot: " << state.getPlayer(1).getChips() << "\n";
+          },
+          [&](const ActionTaken &e) {
+            if (e.action.playerId == 1) {
+              std::cout << "  Bot: " << Action::actionTypeName(e.action.type);
+              if (e.action.amount > 0)
+                std::cout << " " << e.action.amount;
+              std::cout << "\n";
+            }
+          },
+          [&](const ShowdownStarted &) {
+            std::cout << "\n=== Showdown ===\n";
+            std::cout << "Board: ";
+            printBoard(state);
+            const auto &bot = state.getPlayer(1);
+            if (!bot.isFolded()) {
+              std::cout << "Bot's cards: " << bot.getHoleCards()[0] << " "
+                        << bot.getHoleCards()[1] << "\n";
+            }
+          },
+          [&](const PotAwarded &e) {
+            std::cout << "Winner:";
+            for (const auto &p : state.getPlayers()) {
+              if (e.winners & seatBit(p.getId()))
+                std::cout << " " << p.getName();
+            }
+            std::cout << " (" << e.amount << ")\n";
+          },
+          [](const auto &) {},
+      },
+      event);
 }
 
 // ────────────────────────────────────────────────────────
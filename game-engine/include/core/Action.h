@@ -22,6 +22,8 @@ struct Action {
   constexpr Action(ActionType t, int64_t amt, size_t pid) noexcept
       : type(t), amount(amt), playerId(pid) {}
 
+  constexpr bool operator==(const Action &) const noexcept = default;
+
   [[nodiscard]] std::string toString() const;
   [[nodiscard]] static std::string actionTypeName(ActionType t);
 };
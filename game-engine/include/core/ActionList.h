@@ -0,0 +1,112 @@
+#pragma once
+
+#include "core/Action.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+
+namespace poker::core {
+
+/// Bit of an action type within an ActionTypeMask.
+using ActionTypeMask = uint8_t;
+
+[[nodiscard]] constexpr ActionTypeMask actionTypeBit(ActionType t) noexcept {
+  return static_cast<ActionTypeMask>(1u << static_cast<unsigned>(t));
+}
+
+/// @brief The legal actions at one decision, stored inline.
+///
+/// The rules never offer more than one action of each type, so six slots
+/// always suffice and filling a list never touches the heap. Alongside the
+/// actions the list keeps a bitmask of the types it holds, so "can this
+/// player raise?" is a single AND rather than a scan.
+///
+/// Converts to std::span<const Action> for code that only reads.
+class ActionList {
+public:
+  static constexpr size_t kCapacity = 6;
+
+  using value_type = Action;
+  using const_iterator = const Action *;
+
+  constexpr ActionList() noexcept = default;
+
+  /// Append an action. Throws std::length_error when full.
+  constexpr void push_back(const Action &action) {
+    if (size_ == kCapacity) {
+      throw std::length_error("ActionList: more than kCapacity actions");
+    }
+    actions_[size_++] = action;
+    types_ |= actionTypeBit(action.type);
+  }
+  constexpr void emplace_back(ActionType type, int64_t amount,
+                              size_t playerId) {
+    push_back(Action(type, amount, playerId));
+  }
+  constexpr void clear() noexcept {
+    size_ = 0;
+    types_ = 0;
+  }
+
+  [[nodiscard]] constexpr size_t size() const noexcept { return size_; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] constexpr const Action &operator[](size_t i) const noexcept {
+    return actions_[i];
+  }
+  [[nodiscard]] constexpr const Action &front() const noexcept {
+    return actions_[0];
+  }
+  [[nodiscard]] constexpr const Action *data() const noexcept {
+    return actions_.data();
+  }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept {
+    return actions_.data();
+  }
+  [[nodiscard]] constexpr const_iterator end() const noexcept {
+    return actions_.data() + size_;
+  }
+
+  /// Types present, one actionTypeBit() each.
+  [[nodiscard]] constexpr ActionTypeMask types() const noexcept {
+    return types_;
+  }
+  [[nodiscard]] constexpr bool contains(ActionType t) const noexcept {
+    return (types_ & actionTypeBit(t)) != 0;
+  }
+  /// The action of type t, or nullptr if there is none.
+  [[nodiscard]] constexpr const Action *find(ActionType t) const noexcept {
+    if (!contains(t))
+      return nullptr;
+    for (const Action &a : *this) {
+      if (a.type == t)
+        return &a;
+    }
+    return nullptr;
+  }
+
+  constexpr operator std::span<const Action>() const noexcept {
+    return {actions_.data(), size_};
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const ActionList &a,
+                                                 const ActionList &b) noexcept {
+    if (a.size_ != b.size_ || a.types_ != b.types_)
+      return false;
+    for (size_t i = 0; i < a.size_; ++i) {
+      if (!(a.actions_[i] == b.actions_[i]))
+        return false;
+    }
+    return true;
+  }
+
+private:
+  std::array<Action, kCapacity> actions_{};
+  uint8_t size_ = 0;
+  ActionTypeMask types_ = 0;
+};
+
+} // namespace poker::core
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "core/SeatMask.h"
+
+#include <bit>
 #include <cstdint>
 #include <cstddef>
 
@@ -8,49 +11,94 @@ namespace poker::core {
 /// The current street / phase of the hand.
 enum class Street : uint8_t { Preflop, Flop, Turn, River, Showdown };
 
-/// @brief Tracks state within a single betting round.
+/// @brief Tracks who still has to act within a single betting round.
+///
+/// Seats are kept in bitmasks: those that can still act at all (in the
+/// hand and not all-in), those that still owe an action at the current
+/// bet level, and those still allowed to raise. Recording an action and
+/// finding the next seat to act are a few bit operations each.
+///
+/// The round also carries the betting context the rules need, kept up to
+/// date as actions are recorded: the bet level, the last full raise
+/// increment, and whether action has been reopened. A raise of at least
+/// the last full increment reopens raising to every seat. A smaller
+/// (all-in) raise must still be answered, but seats that have acted since
+/// the last full raise may only call or fold.
 class BettingRound {
 public:
-  explicit BettingRound(size_t numPlayers, size_t firstToAct,
-                        int64_t existingBet = 0);
-
-  /// Advance to the next player who hasn't folded or gone all-in.
-  /// @param folded  function(playerId) -> true if folded or all-in
-  template <typename Pred> void advanceToNextActive(Pred isFoldedOrAllIn) {
-    do {
-      currentIndex_ = (currentIndex_ + 1) % numPlayers_;
-    } while (isFoldedOrAllIn(currentIndex_) && ++skipped_ < numPlayers_);
-  }
+  /// @param numPlayers    Seats at the table (at most kMaxSeats).
+  /// @param firstToAct    Seat where action starts; seats that cannot act
+  ///                      are skipped.
+  /// @param canAct        Seats that are in the hand and not all-in.
+  /// @param currentBet    Bet level already faced (e.g. the big blind).
+  /// @param minRaiseSize  Smallest full raise increment, normally the big
+  ///                      blind. With 0 every raise counts as full.
+  BettingRound(size_t numPlayers, size_t firstToAct, SeatMask canAct,
+               int64_t currentBet = 0, int64_t minRaiseSize = 0);
+
+  /// Record the current player's action and move to the next seat that
+  /// still has to act.
+  /// @param newBet       The player's total bet this round after acting.
+  ///                     Anything above the current level is a raise and
+  ///                     re-opens action for every other seat that can act.
+  /// @param canActAgain  False if the player folded or is now all-in.
+  void playerActed(int64_t newBet, bool canActAgain);
 
-  /// Mark that the current player has acted.
-  void playerActed(int64_t newBet);
+  /// Drop the current seat from the round without counting an action
+  /// (e.g. it has no legal actions) and move on.
+  void skipCurrent() noexcept;
 
-  /// Has every active player had a chance to act and the bets are settled?
-  [[nodiscard]] bool isComplete() const noexcept;
+  /// True once no seat owes an action.
+  [[nodiscard]] bool isComplete() const noexcept { return pending_ == 0; }
 
   [[nodiscard]] size_t getCurrentPlayerIndex() const noexcept {
     return currentIndex_;
   }
+  [[nodiscard]] bool needsToAct(size_t seat) const noexcept {
+    return (pending_ & seatBit(seat)) != 0;
+  }
+  [[nodiscard]] SeatMask getPendingSeats() const noexcept { return pending_; }
+  [[nodiscard]] SeatMask getActiveSeats() const noexcept { return active_; }
   [[nodiscard]] int64_t getCurrentBet() const noexcept { return currentBet_; }
+  /// Increment of the last full bet or raise (minRaiseSize until one):
+  /// the smallest legal raise is to getCurrentBet() + getLastRaiseSize().
+  [[nodiscard]] int64_t getLastRaiseSize() const noexcept {
+    return lastRaiseSize_;
+  }
+  /// False if a short all-in raise left this seat only call or fold.
+  [[nodiscard]] bool canRaise(size_t seat) const noexcept {
+    return (raiseOpen_ & seatBit(seat)) != 0;
+  }
   [[nodiscard]] size_t getActionsThisRound() const noexcept {
     return actionsThisRound_;
   }
   [[nodiscard]] size_t getNumRaises() const noexcept { return numRaises_; }
-
-  void setLastAggressor(size_t idx) noexcept { lastAggressor_ = idx; }
+  /// Seat of the last bet or raise this round (firstToAct until one).
   [[nodiscard]] size_t getLastAggressor() const noexcept {
     return lastAggressor_;
   }
 
 private:
-  size_t numPlayers_;
+  /// Move to the first pending seat after the current one, wrapping.
+  void advance() noexcept {
+    if (pending_ == 0)
+      return;
+    // Seats strictly after the current one (empty for the last seat).
+    const SeatMask after = pending_ & ~((seatBit(currentIndex_) << 1) - 1);
+    currentIndex_ = static_cast<size_t>(std::countr_zero(after ? after : pending_));
+  }
+
+  SeatMask active_;
+  SeatMask pending_;
+  SeatMask raiseOpen_;           ///< Seats that may still raise.
+  SeatMask actedSinceRaise_ = 0; ///< Seats that acted since the last full
+                                 ///< raise.
   size_t currentIndex_;
   int64_t currentBet_;
+  int64_t lastRaiseSize_;
   size_t actionsThisRound_ = 0;
   size_t numRaises_ = 0;
   size_t lastAggressor_;
-  size_t playersToAct_;
-  size_t skipped_ = 0;
 };
 
 } // namespace poker::core
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "core/Card.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string>
+
+
+namespace poker::core {
+
+/// @brief A set of cards packed into a single 64-bit mask.
+///
+/// Each suit owns a 16-bit lane and each rank a bit within it:
+/// bit = 16 * suit + (rank - 2). Membership, union, intersection and size
+/// are single ALU operations, and a suit's 13-bit rank mask is one shift.
+class CardSet {
+public:
+  static constexpr unsigned kBitsPerSuit = 16;
+  static constexpr uint64_t kRankMask = 0x1FFF;
+  static constexpr uint64_t kFullDeckBits = 0x1FFF1FFF1FFF1FFFull;
+
+  constexpr CardSet() noexcept = default;
+  constexpr explicit CardSet(uint64_t bits) noexcept : bits_(bits) {}
+  constexpr explicit CardSet(std::span<const Card> cards) noexcept {
+    for (const auto &c : cards)
+      insert(c);
+  }
+
+  [[nodiscard]] static constexpr CardSet fullDeck() noexcept {
+    return CardSet(kFullDeckBits);
+  }
+  [[nodiscard]] static constexpr CardSet of(Card c) noexcept {
+    return CardSet(uint64_t{1} << bitIndex(c));
+  }
+
+  // --- Index conversion ---
+
+  /// Bit position of a card within the mask (0..60, with gaps).
+  [[nodiscard]] static constexpr unsigned bitIndex(Card c) noexcept {
+    return static_cast<unsigned>(c.suit) * kBitsPerSuit +
+           (static_cast<unsigned>(c.rank) - 2);
+  }
+  [[nodiscard]] static constexpr Card fromBitIndex(unsigned bit) noexcept {
+    return Card(static_cast<Rank>(bit % kBitsPerSuit + 2),
+                static_cast<Suit>(bit / kBitsPerSuit));
+  }
+
+  /// Dense card index 0..51 (suit-major, matching a fresh Deck's order).
+  [[nodiscard]] static constexpr unsigned toIndex(Card c) noexcept {
+    return static_cast<unsigned>(c.suit) * 13 +
+           (static_cast<unsigned>(c.rank) - 2);
+  }
+  [[nodiscard]] static constexpr Card fromIndex(unsigned index) noexcept {
+    return Card(static_cast<Rank>(index % 13 + 2),
+                static_cast<Suit>(index / 13));
+  }
+
+  // --- Queries ---
+  [[nodiscard]] constexpr uint64_t bits() const noexcept { return bits_; }
+  [[nodiscard]] constexpr size_t size() const noexcept {
+    return static_cast<size_t>(std::popcount(bits_));
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept { return bits_ == 0; }
+  [[nodiscard]] constexpr bool contains(Card c) const noexcept {
+    return (bits_ >> bitIndex(c)) & 1;
+  }
+  [[nodiscard]] constexpr bool intersects(CardSet other) const noexcept {
+    return (bits_ & other.bits_) != 0;
+  }
+  /// 13-bit rank mask of one suit (bit 0 = Two).
+  [[nodiscard]] constexpr uint32_t suitMask(Suit s) const noexcept {
+    return static_cast<uint32_t>(
+        (bits_ >> (static_cast<unsigned>(s) * kBitsPerSuit)) & kRankMask);
+  }
+
+  /// Relabel suits: every card of suit s moves to suit perm[s].
+  [[nodiscard]] constexpr CardSet
+  permuteSuits(const std::array<uint8_t, 4> &perm) const noexcept {
+    uint64_t out = 0;
+    for (unsigned s = 0; s < 4; ++s)
+      out |= ((bits_ >> (s * kBitsPerSuit)) & kRankMask)
+             << (perm[s] * kBitsPerSuit);
+    return CardSet(out);
+  }
+
+  // --- Mutators ---
+  constexpr void insert(Card c) noexcept { bits_ |= uint64_t{1} << bitIndex(c); }
+  constexpr void erase(Card c) noexcept {
+    bits_ &= ~(uint64_t{1} << bitIndex(c));
+  }
+  constexpr void clear() noexcept { bits_ = 0; }
+
+  // --- Set algebra ---
+  constexpr CardSet &operator|=(CardSet o) noexcept {
+    bits_ |= o.bits_;
+    return *this;
+  }
+  constexpr CardSet &operator&=(CardSet o) noexcept {
+    bits_ &= o.bits_;
+    return *this;
+  }
+  constexpr CardSet &operator-=(CardSet o) noexcept {
+    bits_ &= ~o.bits_;
+    return *this;
+  }
+  friend constexpr CardSet operator|(CardSet a, CardSet b) noexcept {
+    return a |= b;
+  }
+  friend constexpr CardSet operator&(CardSet a, CardSet b) noexcept {
+    return a &= b;
+  }
+  /// Set difference.
+  friend constexpr CardSet operator-(CardSet a, CardSet b) noexcept {
+    return a -= b;
+  }
+  /// Complement within the 52-card deck.
+  constexpr CardSet operator~() const noexcept {
+    return CardSet(~bits_ & kFullDeckBits);
+  }
+  constexpr bool operator==(const CardSet &) const noexcept = default;
+
+  // --- Iteration (lowest bit first) ---
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Card;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Card;
+
+    constexpr Iterator() noexcept = default;
+    constexpr explicit Iterator(uint64_t bits) noexcept : bits_(bits) {}
+
+    constexpr Card operator*() const noexcept {
+      return fromBitIndex(static_cast<unsigned>(std::countr_zero(bits_)));
+    }
+    constexpr Iterator &operator++() noexcept {
+      bits_ &= bits_ - 1;
+      return *this;
+    }
+    constexpr Iterator operator++(int) noexcept {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    constexpr bool operator==(const Iterator &) const noexcept = default;
+
+  private:
+    uint64_t bits_ = 0;
+  };
+
+  [[nodiscard]] constexpr Iterator begin() const noexcept {
+    return Iterator(bits_);
+  }
+  [[nodiscard]] constexpr Iterator end() const noexcept { return Iterator(); }
+
+  /// Space-separated card list, e.g. "2h Kh As".
+  [[nodiscard]] std::string toString() const;
+
+private:
+  uint64_t bits_ = 0;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const CardSet &s) {
+  return os << s.toString();
+}
+
+} // namespace poker::core
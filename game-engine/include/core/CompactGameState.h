@@ -0,0 +1,90 @@
+#pragma once
+
+#include "core/Action.h"
+#include "core/BettingRound.h"
+#include "core/CardSet.h"
+#include "core/GameState.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+
+
+namespace poker::core {
+
+/// @brief Fixed-capacity, trivially-copyable snapshot of a GameState.
+///
+/// Everything lives in inline arrays (up to 10 seats, a 5-card board and an
+/// action log as long as the one GameState reserves room for), so a copy
+/// is a plain memcpy of a few cache lines
+/// with no heap traffic, which is what search and replay want per node.
+/// Player names are not part of the snapshot; callers keep them once per
+/// table and pass them back to toGameState(). Chip amounts are stored as
+/// 32-bit values.
+struct alignas(64) CompactGameState {
+  static constexpr size_t kSeatCapacity = 10;
+  static constexpr size_t kActionCapacity = GameState::kReservedActions;
+  static constexpr uint8_t kNoCard = 0xFF;
+
+  /// Seat flags.
+  static constexpr uint8_t kFolded = 1;
+  static constexpr uint8_t kAllIn = 2;
+
+  struct Seat {
+    int32_t chips;
+    int32_t currentBet;  ///< This betting round.
+    int32_t contributed; ///< Into the pot this hand.
+    uint8_t hole[2];     ///< Dense card indices, kNoCard if not dealt.
+    uint8_t flags;
+    uint8_t reserved;
+  };
+
+  struct LoggedAction {
+    ActionType type;
+    uint8_t seat;
+    uint16_t reserved;
+    int32_t amount;
+  };
+
+  // Hot fields first: the header and seats fill the first cache lines.
+  int32_t smallBlind;
+  int32_t bigBlind;
+  Street street;
+  uint8_t numSeats;
+  uint8_t dealer;
+  uint8_t currentPlayer;
+  uint8_t numBoard;
+  uint8_t numActions;
+  uint8_t board[5]; ///< Dense card indices in deal order.
+  Seat seats[kSeatCapacity];
+  LoggedAction actions[kActionCapacity];
+
+  /// Snapshot a GameState. Seat i is getPlayers()[i]; player ids are not
+  /// kept. Throws std::length_error if seats or actions exceed capacity
+  /// and std::out_of_range for amounts that do not fit in 32 bits.
+  [[nodiscard]] static CompactGameState fromGameState(const GameState &state);
+
+  /// Rebuild a full GameState. Player i gets id i and names[i], or
+  /// "Seat i" if names has no entry for it.
+  [[nodiscard]] GameState
+  toGameState(std::span<const std::string> names = {}) const;
+
+  [[nodiscard]] int64_t getPotTotal() const noexcept;
+  [[nodiscard]] CardSet getBoardSet() const noexcept;
+  [[nodiscard]] CardSet getHoleCardSet(size_t seat) const noexcept;
+  [[nodiscard]] bool isFolded(size_t seat) const noexcept {
+    return (seats[seat].flags & kFolded) != 0;
+  }
+  [[nodiscard]] bool isAllIn(size_t seat) const noexcept {
+    return (seats[seat].flags & kAllIn) != 0;
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<CompactGameState>);
+static_assert(std::is_standard_layout_v<CompactGameState>);
+static_assert(sizeof(CompactGameState) <= 11 * 64,
+              "CompactGameState should stay within eleven cache lines");
+
+} // namespace poker::core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/Card.h"
+#include "core/CardSet.h"
 #include "interfaces/IRandomGenerator.h"
 
 #include <algorithm>
@@ -21,22 +22,41 @@ public:
   /// Shuffle using the provided RNG.
   void shuffle(interfaces::IRandomGenerator &rng);
 
+  /// Shuffle with any generator that has shuffle(std::vector<Card>&), called
+  /// directly rather than through IRandomGenerator.
+  template <typename Rng>
+    requires requires(Rng &rng, std::vector<Card> &cards) {
+      rng.shuffle(cards);
+    }
+  void shuffle(Rng &rng) {
+    dealIndex_ = 0;
+    remaining_ = CardSet(cards_);
+    rng.shuffle(cards_);
+  }
+
   /// Deal one card from the top. Returns nullopt if empty.
   [[nodiscard]] std::optional<Card> deal();
 
   /// Reset to a full 52-card deck (unshuffled).
   void reset();
 
+  /// Reset to a full deck minus the given dead cards (unshuffled).
+  void reset(CardSet dead);
+
   /// Number of remaining cards.
   [[nodiscard]] size_t remaining() const noexcept;
 
+  /// Cards not yet dealt.
+  [[nodiscard]] CardSet remainingCards() const noexcept { return remaining_; }
+
 private:
   std::vector<Card> cards_;
   size_t dealIndex_ = 0;
+  CardSet remaining_;
 };
 
 /// @brief Default RNG implementation using std::mt19937.
-class Mt19937Generator : public interfaces::IRandomGenerator {
+class Mt19937Generator final : public interfaces::IRandomGenerator {
 public:
   explicit Mt19937Generator(uint64_t seed);
   Mt19937Generator(); ///< Seeds from std::random_device.
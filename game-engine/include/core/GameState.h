@@ -3,6 +3,7 @@
 #include "core/Action.h"
 #include "core/BettingRound.h"
 #include "core/Card.h"
+#include "core/CardSet.h"
 #include "core/Player.h"
 #include "core/Pot.h"
 
@@ -22,6 +23,9 @@ namespace poker::core {
 /// It is designed to be serializable for hand history replay.
 class GameState {
 public:
+  /// Action history capacity reserved at the start of every hand.
+  static constexpr size_t kReservedActions = 64;
+
   GameState() = default;
 
   // --- Setup ---
@@ -34,6 +38,10 @@ public:
   void setStreet(Street s) noexcept { street_ = s; }
   void addCommunityCard(Card c);
   void recordAction(Action a);
+  /// Undo the most recent addCommunityCard() / recordAction(), e.g. when
+  /// backing out of a search branch.
+  void removeLastCommunityCard();
+  void removeLastAction();
   void setCurrentPlayerIndex(size_t idx) noexcept { currentPlayerIdx_ = idx; }
 
   // --- Queries ---
@@ -51,6 +59,11 @@ public:
   [[nodiscard]] const std::vector<Card> &getCommunityCards() const noexcept {
     return communityCards_;
   }
+  [[nodiscard]] CardSet getCommunityCardSet() const noexcept {
+    return communitySet_;
+  }
+  /// Board plus every player's hole cards.
+  [[nodiscard]] CardSet getDealtCardSet() const noexcept;
   [[nodiscard]] Street getStreet() const noexcept { return street_; }
   [[nodiscard]] size_t getDealerPosition() const noexcept { return dealerPos_; }
   [[nodiscard]] size_t getCurrentPlayerIndex() const noexcept {
@@ -80,6 +93,7 @@ public:
 private:
   std::vector<Player> players_;
   std::vector<Card> communityCards_;
+  CardSet communitySet_;
   Pot pot_;
   Street street_ = Street::Preflop;
 
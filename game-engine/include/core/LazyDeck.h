@@ -0,0 +1,66 @@
+#pragma once
+
+#include "core/Card.h"
+#include "core/CardSet.h"
+#include "core/Random.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <utility>
+
+
+namespace poker::core {
+
+/// @brief Deck that shuffles only as far as it deals.
+///
+/// Each draw is one step of a Fisher-Yates shuffle: a uniformly chosen
+/// undealt card is swapped to the front and returned. A hand that uses 20
+/// cards costs 20 random draws rather than a 52-card shuffle, and
+/// restore() undoes the swaps to put the deck back in its starting order
+/// in O(cards dealt). Since every hand starts from the same order, the
+/// cards drawn depend only on the generator's output.
+class LazyDeck {
+public:
+  /// Full 52-card deck.
+  LazyDeck() { reset(); }
+
+  /// Rebuild with every card except `dead`, in canonical order. O(52).
+  void reset(CardSet dead = CardSet());
+
+  /// Draw a uniformly random undealt card; nullopt if the deck is empty.
+  template <std::uniform_random_bit_generator G>
+  [[nodiscard]] std::optional<Card> draw(G &gen) {
+    if (dealt_ == size_)
+      return std::nullopt;
+    const auto pick = static_cast<uint8_t>(
+        dealt_ + uniformBelow(gen, static_cast<uint32_t>(size_ - dealt_)));
+    std::swap(cards_[dealt_], cards_[pick]);
+    swaps_[dealt_] = pick;
+    return cards_[dealt_++];
+  }
+
+  /// Return every dealt card, restoring the order reset() left. O(dealt).
+  void restore() noexcept {
+    while (dealt_ > 0) {
+      --dealt_;
+      std::swap(cards_[dealt_], cards_[swaps_[dealt_]]);
+    }
+  }
+
+  [[nodiscard]] size_t remaining() const noexcept { return size_ - dealt_; }
+  [[nodiscard]] size_t dealt() const noexcept { return dealt_; }
+
+  /// Cards not yet dealt.
+  [[nodiscard]] CardSet remainingCards() const noexcept;
+
+private:
+  std::array<Card, 52> cards_;
+  std::array<uint8_t, 52> swaps_; ///< Position swapped with at each draw.
+  uint8_t size_ = 0;
+  uint8_t dealt_ = 0;
+};
+
+} // namespace poker::core
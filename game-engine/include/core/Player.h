@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/Card.h"
+#include "core/CardSet.h"
 
 #include <cstdint>
 #include <optional>
@@ -30,6 +31,7 @@ public:
   [[nodiscard]] const std::vector<Card> &getHoleCards() const noexcept {
     return holeCards_;
   }
+  [[nodiscard]] CardSet getHoleCardSet() const noexcept { return holeSet_; }
 
   // --- Mutators ---
   void dealCard(Card c);
@@ -48,11 +50,22 @@ public:
   /// Reset per-round bet tracking.
   void resetCurrentBet() noexcept { currentBet_ = 0; }
 
+  /// Overwrite the betting state wholesale, e.g. when restoring a
+  /// snapshot. No consistency checks are made.
+  void restoreBettingState(int64_t chips, int64_t currentBet, bool folded,
+                           bool allIn) noexcept {
+    chips_ = chips;
+    currentBet_ = currentBet;
+    folded_ = folded;
+    allIn_ = allIn;
+  }
+
 private:
   size_t id_;
   std::string name_;
   int64_t chips_;
   std::vector<Card> holeCards_;
+  CardSet holeSet_;
   bool folded_ = false;
   bool allIn_ = false;
   int64_t currentBet_ = 0;
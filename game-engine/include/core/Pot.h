@@ -1,5 +1,8 @@
 #pragma once
 
+#include "core/SeatMask.h"
+
+#include <cstddef>
 #include <cstdint>
 #include <unordered_set>
 #include <vector>
@@ -13,6 +16,12 @@ struct PotInfo {
   std::unordered_set<size_t> eligiblePlayers; ///< Player IDs eligible to win.
 };
 
+/// @brief Compact pot (main or side) with eligible players as a seat mask.
+struct SidePot {
+  int64_t amount = 0;
+  SeatMask eligible = 0;
+};
+
 /// @brief Manages the pot system including side pot calculation.
 ///
 /// Each player's total contribution is tracked. When side pots are needed
@@ -25,6 +34,10 @@ public:
   /// Record a contribution from a player.
   void addContribution(size_t playerId, int64_t amount);
 
+  /// Take back part of a player's contribution (e.g. undoing a bet). The
+  /// player's entry is dropped once it reaches zero.
+  void removeContribution(size_t playerId, int64_t amount);
+
   /// Get total chips in all pots.
   [[nodiscard]] int64_t getTotal() const noexcept;
 
@@ -36,6 +49,11 @@ public:
   [[nodiscard]] std::vector<PotInfo>
   calculateSidePots(const std::unordered_set<size_t> &foldedPlayers) const;
 
+  /// Same calculation into a caller-owned buffer; allocation-free once
+  /// `out` has grown to the number of pots. Player IDs must be below
+  /// kMaxSeats.
+  void calculateSidePots(SeatMask folded, std::vector<SidePot> &out) const;
+
   /// Reset for a new hand.
   void reset();
 
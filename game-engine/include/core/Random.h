@@ -0,0 +1,204 @@
+#pragma once
+
+#include "core/Card.h"
+#include "interfaces/IRandomGenerator.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace poker::core {
+
+/// SplitMix64 finaliser: a fast, well-mixed 64-bit hash, used to expand a
+/// seed into generator state.
+[[nodiscard]] constexpr uint64_t splitMix64(uint64_t x) noexcept {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+/// Uniform integer in [0, bound) from any 64-bit bit generator, without
+/// modulo bias (Lemire's multiply-and-reject; the rejection branch is
+/// almost never taken). bound must be positive.
+template <std::uniform_random_bit_generator G>
+[[nodiscard]] uint32_t uniformBelow(G &gen, uint32_t bound) {
+  static_assert(G::max() - G::min() == std::numeric_limits<uint64_t>::max(),
+                "uniformBelow needs a full 64-bit generator");
+  uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(gen() >> 32)) *
+               bound;
+  auto low = static_cast<uint32_t>(m);
+  if (low < bound) {
+    const uint32_t threshold = (0u - bound) % bound;
+    while (low < threshold) {
+      m = static_cast<uint64_t>(static_cast<uint32_t>(gen() >> 32)) * bound;
+      low = static_cast<uint32_t>(m);
+    }
+  }
+  return static_cast<uint32_t>(m >> 32);
+}
+
+/// Forward Fisher-Yates: position i receives a uniformly chosen card from
+/// positions [i, n). LazyDeck draws in exactly this order, so a shuffled
+/// Deck and a LazyDeck deal the same cards from the same generator state.
+template <std::uniform_random_bit_generator G>
+void fisherYates(G &gen, std::vector<Card> &cards) {
+  const size_t n = cards.size();
+  for (size_t i = 0; i + 1 < n; ++i) {
+    std::swap(cards[i],
+              cards[i + uniformBelow(gen, static_cast<uint32_t>(n - i))]);
+  }
+}
+
+/// @brief xoshiro256** (Blackman & Vigna): a small, fast, statistically
+/// strong non-cryptographic generator.
+///
+/// 32 bytes of state against mt19937_64's 2.5 KB, and a handful of
+/// instructions per draw. It is both an IRandomGenerator (for Deck and the
+/// type-erased engine) and a std::uniform_random_bit_generator, which lets
+/// a BasicPokerEngine holding it by value draw cards lazily from a
+/// LazyDeck instead of shuffling all 52.
+class Xoshiro256Generator final : public interfaces::IRandomGenerator {
+public:
+  using result_type = uint64_t;
+
+  /// State is expanded from the seed with SplitMix64, as the authors
+  /// recommend, so nearby seeds give unrelated streams.
+  explicit Xoshiro256Generator(uint64_t seed) noexcept { this->seed(seed); }
+  Xoshiro256Generator(); ///< Seeds from std::random_device.
+
+  void seed(uint64_t seed) noexcept {
+    for (auto &word : s_) {
+      word = splitMix64(seed);
+      seed += 0x9E3779B97F4A7C15ull;
+    }
+  }
+
+  static constexpr result_type min() noexcept { return 0; }
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() noexcept {
+    const uint64_t result = std::rotl(s_[1] * 5, 7) * 9;
+    const uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = std::rotl(s_[3], 45);
+    return result;
+  }
+
+  /// Uniform integer in [0, bound).
+  [[nodiscard]] uint32_t below(uint32_t bound) {
+    return uniformBelow(*this, bound);
+  }
+
+  void shuffle(std::vector<Card> &cards) override { fisherYates(*this, cards); }
+
+private:
+  uint64_t s_[4];
+};
+
+/// @brief Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy
+/// as 1, 2, 3"): a counter-based generator with one stream per hand.
+///
+/// Output is a keyed bijection of a 128-bit counter, here (block, hand,
+/// table) under the key `seed`. The cards of hand k at table t are thus a
+/// pure function of (seed, t, k): any hand can be regenerated in O(1) by
+/// constructing PhiloxGenerator(seed, t, k), with no need to replay the
+/// hands before it, and results cannot depend on which thread played what.
+///
+/// The engine calls beginHand() before each hand, which moves to the next
+/// hand's stream; a generator built for hand k therefore deals hand k
+/// first, then k + 1, and so on. Like Xoshiro256Generator it is both an
+/// IRandomGenerator and a bit generator, and a full shuffle deals the same
+/// cards as a LazyDeck drawing from it.
+class PhiloxGenerator final : public interfaces::IRandomGenerator {
+public:
+  using result_type = uint64_t;
+  using Counter = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  /// The Philox4x32-10 bijection on one counter block.
+  [[nodiscard]] static constexpr Counter block(Counter ctr, Key key) noexcept {
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        key[0] += 0x9E3779B9u;
+        key[1] += 0xBB67AE85u;
+      }
+      const uint64_t p0 = uint64_t{0xD2511F53u} * ctr[0];
+      const uint64_t p1 = uint64_t{0xCD9E8D57u} * ctr[2];
+      ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+             static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+             static_cast<uint32_t>(p0)};
+    }
+    return ctr;
+  }
+
+  /// Positioned at the start of hand `hand` of table `table`.
+  explicit PhiloxGenerator(uint64_t seed, uint32_t table = 0,
+                           uint64_t hand = 0) noexcept
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+        table_(table), hand_(hand), nextHand_(hand) {}
+
+  /// Move to the start of the next hand's stream (the constructor's hand
+  /// on the first call).
+  void beginHand() noexcept override {
+    hand_ = nextHand_++;
+    block_ = 0;
+    used_ = 2;
+  }
+
+  /// Make `hand` the one the next beginHand() starts.
+  void seek(uint64_t hand) noexcept { nextHand_ = hand; }
+
+  /// Hand whose stream is being drawn from.
+  [[nodiscard]] uint64_t getHand() const noexcept { return hand_; }
+  [[nodiscard]] uint32_t getTable() const noexcept { return table_; }
+
+  static constexpr result_type min() noexcept { return 0; }
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() noexcept {
+    if (used_ == 2) {
+      buffer_ = block({block_++, static_cast<uint32_t>(hand_),
+                       static_cast<uint32_t>(hand_ >> 32), table_},
+                      key_);
+      used_ = 0;
+    }
+    const uint64_t lo = buffer_[2 * used_];
+    const uint64_t hi = buffer_[2 * used_ + 1];
+    ++used_;
+    return (hi << 32) | lo;
+  }
+
+  /// Uniform integer in [0, bound).
+  [[nodiscard]] uint32_t below(uint32_t bound) {
+    return uniformBelow(*this, bound);
+  }
+
+  void shuffle(std::vector<Card> &cards) override { fisherYates(*this, cards); }
+
+private:
+  Key key_;
+  uint32_t table_;
+  uint64_t hand_;
+  uint64_t nextHand_;
+  uint32_t block_ = 0;
+  uint32_t used_ = 2; ///< 64-bit halves of buffer_ consumed.
+  Counter buffer_{};
+};
+
+} // namespace poker::core
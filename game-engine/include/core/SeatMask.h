@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace poker::core {
+
+/// Set of seats, one bit per seat index.
+using SeatMask = uint64_t;
+
+/// Largest table a SeatMask can describe.
+inline constexpr size_t kMaxSeats = 64;
+
+[[nodiscard]] constexpr SeatMask seatBit(size_t seat) noexcept {
+  return SeatMask{1} << seat;
+}
+
+} // namespace poker::core
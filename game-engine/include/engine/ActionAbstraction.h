@@ -0,0 +1,96 @@
+#pragma once
+
+#include "core/Action.h"
+#include "core/BettingRound.h"
+#include "core/GameState.h"
+#include "engine/GameTreeCursor.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace poker::engine {
+
+/// @brief Discrete bet sizes for solvers and bots, as fractions of the pot.
+///
+/// The rules only offer the minimum bet or raise and all-in. An
+/// ActionAbstraction replaces that with a configured set of sizes per
+/// street and per number of raises already made on the street, e.g. 33%,
+/// 75% and 150% pot for the first bet on the flop but only pot-sized
+/// re-raises. A fraction f means putting in a call plus f times the pot
+/// after calling, so 1.0 is a pot-sized bet or raise. Sizes below the
+/// minimum raise are raised to it, sizes at or above the stack become the
+/// all-in, and duplicates collapse, so every expanded action is legal.
+///
+/// translate() maps a bet of any size back onto the two abstract bets
+/// around it with the pseudo-harmonic mapping (Ganzfried and Sandholm),
+/// which is the standard way to answer an opponent's off-tree bet.
+class ActionAbstraction {
+public:
+  static constexpr size_t kNumStreets = 4; ///< Preflop to river.
+
+  /// Where an observed action lands among the abstract ones: indices into
+  /// the list expand() produced, and the probability of the lower one.
+  /// Actions that are not bets map to themselves with lowerWeight 1.
+  struct Translation {
+    size_t lower = 0;
+    size_t upper = 0;
+    double lowerWeight = 1.0;
+  };
+
+  /// An abstraction that offers no bet sizes; only fold, check, call and
+  /// all-in survive expand() until setSizes() adds some.
+  ActionAbstraction() = default;
+
+  /// Offer `potFractions` on `street` once `raiseCount` bets or raises
+  /// have been made there (0: the first bet, or preflop the first raise
+  /// over the blinds). The sizes for the highest configured raise count
+  /// apply to all higher ones; lower counts left unset offer none. An
+  /// empty list removes the sizes. Throws std::invalid_argument for a street
+  /// past the river or a fraction that is not positive and finite.
+  void setSizes(core::Street street, size_t raiseCount,
+                std::vector<double> potFractions);
+
+  /// The fractions expand() uses at this point, ascending.
+  [[nodiscard]] std::span<const double> getSizes(core::Street street,
+                                                 size_t raiseCount) const;
+
+  /// Most sizes configured at any one point.
+  [[nodiscard]] size_t getMaxSizes() const noexcept;
+
+  /// The abstract actions for the player `legal` belongs to: its fold,
+  /// check and call as they are, then the configured sizes ascending, then
+  /// all-in. `legal` is RuleEngine's list for the state, which bounds the
+  /// sizes. Written into `out` (cleared first), so a reused vector keeps
+  /// this free of allocation.
+  void expand(const core::GameState &state,
+              std::span<const core::Action> legal, size_t raiseCount,
+              std::vector<core::Action> &out) const;
+
+  /// Same at the cursor's decision node, using its betting round.
+  void expand(GameTreeCursor &cursor, std::vector<core::Action> &out) const;
+
+  /// Map `action`, played from `state`, onto `abstract` (expand()'s output
+  /// for the same state). A bet between two abstract bets is split
+  /// between them with pseudoHarmonic(); one outside the range goes to the
+  /// nearest. Throws std::invalid_argument if `abstract` has no action of
+  /// the same kind.
+  [[nodiscard]] static Translation
+  translate(const core::GameState &state,
+            std::span<const core::Action> abstract,
+            const core::Action &action);
+
+  /// Probability of mapping a bet of pot fraction x to the smaller size a
+  /// rather than b, for a <= x <= b: (b - x)(1 + a) / ((b - a)(1 + x)).
+  [[nodiscard]] static double pseudoHarmonic(double a, double b,
+                                             double x) noexcept;
+
+private:
+  /// sizes_[street][raiseCount], each ascending and without duplicates.
+  std::array<std::vector<std::vector<double>>, kNumStreets> sizes_;
+};
+
+} // namespace poker::engine
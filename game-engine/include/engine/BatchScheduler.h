@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/GameState.h"
+#include "engine/PokerEngine.h"
+#include "interfaces/IBatchActionProvider.h"
+#include "interfaces/IRandomGenerator.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+namespace poker::engine {
+
+struct BatchSchedulerConfig {
+  /// Decisions per provider call once enough tables are parked.
+  size_t maxBatch = 256;
+  /// Longest a parked table waits for its batch to fill before the partial
+  /// batch is sent anyway.
+  std::chrono::microseconds maxWait{1000};
+};
+
+struct BatchStats {
+  uint64_t hands = 0;
+  uint64_t decisions = 0;
+  uint64_t batches = 0;
+  uint64_t deadlineFlushes = 0; ///< Partial batches sent on maxWait.
+  size_t largestBatch = 0;
+};
+
+/// @brief Plays many tables on one thread against an IBatchActionProvider.
+///
+/// Each table has its own step-wise HeadlessPokerEngine. The scheduler
+/// advances tables round-robin; a table that reaches a decision is parked
+/// until maxBatch decisions are waiting, the oldest has waited maxWait, or
+/// no table can make progress without an answer. The parked decisions then
+/// go to the provider in a single call and their tables resume.
+///
+/// Buffers are reused between batches, so steady-state scheduling does not
+/// allocate.
+class BatchScheduler {
+public:
+  /// Called when a table finishes a hand. Adjust the state as needed
+  /// (rotate the dealer, top up stacks) and return true to deal another
+  /// hand on it, or false to retire the table.
+  using HandCompleteFn = std::function<bool(size_t table, core::GameState &)>;
+
+  /// Throws std::invalid_argument for a null provider or maxBatch of 0.
+  explicit BatchScheduler(
+      std::shared_ptr<interfaces::IBatchActionProvider> provider,
+      BatchSchedulerConfig config = {});
+
+  /// Register a table; its first hand is dealt by run(). `state` must
+  /// outlive the scheduler. Returns the table index.
+  size_t addTable(std::shared_ptr<interfaces::IRandomGenerator> rng,
+                  core::GameState &state);
+
+  [[nodiscard]] size_t numTables() const noexcept { return tables_.size(); }
+
+  /// Play until every table is retired. Exceptions from the provider, the
+  /// callback or an illegal action propagate, leaving hands unfinished.
+  void run(const HandCompleteFn &onHandComplete);
+
+  /// Totals across all run() calls.
+  [[nodiscard]] const BatchStats &getStats() const noexcept { return stats_; }
+
+private:
+  struct Table {
+    HeadlessPokerEngine engine;
+    core::GameState *state;
+  };
+
+  /// Advance one table until it parks at a decision or retires.
+  void step(size_t table, const HandCompleteFn &onHandComplete);
+  /// Send every parked decision to the provider and resume those tables.
+  void flush();
+
+  std::shared_ptr<interfaces::IBatchActionProvider> provider_;
+  BatchSchedulerConfig config_;
+  std::vector<std::unique_ptr<Table>> tables_;
+  BatchStats stats_;
+
+  std::vector<size_t> runnable_;
+  std::vector<size_t> stepping_;
+  std::vector<interfaces::BatchDecision> parked_;
+  std::vector<core::Action> actions_;
+  std::chrono::steady_clock::time_point oldestParked_;
+};
+
+} // namespace poker::engine
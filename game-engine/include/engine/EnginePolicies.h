@@ -0,0 +1,108 @@
+#pragma once
+
+#include "core/Action.h"
+#include "core/ActionList.h"
+#include "core/Card.h"
+#include "core/GameState.h"
+#include "interfaces/IActionProvider.h"
+#include "interfaces/IRandomGenerator.h"
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace poker::engine {
+
+/// A policy that reads the legal actions straight from the engine's
+/// core::ActionList (or a std::span<const core::Action> over it) through
+/// chooseAction(), as IActionProvider does.
+template <typename P>
+concept ActionListPolicy = requires(P &policy, size_t playerId,
+                                    const core::GameState &state,
+                                    const core::ActionList &legal) {
+  {
+    policy.chooseAction(playerId, state, legal)
+  } -> std::convertible_to<core::Action>;
+};
+
+/// Anything that chooses actions like IActionProvider. The engine holds it
+/// by value and calls it directly, so a concrete (ideally final) type lets
+/// the compiler inline every decision. Policies with only getAction()
+/// taking a std::vector<core::Action> still work; the engine copies the
+/// legal actions into a reused vector for them.
+template <typename P>
+concept ActionPolicy =
+    ActionListPolicy<P> ||
+    requires(P &policy, size_t playerId, const core::GameState &state,
+             const std::vector<core::Action> &legal) {
+      {
+        policy.getAction(playerId, state, legal)
+      } -> std::convertible_to<core::Action>;
+    };
+
+/// A deck randomiser, held by value: either a uniform random bit generator,
+/// from which the engine draws cards lazily (LazyDeck), or anything that
+/// shuffles a whole deck like IRandomGenerator.
+template <typename R>
+concept DeckRng = std::uniform_random_bit_generator<R> ||
+                  requires(R &rng, std::vector<core::Card> &cards) {
+                    rng.shuffle(cards);
+                  };
+
+/// Type-erased policy forwarding to a shared IActionProvider; what
+/// PokerEngine uses. An empty one (no provider) is only good for the
+/// step-wise API.
+class SharedActionProvider {
+public:
+  SharedActionProvider() = default;
+
+  /// Throws std::invalid_argument for a null provider.
+  template <std::derived_from<interfaces::IActionProvider> P>
+  SharedActionProvider(std::shared_ptr<P> provider)
+      : provider_(std::move(provider)) {
+    if (!provider_)
+      throw std::invalid_argument("actionProvider cannot be null");
+  }
+
+  core::Action getAction(size_t playerId, const core::GameState &state,
+                         const std::vector<core::Action> &legal) {
+    return provider_->getAction(playerId, state, legal);
+  }
+  core::Action chooseAction(size_t playerId, const core::GameState &state,
+                            const core::ActionList &legal) {
+    return provider_->chooseAction(playerId, state, legal);
+  }
+
+  explicit operator bool() const noexcept { return provider_ != nullptr; }
+
+private:
+  std::shared_ptr<interfaces::IActionProvider> provider_;
+};
+
+/// Type-erased RNG forwarding to a shared IRandomGenerator; what
+/// PokerEngine uses.
+class SharedRandomGenerator {
+public:
+  /// Throws std::invalid_argument for a null generator.
+  template <std::derived_from<interfaces::IRandomGenerator> R>
+  SharedRandomGenerator(std::shared_ptr<R> rng) : rng_(std::move(rng)) {
+    if (!rng_)
+      throw std::invalid_argument("rng cannot be null");
+  }
+
+  void shuffle(std::vector<core::Card> &cards) { rng_->shuffle(cards); }
+  void beginHand() { rng_->beginHand(); }
+
+private:
+  std::shared_ptr<interfaces::IRandomGenerator> rng_;
+};
+
+static_assert(ActionListPolicy<SharedActionProvider>);
+static_assert(DeckRng<SharedRandomGenerator>);
+
+} // namespace poker::engine
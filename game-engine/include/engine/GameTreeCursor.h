@@ -0,0 +1,123 @@
+#pragma once
+
+#include "core/Action.h"
+#include "core/ActionList.h"
+#include "core/BettingRound.h"
+#include "core/Card.h"
+#include "core/GameState.h"
+#include "core/Pot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace poker::engine {
+
+/// @brief Walks a hand's game tree in place, with apply/undo.
+///
+/// The cursor mutates the GameState it is given (players, pot, history,
+/// street and board) and records just enough in a compact undo log to
+/// reverse each step, so depth-first search never copies the state. The
+/// rules are RuleEngine's, queried against the cursor's BettingRound so
+/// each check is O(1), with the same betting-round flow as PokerEngine.
+///
+/// Nodes are of three kinds:
+///   - Decision: getCurrentPlayer() must apply() one of getLegalActions().
+///   - Chance:   a betting round closed; dealBoard() the next street's
+///               cardsNeeded() cards.
+///   - Terminal: everyone else folded or the river is done; getPayoffs()
+///               gives each seat's net result.
+///
+/// After warm-up (undo log and scratch buffers at their peak depth) apply,
+/// dealBoard and undo do not allocate.
+class GameTreeCursor {
+public:
+  enum class NodeType : uint8_t { Decision, Chance, Terminal };
+
+  /// @param state  A hand at the start of a betting round, e.g. hole cards
+  ///               dealt and blinds posted. Must outlive the cursor, and
+  ///               must only be changed through it while in use.
+  explicit GameTreeCursor(core::GameState &state);
+
+  /// An unbound cursor; call reset() before anything else.
+  GameTreeCursor() = default;
+
+  /// Re-root on a new hand (same requirements as the constructor). Buffers
+  /// are kept, so re-rooting a warmed-up cursor does not allocate.
+  void reset(core::GameState &state);
+
+  [[nodiscard]] NodeType getNodeType() const noexcept { return node_; }
+  [[nodiscard]] bool isTerminal() const noexcept {
+    return node_ == NodeType::Terminal;
+  }
+  [[nodiscard]] size_t getCurrentPlayer() const noexcept {
+    return round_.getCurrentPlayerIndex();
+  }
+  [[nodiscard]] const core::GameState &getState() const noexcept {
+    return *state_;
+  }
+  /// The street's betting round, for RuleEngine's O(1) queries.
+  [[nodiscard]] const core::BettingRound &getRound() const noexcept {
+    return round_;
+  }
+  /// Number of steps that undo() can take back.
+  [[nodiscard]] size_t getDepth() const noexcept { return log_.size(); }
+
+  /// Legal actions at a decision node (empty elsewhere). The reference is
+  /// valid until the cursor moves.
+  [[nodiscard]] const core::ActionList &getLegalActions();
+
+  /// Play an action for the current player. Throws std::logic_error away
+  /// from a decision node and std::invalid_argument if it is not legal.
+  void apply(const core::Action &action);
+
+  /// Board cards the chance node wants (3 for the flop, else 1; 0 when not
+  /// at a chance node).
+  [[nodiscard]] size_t cardsNeeded() const noexcept;
+
+  /// Deal the next street. Throws std::logic_error away from a chance node
+  /// and std::invalid_argument for a wrong count or an already dealt card.
+  void dealBoard(std::span<const core::Card> cards);
+
+  /// Take back the last apply() or dealBoard().
+  /// Throws std::logic_error at the root.
+  void undo();
+
+  /// Net chips won or lost this hand per seat at a terminal node (pots
+  /// awarded minus chips contributed). Throws std::logic_error elsewhere
+  /// and std::invalid_argument if out is smaller than the table.
+  void getPayoffs(std::span<int64_t> out);
+
+private:
+  /// What one step changed, enough to reverse it.
+  struct UndoEntry {
+    core::BettingRound round; ///< Round before the step.
+    int64_t chips = 0;        ///< Chips the action moved into the pot.
+    core::Street street = core::Street::Preflop;
+    NodeType node = NodeType::Decision;
+    bool isAction = false;
+    bool wasFolded = false;
+    bool wasAllIn = false;
+    bool betsSaved = false; ///< Current bets pushed to savedBets_.
+    uint8_t seat = 0;
+    uint8_t cards = 0;         ///< Board cards dealt.
+    uint8_t currentPlayer = 0; ///< GameState's current player before.
+  };
+
+  /// Called whenever betting may have finished: moves on to a chance or
+  /// terminal node as appropriate.
+  void settleNode(UndoEntry &entry);
+
+  core::GameState *state_ = nullptr;
+  core::BettingRound round_{2, 0, 0};
+  NodeType node_ = NodeType::Decision;
+
+  std::vector<UndoEntry> log_;
+  std::vector<int64_t> savedBets_;
+  core::ActionList legalActions_;
+  std::vector<core::SidePot> sidePots_;
+};
+
+} // namespace poker::engine
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "core/Action.h"
+#include "core/GameState.h"
+#include "engine/PokerEngine.h"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+
+namespace poker::engine {
+
+/// @brief One hand as a C++20 coroutine over the step-wise engine API.
+///
+/// The coroutine runs eagerly up to the first decision (or to the end of
+/// the hand), then suspends each time a player must act:
+///
+///   auto hand = playHandCoroutine(engine, state);
+///   while (!hand.done())
+///     hand.submit(chooseAction(*hand.decision()));
+///
+/// It is a thin convenience for callers that prefer a generator-style loop;
+/// schedulers that juggle many tables can equally drive the engine's
+/// startHand / advance / submit directly.
+class HandCoroutine {
+public:
+  struct promise_type {
+    std::optional<PendingDecision> decision;
+    std::optional<core::Action> reply;
+    std::exception_ptr error;
+
+    HandCoroutine get_return_object() {
+      return HandCoroutine(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() noexcept { decision.reset(); }
+    void unhandled_exception() noexcept {
+      decision.reset();
+      error = std::current_exception();
+    }
+
+    /// `co_yield decision` suspends until submit() and evaluates to the
+    /// submitted action.
+    auto yield_value(PendingDecision d) noexcept {
+      decision = d;
+      reply.reset();
+      struct Awaiter {
+        promise_type &promise;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>) const noexcept {}
+        core::Action await_resume() const { return *promise.reply; }
+      };
+      return Awaiter{*this};
+    }
+  };
+
+  HandCoroutine(HandCoroutine &&other) noexcept
+      : handle_(std::exchange(other.handle_, {})) {}
+  HandCoroutine &operator=(HandCoroutine &&other) noexcept {
+    if (this != &other) {
+      if (handle_)
+        handle_.destroy();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+  HandCoroutine(const HandCoroutine &) = delete;
+  HandCoroutine &operator=(const HandCoroutine &) = delete;
+  ~HandCoroutine() {
+    if (handle_)
+      handle_.destroy();
+  }
+
+  /// True once the hand is over. Rethrows (once) anything the hand threw
+  /// that submit() has not already reported.
+  [[nodiscard]] bool done() {
+    if (handle_.promise().error)
+      std::rethrow_exception(std::exchange(handle_.promise().error, {}));
+    return handle_.done();
+  }
+
+  /// The decision the hand is suspended at (empty once done).
+  [[nodiscard]] const std::optional<PendingDecision> &decision() const {
+    return handle_.promise().decision;
+  }
+
+  /// Answer the pending decision and run to the next one. Throws
+  /// std::logic_error if the hand is over. An illegal action throws
+  /// std::invalid_argument and abandons the hand.
+  void submit(core::Action action) {
+    if (handle_.done()) {
+      throw std::logic_error("HandCoroutine::submit: hand is over");
+    }
+    handle_.promise().reply = action;
+    handle_.resume();
+    if (handle_.promise().error)
+      std::rethrow_exception(std::exchange(handle_.promise().error, {}));
+  }
+
+private:
+  explicit HandCoroutine(std::coroutine_handle<promise_type> handle)
+      : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/// Play one hand of `engine` on `state` as a coroutine. Both must outlive
+/// the returned HandCoroutine.
+template <typename Engine>
+HandCoroutine playHandCoroutine(Engine &engine, core::GameState &state) {
+  engine.startHand(state);
+  while (engine.advance() == StepStatus::AwaitingAction) {
+    const core::Action action = co_yield *engine.pendingDecision();
+    engine.submit(action);
+  }
+}
+
+} // namespace poker::engine
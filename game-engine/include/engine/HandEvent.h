@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/Action.h"
+#include "core/BettingRound.h"
+#include "core/CardSet.h"
+#include "core/GameState.h"
+#include "core/SeatMask.h"
+#include "utils/HandEvaluator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <variant>
+
+
+namespace poker::engine {
+
+/// A new hand has been set up and the deck shuffled.
+struct HandStarted {
+  size_t dealer;
+};
+
+/// A forced blind was posted.
+struct BlindPosted {
+  size_t playerId;
+  int64_t amount; ///< Chips actually posted (less than the blind if short).
+  bool bigBlind;
+};
+
+/// Every player has been dealt two hole cards (see GameState for them).
+struct HoleCardsDealt {};
+
+/// A betting street begins; board cards for it are already dealt.
+struct StreetStarted {
+  core::Street street;
+  core::CardSet board;
+  int64_t pot;
+};
+
+/// A player acted. The action is as recorded in the history.
+struct ActionTaken {
+  core::Action action;
+  int64_t pot; ///< Pot total after the action.
+};
+
+/// The board is complete and the remaining hands are shown down.
+struct ShowdownStarted {
+  core::CardSet board;
+  core::SeatMask players; ///< Seats still in the hand.
+};
+
+/// A pot (main or side) was paid out. Split pots list every winner; the
+/// odd chips go to the lowest seats.
+struct PotAwarded {
+  int64_t amount;
+  core::SeatMask winners;
+  utils::HandStrength strength; ///< Winning hand; 0 when uncontested.
+  bool uncontested;             ///< Everyone else folded.
+};
+
+/// The hand is over: every pot has been paid and the stacks in GameState
+/// are final. Always the last event of a hand.
+struct HandEnded {};
+
+/// @brief Everything the engine reports while playing a hand.
+///
+/// Payloads are small trivially-copyable structs, so building an event
+/// never allocates. Consumers typically std::visit with Overloaded.
+using HandEvent =
+    std::variant<HandStarted, BlindPosted, HoleCardsDealt, StreetStarted,
+                 ActionTaken, ShowdownStarted, PotAwarded, HandEnded>;
+
+/// Helper for visiting a HandEvent with a set of lambdas.
+template <typename... Fs> struct Overloaded : Fs... {
+  using Fs::operator()...;
+};
+template <typename... Fs> Overloaded(Fs...) -> Overloaded<Fs...>;
+
+/// @brief Observer that ignores everything.
+///
+/// An engine instantiated with it compiles event construction out
+/// entirely, which is what headless simulation wants.
+struct NullObserver {
+  void operator()(const HandEvent &, const core::GameState &) const noexcept {}
+};
+
+/// Callback type for hand events.
+using HandEventCallback =
+    std::function<void(const HandEvent &event, const core::GameState &state)>;
+
+/// @brief Observer that forwards events to a callback set at run time.
+struct CallbackObserver {
+  HandEventCallback callback;
+
+  void operator()(const HandEvent &event, const core::GameState &state) const {
+    if (callback)
+      callback(event, state);
+  }
+};
+
+/// Anything callable with (const HandEvent&, const GameState&).
+template <typename T>
+concept HandObserver = std::is_invocable_v<T &, const HandEvent &,
+                                           const core::GameState &>;
+
+/// False for observers whose events can be skipped without being built.
+template <typename T>
+inline constexpr bool kObservesEvents = !std::is_same_v<T, NullObserver>;
+
+} // namespace poker::engine
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "core/Action.h"
+#include "core/Card.h"
+#include "core/CardSet.h"
+#include "core/GameState.h"
+#include "engine/HandEvent.h"
+#include "utils/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace poker::engine {
+
+/// @brief One decoded hand from a hand-history file.
+///
+/// Holds everything needed to replay the hand: the table as it was dealt,
+/// the full action log (blinds included, as the engine records them) and
+/// the stacks after settlement.
+struct HandRecord {
+  uint64_t handId = 0;
+  size_t dealer = 0;
+  int64_t smallBlind = 0;
+  int64_t bigBlind = 0;
+  std::vector<int64_t> startingStacks; ///< Per seat, before the blinds.
+  std::vector<core::CardSet> holeCards; ///< Per seat; empty if not dealt.
+  std::vector<core::Card> board;        ///< In the order dealt.
+  std::vector<core::Action> actions;
+  std::vector<int64_t> finalStacks; ///< Per seat, after settlement.
+
+  [[nodiscard]] size_t numSeats() const noexcept {
+    return startingStacks.size();
+  }
+
+  bool operator==(const HandRecord &) const = default;
+};
+
+/// @brief Compact binary hand-history format.
+///
+/// File layout (version 1):
+///   Header     magic "PKRHIST\0", uint32 version, uint32 reserved
+///   Record*    varint length, then that many bytes of hand
+///
+/// A hand record is a sequence of LEB128 varints and single bytes, so the
+/// format is independent of host byte order:
+///   handId, numSeats, dealer, smallBlind, bigBlind
+///   startingStack[numSeats]
+///   holeCards[numSeats][2]     CardSet bit index per card, 0xFF = none
+///   boardCount, board[boardCount]
+///   numActions, then per action a tag (seat << 4 | hasAmount << 3 | type)
+///     followed by the amount when hasAmount is set
+///   finalStack[numSeats]       zigzag-encoded change from the start
+///
+/// A 6-handed hand takes about 100 bytes. The length prefix lets a reader
+/// step over a hand without decoding it.
+namespace hand_history {
+
+inline constexpr uint32_t kVersion = 1;
+inline constexpr size_t kHeaderSize = 16;
+
+/// Append one encoded record, length prefix included, to `out`.
+/// Throws std::invalid_argument if the record cannot be represented
+/// (seat counts that disagree, more than 64 seats, negative amounts), in
+/// which case `out` is left as it was.
+void encode(const HandRecord &record, std::vector<uint8_t> &out);
+
+/// Decode the body of one record (the bytes after its length prefix) into
+/// `record`, reusing its capacity. Throws std::runtime_error if the bytes
+/// are not a well-formed record.
+void decode(std::span<const uint8_t> body, HandRecord &record);
+
+/// Read a varint the caller knows to be complete and in bounds.
+inline uint64_t readVarintUnchecked(const uint8_t *&p) noexcept {
+  uint64_t value = 0;
+  for (unsigned shift = 0;; shift += 7) {
+    const uint8_t byte = *p++;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80)
+      return value;
+  }
+}
+
+} // namespace hand_history
+
+/// @brief Append-only, buffered writer of hand-history files.
+///
+/// Records are encoded into an in-memory buffer and written out whole, so
+/// a file never holds part of a hand unless the process dies mid-write.
+/// Opening an existing file appends to it after checking its header and
+/// cutting off such a torn last record, so the file stays readable.
+///
+/// The writer can be fed directly with append(), or hooked into an
+/// engine's event stream with HandHistoryObserver, in which case every
+/// hand the engine plays is recorded when it ends.
+class HandHistoryWriter {
+public:
+  /// Bytes buffered before they are written to the file.
+  static constexpr size_t kBufferBytes = size_t{1} << 16;
+
+  /// Open `path` for appending, creating it if needed. Everything from the
+  /// first record that does not parse on is truncated away first. Hands
+  /// recorded from engine events are numbered from `firstHandId`. Throws
+  /// std::runtime_error if the file cannot be opened or is not a
+  /// hand-history file of this version.
+  explicit HandHistoryWriter(const std::string &path,
+                             uint64_t firstHandId = 0);
+
+  HandHistoryWriter(HandHistoryWriter &&) = default;
+  HandHistoryWriter &operator=(HandHistoryWriter &&) = default;
+  HandHistoryWriter(const HandHistoryWriter &) = delete;
+  HandHistoryWriter &operator=(const HandHistoryWriter &) = delete;
+  /// Flushes; errors at this point are ignored.
+  ~HandHistoryWriter();
+
+  /// Append one hand. See hand_history::encode for what is rejected.
+  void append(const HandRecord &record);
+
+  /// Engine-event hook: HandStarted captures the table, HandEnded appends
+  /// the finished hand. Other events are ignored.
+  void onEvent(const HandEvent &event, const core::GameState &state);
+
+  /// Write buffered records to the file. Throws std::runtime_error on I/O
+  /// failure.
+  void flush();
+
+  /// Id the next hand recorded from engine events will get.
+  [[nodiscard]] uint64_t nextHandId() const noexcept { return nextHandId_; }
+  /// Hands appended through this writer.
+  [[nodiscard]] uint64_t handsWritten() const noexcept { return hands_; }
+  /// Record bytes appended through this writer, buffered or not.
+  [[nodiscard]] uint64_t bytesWritten() const noexcept { return bytes_; }
+
+private:
+  std::ofstream out_;
+  std::string path_;
+  std::vector<uint8_t> buffer_;
+  HandRecord pending_;     ///< Hand being captured from engine events.
+  bool inHand_ = false;
+  uint64_t nextHandId_ = 0;
+  uint64_t hands_ = 0;
+  uint64_t bytes_ = 0;
+};
+
+/// @brief Engine observer that records every hand into a HandHistoryWriter,
+/// e.g. BasicPokerEngine<Policy, Rng, HandHistoryObserver>, or passed to
+/// PokerEngine::setEventCallback. The writer must outlive the engine.
+struct HandHistoryObserver {
+  HandHistoryWriter *writer;
+
+  void operator()(const HandEvent &event, const core::GameState &state) const {
+    writer->onEvent(event, state);
+  }
+};
+
+/// @brief Zero-copy view of one record inside a mapped hand-history file.
+///
+/// Only the hand id is read eagerly; decode() materialises the rest.
+class HandView {
+public:
+  HandView() = default;
+  HandView(std::span<const uint8_t> body, uint64_t handId) noexcept
+      : body_(body), handId_(handId) {}
+
+  [[nodiscard]] uint64_t handId() const noexcept { return handId_; }
+  /// Encoded bytes of the hand, without the length prefix.
+  [[nodiscard]] std::span<const uint8_t> bytes() const noexcept {
+    return body_;
+  }
+
+  /// Decode into `record`, reusing its capacity.
+  void decode(HandRecord &record) const {
+    hand_history::decode(body_, record);
+  }
+  [[nodiscard]] HandRecord decode() const {
+    HandRecord record;
+    decode(record);
+    return record;
+  }
+
+private:
+  std::span<const uint8_t> body_;
+  uint64_t handId_ = 0;
+};
+
+/// @brief Read-only, memory-mapped hand-history file.
+///
+/// open() checks the header and walks the length prefixes once, so a file
+/// with a torn final record is rejected up front (reopening it with a
+/// HandHistoryWriter cuts the torn record off); iteration afterwards only
+/// reads the prefixes and hand ids straight from the mapping.
+class HandHistoryReader {
+public:
+  /// Forward iterator over the hands of a file, in file order.
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = HandView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const HandView *;
+    using reference = const HandView &;
+
+    Iterator() = default;
+    Iterator(const uint8_t *pos, const uint8_t *end) noexcept
+        : pos_(pos), end_(end) {
+      load();
+    }
+
+    reference operator*() const noexcept { return view_; }
+    pointer operator->() const noexcept { return &view_; }
+    Iterator &operator++() noexcept {
+      pos_ = next_;
+      load();
+      return *this;
+    }
+    Iterator operator++(int) noexcept {
+      Iterator old = *this;
+      ++*this;
+      return old;
+    }
+    bool operator==(const Iterator &other) const noexcept {
+      return pos_ == other.pos_;
+    }
+
+  private:
+    /// Parse the record at pos_; the reader validated every prefix.
+    void load() noexcept {
+      if (pos_ == end_)
+        return;
+      const uint8_t *p = pos_;
+      const uint64_t length = hand_history::readVarintUnchecked(p);
+      next_ = p + length;
+      const uint8_t *body = p;
+      const uint64_t handId = hand_history::readVarintUnchecked(p);
+      view_ = HandView({body, static_cast<size_t>(length)}, handId);
+    }
+
+    const uint8_t *pos_ = nullptr;
+    const uint8_t *end_ = nullptr;
+    const uint8_t *next_ = nullptr;
+    HandView view_;
+  };
+
+  /// Map a hand-history file. Throws std::runtime_error if the file is
+  /// missing, has the wrong magic or version, or ends inside a record.
+  [[nodiscard]] static HandHistoryReader open(const std::string &path);
+
+  HandHistoryReader(HandHistoryReader &&other) noexcept;
+  HandHistoryReader &operator=(HandHistoryReader &&other) noexcept;
+  HandHistoryReader(const HandHistoryReader &) = delete;
+  HandHistoryReader &operator=(const HandHistoryReader &) = delete;
+  ~HandHistoryReader();
+
+  [[nodiscard]] Iterator begin() const noexcept {
+    return Iterator(records_, end_);
+  }
+  [[nodiscard]] Iterator end() const noexcept { return Iterator(end_, end_); }
+
+  /// Number of hands in the file.
+  [[nodiscard]] size_t size() const noexcept { return numHands_; }
+  [[nodiscard]] bool empty() const noexcept { return numHands_ == 0; }
+  /// Size of the file in bytes, header included.
+  [[nodiscard]] size_t fileSize() const noexcept { return fileSize_; }
+
+private:
+  HandHistoryReader() = default;
+
+  utils::MappedFile file_;
+  const uint8_t *records_ = nullptr;
+  const uint8_t *end_ = nullptr;
+  size_t numHands_ = 0;
+  size_t fileSize_ = 0;
+};
+
+} // namespace poker::engine
@@ -1,60 +1,421 @@
 #pragma once
 
 #include "core/Deck.h"
+#include "core/LazyDeck.h"
 #include "core/GameState.h"
+#include "engine/EnginePolicies.h"
+#include "engine/GameTreeCursor.h"
+#include "engine/HandEvent.h"
 #include "engine/RuleEngine.h"
 #include "interfaces/IActionProvider.h"
 #include "interfaces/IRandomGenerator.h"
+#include "utils/HandEvaluator.h"
 
-#include <functional>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
 #include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 
 namespace poker::engine {
 
-/// @brief Callback type for hand events (optional observer pattern).
-using HandEventCallback =
-    std::function<void(const std::string &event, const core::GameState &state)>;
+/// Most seats one deck can deal a hand to: 52 cards cover two hole cards
+/// each plus the five board cards and three burns.
+inline constexpr size_t kMaxTableSeats = 22;
+
+/// Where a hand driven through the step-wise API stands.
+enum class StepStatus : uint8_t { AwaitingAction, HandComplete };
+
+/// A decision the engine is waiting for. legalActions stays valid until
+/// the next submit() or startHand().
+struct PendingDecision {
+  size_t playerId;
+  std::span<const core::Action> legalActions;
+};
 
 /// @brief The main game engine that drives a complete Texas Hold'em hand.
 ///
-/// PokerEngine controls the lifecycle:
+/// The engine controls the lifecycle:
 ///   deal → blinds → preflop → flop → turn → river → showdown → settle
 ///
-/// It delegates action selection to IActionProvider and action validation
-/// to RuleEngine. The engine itself contains no strategy logic.
-class PokerEngine {
+/// It delegates action validation to RuleEngine (through GameTreeCursor)
+/// and contains no strategy logic. A hand can be driven two ways:
+///   - playHand() runs it to completion, pulling actions from the
+///     IActionProvider;
+///   - the step-wise API (startHand / advance / pendingDecision / submit)
+///     never blocks, so one thread can drive any number of tables and feed
+///     in actions as they arrive.
+///
+/// The engine is parameterised on its collaborators, all held by value:
+///   - Policy (ActionPolicy) chooses actions for playHand();
+///   - Rng (DeckRng) randomises the deck: a uniform random bit generator
+///     such as core::Xoshiro256Generator deals lazily from a LazyDeck
+///     (only the cards a hand uses are drawn), anything else shuffles a
+///     full Deck. If it has beginHand() (as IRandomGenerator does), that is
+///     called first, so counter-based generators deal each hand from its
+///     own stream;
+///   - Observer (HandObserver) receives typed HandEvents. With NullObserver
+///     no event is ever constructed.
+/// PokerEngine plugs in the type-erased SharedActionProvider and
+/// SharedRandomGenerator. Self-play that knows its concrete types can name
+/// them instead, so decisions and shuffles become direct, inlinable calls.
+///
+/// Scratch buffers are owned by the engine and reused across hands, so a
+/// steady-state playHand() performs no heap allocation (given a provider,
+/// RNG and observer that do not allocate either).
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+class BasicPokerEngine {
 public:
-  /// @param actionProvider  Provides player actions (strategy, human, AI).
-  /// @param rng             Random generator for deck shuffling.
-  PokerEngine(std::shared_ptr<interfaces::IActionProvider> actionProvider,
-              std::shared_ptr<interfaces::IRandomGenerator> rng);
+  /// @param policy    Provides player actions (strategy, human, AI).
+  /// @param rng       Random generator for deck shuffling.
+  /// @param observer  Receives hand events.
+  BasicPokerEngine(Policy policy, Rng rng, Observer observer = Observer{});
 
-  /// Set the event callback for observing hand progress.
-  void setEventCallback(HandEventCallback callback);
+  /// Engine for the step-wise API; playHand() is unavailable if the
+  /// default Policy is empty (as SharedActionProvider's is).
+  explicit BasicPokerEngine(Rng rng, Observer observer = Observer{})
+    requires std::default_initializable<Policy>;
+
+  /// Set the event callback for observing hand progress. Pass an empty
+  /// callback to turn events off.
+  void setEventCallback(HandEventCallback callback)
+    requires std::is_same_v<Observer, CallbackObserver>
+  {
+    observer_.callback = std::move(callback);
+  }
+
+  [[nodiscard]] Policy &getPolicy() noexcept { return policy_; }
+  [[nodiscard]] Rng &getRng() noexcept { return rng_; }
+  [[nodiscard]] Observer &getObserver() noexcept { return observer_; }
+  [[nodiscard]] const Observer &getObserver() const noexcept {
+    return observer_;
+  }
 
   /// Play one complete hand. Modifies state in-place.
+  /// Throws std::invalid_argument for tables larger than kMaxTableSeats
+  /// or if the provider returns an illegal action, and std::logic_error if
+  /// the engine has no action provider.
   void playHand(core::GameState &state);
 
+  // --- Step-wise API ---
+
+  /// Shuffle, post blinds and deal hole cards for a new hand on `state`,
+  /// which must stay alive until the hand completes. Abandons any hand in
+  /// progress. Call advance() next. Throws std::invalid_argument for
+  /// tables larger than kMaxTableSeats.
+  void startHand(core::GameState &state);
+
+  /// Run until a player must act or the hand is over (board cards are
+  /// dealt and pots settled along the way). Returns AwaitingAction again,
+  /// without doing anything, while a decision is still pending.
+  /// Throws std::logic_error if no hand is in progress.
+  StepStatus advance();
+
+  /// The decision advance() stopped at, if any.
+  [[nodiscard]] std::optional<PendingDecision> pendingDecision() const;
+
+  /// Play the pending decision. The player id is taken from the decision.
+  /// Throws std::logic_error if nothing is pending and
+  /// std::invalid_argument (leaving the state untouched) if the action is
+  /// not legal.
+  void submit(core::Action action);
+
+  [[nodiscard]] bool isHandInProgress() const noexcept {
+    return hand_ != nullptr;
+  }
+
 private:
   void postBlinds(core::GameState &state);
+  [[nodiscard]] std::optional<core::Card> nextCard();
   void dealHoleCards(core::GameState &state);
-  void dealCommunityCards(core::GameState &state, size_t count);
-  void runBettingRound(core::GameState &state);
-  void showdown(core::GameState &state);
+  void dealStreet();
   void settleHand(core::GameState &state);
 
-  /// Get the first player to act for this street.
-  [[nodiscard]] size_t getFirstToAct(const core::GameState &state) const;
+  /// Report the event built by make() unless the observer ignores events,
+  /// in which case make() is never called.
+  template <typename MakeEvent>
+  void notify(const core::GameState &state, MakeEvent &&make) {
+    if constexpr (kObservesEvents<Observer>) {
+      observer_(HandEvent(make()), state);
+    }
+  }
 
-  /// Check if hand should end early (all but one folded, or all-in showdown).
-  [[nodiscard]] bool isHandOver(const core::GameState &state) const;
+  [[no_unique_address]] Policy policy_;
+  [[no_unique_address]] Rng rng_;
+  [[no_unique_address]] Observer observer_;
 
-  void emitEvent(const std::string &event, const core::GameState &state);
+  static constexpr bool kLazyDeck = std::uniform_random_bit_generator<Rng>;
+  std::conditional_t<kLazyDeck, core::LazyDeck, core::Deck> deck_;
 
-  std::shared_ptr<interfaces::IActionProvider> actionProvider_;
-  std::shared_ptr<interfaces::IRandomGenerator> rng_;
-  HandEventCallback eventCallback_;
-  core::Deck deck_;
+  // Hand in progress: the state being played and the cursor applying the
+  // rules to it. Both are reused across hands.
+  core::GameState *hand_ = nullptr;
+  GameTreeCursor cursor_;
+  const core::ActionList *pending_ = nullptr;
+
+  // Reused per-hand scratch space.
+  std::vector<core::SidePot> sidePots_;
+  std::vector<core::Action> legalScratch_; ///< For vector-taking policies.
 };
 
+/// Engine over IActionProvider / IRandomGenerator, reporting events to a
+/// callback installed at run time.
+using PokerEngine = BasicPokerEngine<SharedActionProvider,
+                                     SharedRandomGenerator, CallbackObserver>;
+
+/// The same without events, for headless simulation.
+using HeadlessPokerEngine =
+    BasicPokerEngine<SharedActionProvider, SharedRandomGenerator,
+                     NullObserver>;
+
+// ── Implementation ──────────────────────────────────────
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+BasicPokerEngine<Policy, Rng, Observer>::BasicPokerEngine(Policy policy,
+                                                          Rng rng,
+                                                          Observer observer)
+    : policy_(std::move(policy)), rng_(std::move(rng)),
+      observer_(std::move(observer)) {}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+BasicPokerEngine<Policy, Rng, Observer>::BasicPokerEngine(Rng rng,
+                                                          Observer observer)
+  requires std::default_initializable<Policy>
+    : rng_(std::move(rng)), observer_(std::move(observer)) {}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+void BasicPokerEngine<Policy, Rng, Observer>::playHand(core::GameState &state) {
+  if constexpr (std::is_constructible_v<bool, const Policy &>) {
+    if (!static_cast<bool>(policy_))
+      throw std::logic_error("playHand needs an action provider");
+  }
+  startHand(state);
+  while (advance() == StepStatus::AwaitingAction) {
+    const size_t seat = cursor_.getCurrentPlayer();
+    if constexpr (ActionListPolicy<Policy>) {
+      submit(policy_.chooseAction(seat, state, *pending_));
+    } else {
+      legalScratch_.assign(pending_->begin(), pending_->end());
+      submit(policy_.getAction(seat, state, legalScratch_));
+    }
+  }
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+void BasicPokerEngine<Policy, Rng, Observer>::startHand(
+    core::GameState &state) {
+  if (state.getPlayers().size() > kMaxTableSeats) {
+    throw std::invalid_argument("PokerEngine supports at most 22 seats");
+  }
+  hand_ = nullptr;
+  pending_ = nullptr;
+  state.resetForNewHand();
+
+  // Shuffle and deal.
+  if constexpr (requires { rng_.beginHand(); }) {
+    rng_.beginHand();
+  }
+  if constexpr (kLazyDeck) {
+    deck_.restore();
+  } else {
+    deck_.reset();
+    deck_.shuffle(rng_);
+  }
+
+  notify(state, [&] { return HandStarted{state.getDealerPosition()}; });
+
+  postBlinds(state);
+  dealHoleCards(state);
+
+  cursor_.reset(state);
+  hand_ = &state;
+  notify(state, [&] {
+    return StreetStarted{core::Street::Preflop, state.getCommunityCardSet(),
+                         state.getPot().getTotal()};
+  });
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+StepStatus BasicPokerEngine<Policy, Rng, Observer>::advance() {
+  if (!hand_) {
+    throw std::logic_error("advance: no hand in progress");
+  }
+  // Street progression: Preflop → Flop → Turn → River → Showdown, with the
+  // cursor deciding when betting on a street is over.
+  while (true) {
+    switch (cursor_.getNodeType()) {
+    case GameTreeCursor::NodeType::Decision:
+      if (!pending_)
+        pending_ = &cursor_.getLegalActions();
+      return StepStatus::AwaitingAction;
+    case GameTreeCursor::NodeType::Chance:
+      dealStreet();
+      break;
+    case GameTreeCursor::NodeType::Terminal: {
+      core::GameState &state = *hand_;
+      hand_ = nullptr;
+      settleHand(state);
+      notify(state, [] { return HandEnded{}; });
+      return StepStatus::HandComplete;
+    }
+    }
+  }
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+std::optional<PendingDecision>
+BasicPokerEngine<Policy, Rng, Observer>::pendingDecision() const {
+  if (!pending_)
+    return std::nullopt;
+  return PendingDecision{cursor_.getCurrentPlayer(), *pending_};
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+void BasicPokerEngine<Policy, Rng, Observer>::submit(core::Action action) {
+  if (!pending_) {
+    throw std::logic_error("submit: no decision pending");
+  }
+  cursor_.apply(action);
+  pending_ = nullptr;
+  notify(*hand_, [&] {
+    return ActionTaken{hand_->getActionHistory().back(),
+                       hand_->getPot().getTotal()};
+  });
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+void BasicPokerEngine<Policy, Rng, Observer>::postBlinds(
+    core::GameState &state) {
+  auto &players = state.getMutablePlayers();
+  size_t sbPos = state.getSmallBlindPosition();
+  size_t bbPos = state.getBigBlindPosition();
+
+  int64_t sbAmount = players[sbPos].placeBet(state.getSmallBlind());
+  state.getMutablePot().addContribution(sbPos, sbAmount);
+  state.recordAction(core::Action(core::ActionType::Bet, sbAmount, sbPos));
+  notify(state, [&] { return BlindPosted{sbPos, sbAmount, false}; });
+
+  int64_t bbAmount = players[bbPos].placeBet(state.getBigBlind());
+  state.getMutablePot().addContribution(bbPos, bbAmount);
+  state.recordAction(core::Action(core::ActionType::Bet, bbAmount, bbPos));
+  notify(state, [&] { return BlindPosted{bbPos, bbAmount, true}; });
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+std::optional<core::Card> BasicPokerEngine<Policy, Rng, Observer>::nextCard() {
+  if constexpr (kLazyDeck) {
+    return deck_.draw(rng_);
+  } else {
+    return deck_.deal();
+  }
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+void BasicPokerEngine<Policy, Rng, Observer>::dealHoleCards(
+    core::GameState &state) {
+  auto &players = state.getMutablePlayers();
+  // Deal 2 cards to each player, starting left of dealer.
+  for (int round = 0; round < 2; ++round) {
+    for (size_t i = 0; i < players.size(); ++i) {
+      size_t idx = (state.getDealerPosition() + 1 + i) % players.size();
+      auto card = nextCard();
+      if (card) {
+        players[idx].dealCard(*card);
+      }
+    }
+  }
+  notify(state, [] { return HoleCardsDealt{}; });
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+void BasicPokerEngine<Policy, Rng, Observer>::dealStreet() {
+  // Burn one card, then deal the street.
+  (void)nextCard();
+  std::array<core::Card, 3> cards;
+  const size_t count = cursor_.cardsNeeded();
+  for (size_t i = 0; i < count; ++i) {
+    const auto card = nextCard();
+    if (!card) {
+      throw std::logic_error("dealStreet: the deck ran out");
+    }
+    cards[i] = *card;
+  }
+  const core::Street street = hand_->getStreet();
+  cursor_.dealBoard(std::span<const core::Card>(cards.data(), count));
+  notify(*hand_, [&] {
+    return StreetStarted{street, hand_->getCommunityCardSet(),
+                         hand_->getPot().getTotal()};
+  });
+}
+
+template <ActionPolicy Policy, DeckRng Rng, HandObserver Observer>
+void BasicPokerEngine<Policy, Rng, Observer>::settleHand(
+    core::GameState &state) {
+  auto &players = state.getMutablePlayers();
+
+  // If only one player remains, they win everything.
+  if (state.getNumPlayersInHand() == 1) {
+    for (auto &p : players) {
+      if (!p.isFolded()) {
+        const int64_t total = state.getPot().getTotal();
+        p.awardChips(total);
+        notify(state, [&] {
+          return PotAwarded{total, core::seatBit(p.getId()), 0, true};
+        });
+        break;
+      }
+    }
+    return;
+  }
+
+  // Build folded set.
+  core::SeatMask folded = 0;
+  for (const auto &p : players) {
+    if (p.isFolded()) {
+      folded |= core::seatBit(p.getId());
+    }
+  }
+  notify(state, [&] {
+    const core::SeatMask seats = players.size() < core::kMaxSeats
+                                     ? core::seatBit(players.size()) - 1
+                                     : ~core::SeatMask{0};
+    return ShowdownStarted{state.getCommunityCardSet(), seats & ~folded};
+  });
+
+  // Calculate side pots.
+  state.getPot().calculateSidePots(folded, sidePots_);
+
+  // For each pot, determine winner(s).
+  const core::CardSet community = state.getCommunityCardSet();
+
+  for (const auto &pot : sidePots_) {
+    if (pot.eligible == 0)
+      continue;
+
+    // Best hands among the eligible players share the pot.
+    const PotSplit split = RuleEngine::splitPot(pot, players, community);
+    for (core::SeatMask m = split.winners; m != 0; m &= m - 1) {
+      const auto seat = static_cast<size_t>(std::countr_zero(m));
+      players[seat].awardChips(split.award(seat));
+    }
+
+    notify(state, [&] {
+      return PotAwarded{pot.amount, split.winners, split.strength, false};
+    });
+  }
+}
+
+extern template class BasicPokerEngine<SharedActionProvider,
+                                       SharedRandomGenerator, CallbackObserver>;
+extern template class BasicPokerEngine<SharedActionProvider,
+                                       SharedRandomGenerator, NullObserver>;
+
 } // namespace poker::engine
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "core/GameState.h"
+#include "core/Pot.h"
+#include "engine/GameTreeCursor.h"
+#include "engine/HandHistory.h"
+#include "interfaces/IActionProvider.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace poker::engine {
+
+/// @brief Random access to every decision point of recorded hands.
+///
+/// stateAt(handId, i) rebuilds the GameState of a hand just before its
+/// i-th logged action: stacks, bets, pot contributions, folds, board,
+/// street and the player to act, exactly as the engine had them. Nothing is
+/// re-run through PokerEngine; the recorded actions are applied with a
+/// GameTreeCursor, which also checks them against the rules.
+///
+/// Index 0 is the bare table, 1 and 2 follow the blinds (the first two
+/// logged actions, as the engine posts them), and actions().size() is the
+/// end of the hand with the board run out. Whenever a betting round closes
+/// the next street is dealt from the record, so a state at a decision
+/// always shows the board that player saw.
+///
+/// The hand being replayed keeps a snapshot at the start of each betting
+/// round. Stepping forward is O(1) per action, and any other seek within
+/// the hand restores the nearest earlier snapshot and replays at most one
+/// street. Moving to another hand decodes and sets it up once.
+///
+/// rerun() plays a hand on from any point with a different provider, for
+/// counterfactual analysis.
+class Replay {
+public:
+  /// Number of logged actions that are blinds.
+  static constexpr size_t kBlindActions = 2;
+
+  /// Index every hand of `reader`, which must outlive the Replay. Seat i
+  /// is named names[i], or "Seat i" if there is no such entry. Throws
+  /// std::invalid_argument if two hands share an id.
+  explicit Replay(const HandHistoryReader &reader,
+                  std::vector<std::string> names = {});
+
+  /// Replay hands held in memory. Same naming and id rules.
+  explicit Replay(std::vector<HandRecord> hands,
+                  std::vector<std::string> names = {});
+
+  [[nodiscard]] size_t size() const noexcept { return index_.size(); }
+  [[nodiscard]] bool contains(uint64_t handId) const {
+    return index_.contains(handId);
+  }
+
+  /// The decoded record of a hand. Throws std::out_of_range for an unknown
+  /// id. The reference is valid until another hand is loaded.
+  [[nodiscard]] const HandRecord &record(uint64_t handId);
+
+  /// State just before action `actionIndex` of hand `handId` (see above).
+  /// Throws std::out_of_range for an unknown id or an index past the end,
+  /// and std::runtime_error if the record is not a legal hand. The
+  /// reference is valid until the next call on this Replay.
+  [[nodiscard]] const core::GameState &stateAt(uint64_t handId,
+                                               size_t actionIndex);
+
+  /// Main and side pots of the last state returned, main pot first, as
+  /// they would be paid if the hand ended now.
+  [[nodiscard]] std::span<const core::SidePot> sidePots();
+
+  /// Play hand `handId` on from action `actionIndex` with `provider`
+  /// choosing every remaining action, instead of the recorded ones. Board
+  /// cards come from the record while it has them; streets the original
+  /// hand never reached are dealt from the unseen cards, shuffled by
+  /// `seed`. Returns the resulting hand, settled, with the same id.
+  /// actionIndex must be at least kBlindActions. Throws as stateAt(), and
+  /// std::invalid_argument if the provider plays an illegal action.
+  [[nodiscard]] HandRecord rerun(uint64_t handId, size_t actionIndex,
+                                 interfaces::IActionProvider &provider,
+                                 uint64_t seed = 0);
+
+private:
+  /// State at the start of a betting round (or of the hand).
+  struct Snapshot {
+    size_t actionIndex = 0;
+    core::GameState state;
+  };
+
+  /// Sentinel for "state_ does not follow the loaded record".
+  static constexpr size_t kDirty = static_cast<size_t>(-1);
+
+  void addHand(HandView view, size_t position);
+  void load(uint64_t handId);
+  void restore(size_t actionIndex);
+  void stepTo(size_t actionIndex);
+  void postBlind(const core::Action &blind);
+  /// Deal recorded board cards while the cursor waits on a chance node.
+  void dealRecordedBoard();
+  void takeSnapshot();
+
+  const HandHistoryReader *reader_ = nullptr;
+  std::vector<HandView> views_;
+  std::vector<HandRecord> records_;
+  std::unordered_map<uint64_t, size_t> index_; ///< Hand id -> position.
+  std::vector<std::string> names_;
+
+  // The hand being replayed.
+  bool loaded_ = false;
+  uint64_t handId_ = 0;
+  HandRecord record_;
+  std::vector<Snapshot> snapshots_;
+  size_t numSnapshots_ = 0;
+  core::GameState state_;
+  GameTreeCursor cursor_;
+  size_t position_ = kDirty; ///< Actions applied to state_.
+  std::vector<core::SidePot> sidePots_;
+};
+
+} // namespace poker::engine
@@ -1,27 +1,76 @@
 #pragma once
 
 #include "core/Action.h"
+#include "core/ActionList.h"
+#include "core/BettingRound.h"
 #include "core/GameState.h"
+#include "core/Pot.h"
+#include "utils/HandEvaluator.h"
 
 
+#include <bit>
+#include <span>
 #include <vector>
 
 namespace poker::engine {
 
+/// @brief How one side pot is shared at showdown.
+struct PotSplit {
+  core::SeatMask winners = 0;       ///< Eligible seats with the best hand.
+  utils::HandStrength strength = 0; ///< That hand's strength.
+  int64_t share = 0;                ///< Each winner's even share.
+  core::SeatMask oddChips = 0;      ///< Winners who also get an odd chip.
+
+  /// Chips `seat` takes from the pot.
+  [[nodiscard]] int64_t award(size_t seat) const noexcept {
+    return (winners >> seat & 1) ? share + static_cast<int64_t>(
+                                               oddChips >> seat & 1)
+                                 : 0;
+  }
+};
+
 /// @brief Validates player actions against the current game state.
 ///
 /// RuleEngine is stateless — all validation is based on the GameState
 /// snapshot passed to each method.
+///
+/// Every query comes in two forms. The bare-state form rescans the players
+/// for the bet level and the action history for the last raise, so it
+/// works on any hand-built state. The form that also takes the street's
+/// BettingRound reads the bet level, the last full raise increment and
+/// whether the player may still raise from it, in O(1); it is the one to
+/// use in search, and the one GameTreeCursor (and so PokerEngine) applies.
+/// Only it knows that a short all-in raise does not reopen raising.
 class RuleEngine {
 public:
   /// Get all legal actions for a player given the current game state.
   [[nodiscard]] static std::vector<core::Action>
   getLegalActions(const core::GameState &state, size_t playerId);
 
+  /// Same as above, written into `out` (cleared first). Reusing one buffer
+  /// keeps per-decision queries free of heap allocation.
+  static void getLegalActions(const core::GameState &state, size_t playerId,
+                              std::vector<core::Action> &out);
+
+  /// Same as above, into inline storage (cleared first).
+  static void getLegalActions(const core::GameState &state, size_t playerId,
+                              core::ActionList &out);
+
   /// Check if a specific action is legal.
   [[nodiscard]] static bool isActionLegal(const core::GameState &state,
                                           const core::Action &action);
 
+  /// Same check against a legal-action list already computed for
+  /// action.playerId (a std::vector or a core::ActionList).
+  [[nodiscard]] static bool
+  isActionLegal(const core::GameState &state, const core::Action &action,
+                std::span<const core::Action> legalActions);
+
+  /// First seat to act on the current street: left of the big blind
+  /// preflop, left of the dealer afterwards, skipping seats that have
+  /// folded or are all-in.
+  [[nodiscard]] static size_t getFirstToAct(const core::GameState &state);
+
   /// Minimum raise size according to NLHE rules.
   [[nodiscard]] static int64_t getMinRaise(const core::GameState &state,
                                            size_t playerId);
@@ -33,6 +82,39 @@ public:
   /// Amount required to call.
   [[nodiscard]] static int64_t getCallAmount(const core::GameState &state,
                                              size_t playerId);
+
+  // --- O(1) queries against the street's BettingRound ---
+
+  /// Legal actions for playerId, written into `out` (cleared first).
+  static void getLegalActions(const core::GameState &state,
+                              const core::BettingRound &round,
+                              size_t playerId, core::ActionList &out);
+
+  /// Whether `action` is legal, decided without building the legal list.
+  [[nodiscard]] static bool isActionLegal(const core::GameState &state,
+                                          const core::BettingRound &round,
+                                          const core::Action &action);
+
+  /// Smallest total bet a raise may make: the bet level plus the last full
+  /// raise increment (at least the big blind), capped at the player's
+  /// stack.
+  [[nodiscard]] static int64_t getMinRaise(const core::GameState &state,
+                                           const core::BettingRound &round,
+                                           size_t playerId);
+
+  /// Amount required to call, capped at the player's stack.
+  [[nodiscard]] static int64_t getCallAmount(const core::GameState &state,
+                                             const core::BettingRound &round,
+                                             size_t playerId);
+
+  // --- Showdown ---
+
+  /// Split `pot` among its eligible seats holding the best hand on
+  /// `board`: evenly, with the odd chips going one each to the lowest
+  /// winning seats. A pot nobody is eligible for has no winners.
+  [[nodiscard]] static PotSplit splitPot(const core::SidePot &pot,
+                                         std::span<const core::Player> players,
+                                         core::CardSet board);
 };
 
 } // namespace poker::engine
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/Action.h"
+#include "core/ActionList.h"
 #include "core/GameState.h"
 
 
@@ -28,6 +29,19 @@ public:
   virtual core::Action
   getAction(size_t playerId, const core::GameState &state,
             const std::vector<core::Action> &legalActions) = 0;
+
+  /// The engine's entry point: the same decision with the legal actions in
+  /// inline storage. The default copies them into a reused per-thread
+  /// vector and calls getAction(); providers on hot paths override this
+  /// one to read the list directly. It has its own name so that providers
+  /// overriding only getAction() do not hide it.
+  virtual core::Action chooseAction(size_t playerId,
+                                    const core::GameState &state,
+                                    const core::ActionList &legalActions) {
+    thread_local std::vector<core::Action> scratch;
+    scratch.assign(legalActions.begin(), legalActions.end());
+    return getAction(playerId, state, scratch);
+  }
 };
 
 } // namespace poker::interfaces
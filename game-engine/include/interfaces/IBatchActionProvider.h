@@ -0,0 +1,38 @@
+#pragma once
+
+#include "core/Action.h"
+#include "core/GameState.h"
+
+#include <cstddef>
+#include <span>
+
+
+namespace poker::interfaces {
+
+/// One decision waiting in a batch. The state and legal actions stay valid
+/// until the provider returns.
+struct BatchDecision {
+  size_t table;    ///< Index of the table, as assigned by the scheduler.
+  size_t playerId; ///< Seat that must act.
+  const core::GameState *state;
+  std::span<const core::Action> legalActions;
+};
+
+/// @brief Interface for policies that decide many tables at once.
+///
+/// Implement this instead of IActionProvider when a query has a high fixed
+/// cost (a neural network forward pass, a table lookup that wants sorted
+/// keys) that is best amortised over many states.
+class IBatchActionProvider {
+public:
+  virtual ~IBatchActionProvider() = default;
+
+  /// Choose an action for every decision.
+  /// @param decisions  Pending decisions, from distinct tables.
+  /// @param actions    Same size as decisions; write actions[i] for
+  ///                   decisions[i]. Each must be one of its legalActions.
+  virtual void getActions(std::span<const BatchDecision> decisions,
+                          std::span<core::Action> actions) = 0;
+};
+
+} // namespace poker::interfaces
@@ -19,6 +19,11 @@ public:
 
   /// Shuffle a vector of cards in-place.
   virtual void shuffle(std::vector<poker::core::Card> &cards) = 0;
+
+  /// Called by the engine before dealing each hand. Counter-based
+  /// generators (core::PhiloxGenerator) move to that hand's stream here;
+  /// sequential ones need not do anything.
+  virtual void beginHand() {}
 };
 
 } // namespace poker::interfaces
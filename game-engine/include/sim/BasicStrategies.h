@@ -0,0 +1,39 @@
+#pragma once
+
+#include "interfaces/IPlayerStrategy.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace poker::sim {
+
+/// @brief Checks when it can, otherwise calls. Never folds or raises.
+class CallingStrategy : public interfaces::IPlayerStrategy {
+public:
+  core::Action getAction(const core::GameState &state,
+                         const std::vector<core::Action> &legal) override;
+};
+
+/// @brief Bets or raises the minimum whenever allowed, otherwise calls.
+class AggressiveStrategy : public interfaces::IPlayerStrategy {
+public:
+  core::Action getAction(const core::GameState &state,
+                         const std::vector<core::Action> &legal) override;
+};
+
+/// @brief Picks uniformly among the legal actions, except that it never
+/// folds when it could check.
+class RandomStrategy : public interfaces::IPlayerStrategy {
+public:
+  explicit RandomStrategy(uint64_t seed) : rng_(seed) {}
+
+  core::Action getAction(const core::GameState &state,
+                         const std::vector<core::Action> &legal) override;
+
+private:
+  std::mt19937_64 rng_;
+};
+
+} // namespace poker::sim
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "core/Random.h"
+#include "interfaces/IPlayerStrategy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace poker::sim {
+
+/// Settings for a self-play run.
+struct SelfPlayConfig {
+  size_t numTables = 256;
+  size_t handsPerTable = 2000;
+  size_t seatsPerTable = 0; ///< 0 = one seat per registered strategy.
+  int64_t startingStack = 10000;
+  int64_t smallBlind = 50;
+  int64_t bigBlind = 100;
+  uint64_t seed = 1;
+};
+
+/// Aggregated outcome for one strategy.
+struct StrategyResult {
+  std::string name;
+  uint64_t seatHands = 0; ///< Hands played, counted once per seat held.
+  int64_t netChips = 0;
+  double bbPer100 = 0.0;
+  double ci95 = 0.0; ///< Half-width of the 95% confidence interval.
+};
+
+struct SelfPlayResult {
+  uint64_t hands = 0;
+  size_t threads = 0;
+  double elapsedSeconds = 0.0;
+  double handsPerSecond = 0.0;
+  std::vector<StrategyResult> strategies; ///< In registration order.
+};
+
+/// Throughput at one thread count, relative to the first point measured.
+struct ScalingPoint {
+  size_t threads = 0;
+  double handsPerSecond = 0.0;
+  double speedup = 0.0;
+  double efficiency = 0.0; ///< speedup / (threads / baseline threads).
+};
+
+/// @brief Plays many independent headless tables in parallel and
+/// aggregates chip results per strategy.
+///
+/// Each table is one task on a work-stealing ThreadPool. A table's
+/// strategy instances are seeded from (config.seed, table index) only, the
+/// cards of each hand come from a counter-based PhiloxGenerator keyed by
+/// (config.seed, table, hand), and per-table tallies are reduced in table
+/// order, so results are bit-identical for any thread count. Any hand's
+/// cards can be regenerated on their own with deckGenerator().
+///
+/// Stacks are reset to startingStack before every hand, so each hand is an
+/// independent sample; the dealer button rotates every hand and seat s at
+/// table t is held by strategy (s + t) mod numStrategies to balance
+/// positions. Confidence intervals treat every seat-hand as a sample, which
+/// is slightly optimistic since seats in the same hand are correlated.
+class SelfPlayRunner {
+public:
+  /// Creates a fresh strategy instance for one seat from a seed.
+  using StrategyFactory =
+      std::function<std::unique_ptr<interfaces::IPlayerStrategy>(uint64_t)>;
+
+  explicit SelfPlayRunner(SelfPlayConfig config = {});
+
+  void addStrategy(std::string name, StrategyFactory factory);
+
+  [[nodiscard]] size_t numStrategies() const noexcept {
+    return names_.size();
+  }
+  [[nodiscard]] const SelfPlayConfig &getConfig() const noexcept {
+    return config_;
+  }
+
+  /// Play every table. Throws std::invalid_argument for an unusable
+  /// configuration (no strategies, fewer than 2 or too many seats, ...).
+  /// @param threads  Worker count (0 = hardware concurrency).
+  [[nodiscard]] SelfPlayResult run(size_t threads = 0) const;
+
+  /// Run the full configuration once per thread count and report speedup
+  /// and efficiency relative to the first entry.
+  [[nodiscard]] std::vector<ScalingPoint>
+  measureScaling(std::span<const size_t> threadCounts) const;
+
+  /// Seed for the given table's strategies, derived from the run seed.
+  [[nodiscard]] static uint64_t tableSeed(uint64_t seed,
+                                          size_t table) noexcept;
+
+  /// Generator that deals hand `hand` of table `table` exactly as run()
+  /// did; play one hand with it (or draw from a LazyDeck) to regenerate
+  /// the cards.
+  [[nodiscard]] static core::PhiloxGenerator
+  deckGenerator(uint64_t seed, size_t table, uint64_t hand) noexcept {
+    return core::PhiloxGenerator(seed, static_cast<uint32_t>(table), hand);
+  }
+
+private:
+  [[nodiscard]] size_t seatsPerTable() const noexcept;
+
+  SelfPlayConfig config_;
+  std::vector<std::string> names_;
+  std::vector<StrategyFactory> factories_;
+};
+
+} // namespace poker::sim
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "core/BettingRound.h"
+#include "core/CardSet.h"
+#include "engine/ActionAbstraction.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+
+
+namespace poker::solver {
+
+/// Maps a player's view of the cards on a street to a bucket id. Hands in
+/// the same bucket share an information set.
+using CardBucketFn = std::function<uint64_t(
+    core::Street street, core::CardSet hole, core::CardSet board)>;
+
+/// Settings for heads-up no-limit training.
+struct MccfrConfig {
+  int64_t startingStack = 20000;
+  int64_t smallBlind = 50;
+  int64_t bigBlind = 100;
+  /// Bet sizes offered, at most MccfrTrainer::kMaxActions - 3 at any point
+  /// (fold, check or call, and all-in take the other slots).
+  engine::ActionAbstraction actions;
+  /// Bets and raises allowed per street; past it only fold and call.
+  size_t maxRaisesPerStreet = 4;
+  /// log2 of the information-set slots, 64 bytes each (20: 64 MB).
+  unsigned tableBits = 20;
+  uint64_t seed = 1;
+  /// Card abstraction; empty keeps the exact cards.
+  CardBucketFn cardBuckets;
+  /// train() saves to checkpointPath every this many iterations (0: never).
+  uint64_t checkpointEvery = 0;
+  std::string checkpointPath;
+};
+
+/// @brief External-sampling Monte Carlo CFR for heads-up no-limit hold'em.
+///
+/// Each iteration samples the hole cards and a full board, then walks the
+/// abstract game tree for one seat (alternating): every action of the
+/// traverser is explored and its regrets updated, while the opponent's
+/// action and the cards are sampled. The tree is walked in place with a
+/// GameTreeCursor, so legality is RuleEngine's and showdown payoffs are
+/// HandEvaluator's; bet sizes come from the config's ActionAbstraction.
+///
+/// There are no node objects. Each information set is one 64-byte slot of
+/// a flat, cache-line-aligned, open-addressed table, found by a hash of the
+/// betting history, the seat and its card bucket: the key, the cumulative
+/// regrets and the average-strategy sums for up to kMaxActions actions, so
+/// a visit touches exactly one cache line. Workers share the table and
+/// update it with relaxed atomic adds and a compare-and-swap to claim a
+/// slot, without locks.
+///
+/// Iteration t deals from PhiloxGenerator(seed, 0, t), so a single-threaded
+/// run is reproducible. Utilities are in big blinds.
+class MccfrTrainer {
+public:
+  static constexpr size_t kMaxActions = 6;
+
+  /// Throws std::invalid_argument for a bad configuration (stacks or
+  /// blinds not positive, too many bet sizes, tableBits outside 4..32).
+  explicit MccfrTrainer(MccfrConfig config);
+  ~MccfrTrainer();
+
+  MccfrTrainer(const MccfrTrainer &) = delete;
+  MccfrTrainer &operator=(const MccfrTrainer &) = delete;
+
+  /// Run `iterations` more iterations on `threads` workers (0: hardware
+  /// concurrency), checkpointing as configured. Throws std::runtime_error
+  /// if the table fills up.
+  void train(uint64_t iterations, size_t threads = 0);
+
+  [[nodiscard]] uint64_t getIterations() const noexcept {
+    return iterations_;
+  }
+  [[nodiscard]] const MccfrConfig &getConfig() const noexcept {
+    return config_;
+  }
+  /// Information sets visited so far.
+  [[nodiscard]] size_t numInfoSets() const noexcept {
+    return used_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] size_t tableCapacity() const noexcept { return mask_ + 1; }
+
+  // --- Strategy lookup ---
+
+  /// History hash at the root of a hand.
+  static constexpr uint64_t kRootHistory = 0x6A09E667F3BCC908ull;
+
+  /// History after taking the action at `actionIndex` of the abstract
+  /// list (engine::ActionAbstraction::expand() with the raise cap applied).
+  [[nodiscard]] static uint64_t historyStep(uint64_t history,
+                                            size_t actionIndex) noexcept;
+  /// History after the board for the next street is dealt.
+  [[nodiscard]] static uint64_t streetStep(uint64_t history) noexcept;
+
+  /// Card bucket of a seat on a street, as training uses it.
+  [[nodiscard]] uint64_t cardBucket(core::Street street, core::CardSet hole,
+                                    core::CardSet board) const;
+
+  /// Information-set key for `seat` acting after `history` with cards in
+  /// `bucket`.
+  [[nodiscard]] static uint64_t infoSetKey(uint64_t history, size_t seat,
+                                           uint64_t bucket) noexcept;
+
+  /// Average strategy at an information set with out.size() actions,
+  /// normalised; uniform if it was never visited. Returns whether it was.
+  bool averageStrategy(uint64_t key, std::span<float> out) const;
+
+  // --- Checkpoints ---
+
+  /// Write every visited information set and the iteration count. The
+  /// file is written beside `path` and renamed over it, so a crash leaves
+  /// the previous checkpoint intact. Throws std::runtime_error on I/O
+  /// failure.
+  void saveCheckpoint(const std::string &path) const;
+
+  /// Replace the table with a checkpoint written for the same stacks,
+  /// blinds and action limit. Throws std::runtime_error if the file is
+  /// missing, corrupt or from another game, or does not fit the table.
+  /// Errors found before loading starts leave the trainer untouched; later
+  /// ones leave it empty, at zero iterations.
+  void loadCheckpoint(const std::string &path);
+
+private:
+  /// One information set: exactly one cache line.
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> key{0}; ///< 0: empty.
+    std::array<std::atomic<float>, kMaxActions> regret{};
+    std::array<std::atomic<float>, kMaxActions> strategy{};
+  };
+  static_assert(sizeof(Slot) == 64);
+
+  class Worker;
+
+  /// The slot for `key`, claimed if new. Throws std::runtime_error if the
+  /// probe window is full.
+  Slot &findOrInsert(uint64_t key);
+  [[nodiscard]] const Slot *find(uint64_t key) const noexcept;
+  void clear() noexcept;
+
+  MccfrConfig config_;
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_ = 0;
+  std::atomic<size_t> used_{0};
+  uint64_t iterations_ = 0;
+};
+
+} // namespace poker::solver
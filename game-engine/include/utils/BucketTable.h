@@ -0,0 +1,162 @@
+#pragma once
+
+#include "core/BettingRound.h"
+#include "core/CardSet.h"
+#include "utils/HandIndexer.h"
+#include "utils/MappedFile.h"
+#include "utils/Range.h"
+#include "utils/ThreadPool.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace poker::utils {
+
+/// @brief Settings for BucketTable::build().
+struct BucketBuildOptions {
+  /// Buckets per street, preflop to river. A street given at least as
+  /// many buckets as it has isomorphism classes is left lossless.
+  std::array<size_t, 4> buckets = {169, 256, 256, 256};
+  /// Resolution of the equity histograms clustered on preflop to turn.
+  size_t histogramBins = 16;
+  size_t iterations = 25; ///< Lloyd iterations per street at most.
+  uint64_t seed = 1;
+  size_t threads = 0; ///< 0 = all hardware threads.
+  /// Told what each stage finished, e.g. for a generator's log; optional.
+  std::function<void(const std::string &)> progress;
+};
+
+/// @brief Read-only, memory-mapped card abstraction: the bucket of every
+/// hand on every street.
+///
+/// Hands are looked up by their HandIndexer class, so a lookup is one
+/// index computation (under 100 ns) and one byte (or two, past 256 buckets)
+/// read from the mapping, with the file shared in the page cache by every
+/// process using it. The turn and river sections (14 MB and 123 MB or more)
+/// do not fit in cache, so a random lookup there also pays a memory miss
+/// (`benchmarks/bench_bucket_table`). A street stored without buckets is
+/// lossless and its bucket is the class index itself.
+///
+/// Buckets come from build(), which clusters every class of a street on its
+/// equity against a random hand:
+///   - River: the exact equity, clustered in one dimension.
+///   - Turn and flop: the histogram of river equities over every runout
+///     (equity distributions), as cumulative fractions so that k-means's
+///     Euclidean distance tracks the earth mover's distance.
+///   - Preflop: the histogram of flop equities over every flop.
+/// Buckets are numbered weakest first. At the defaults build() takes about
+/// 20 minutes on one core, most of it in the turn's k-means (about 35 s a
+/// Lloyd iteration), and the k-means and histogram stages scale with the
+/// cores; the river equities need 250 MB and the turn histograms about 1 GB
+/// at the default 16 bins.
+///
+/// File layout (version 1, host byte order, checked by an endian tag):
+///   Header               per street: offset, classes, buckets, byte width
+///   uint8 or uint16[]    bucket of each class, per abstracted street
+///
+/// Files are produced by the `generate_bucket_table` tool.
+class BucketTable {
+public:
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kNumStreets = 4;
+
+  /// Bucket of each class per street, or empty for a lossless street.
+  using Buckets = std::array<std::vector<uint16_t>, kNumStreets>;
+
+  /// Map a table file. Throws std::runtime_error if the file is missing,
+  /// truncated, or has the wrong magic, version, byte order or sizes.
+  [[nodiscard]] static BucketTable open(const std::string &path);
+
+  /// Write a table file. Each street's buckets are empty or one per class
+  /// of HandIndexer::forStreet(). Throws std::invalid_argument on a wrong
+  /// size, std::runtime_error on I/O failure.
+  static void write(const std::string &path, const Buckets &buckets);
+
+  BucketTable(BucketTable &&other) noexcept;
+  BucketTable &operator=(BucketTable &&other) noexcept;
+  BucketTable(const BucketTable &) = delete;
+  BucketTable &operator=(const BucketTable &) = delete;
+  ~BucketTable();
+
+  // --- Lookups (O(1)) ---
+
+  /// Bucket of hole cards on a board of the street's size (Preflop to
+  /// River; neither is validated).
+  [[nodiscard]] uint64_t bucket(core::Street street, core::CardSet hole,
+                                core::CardSet board) const noexcept {
+    const auto s = static_cast<size_t>(street);
+    const Section &section = sections_[s];
+    const uint64_t index = section.indexer->index(hole, board);
+    if (section.width == 1)
+      return section.data[index];
+    if (section.width == 2) {
+      uint16_t b;
+      std::memcpy(&b, section.data + 2 * index, sizeof(b));
+      return b;
+    }
+    return index;
+  }
+
+  /// Number of buckets on a street (its class count if lossless).
+  [[nodiscard]] uint64_t numBuckets(core::Street street) const;
+
+  /// bucket() as a function, e.g. for solver::MccfrConfig::cardBuckets.
+  /// The table must outlive it.
+  [[nodiscard]] std::function<uint64_t(core::Street, core::CardSet,
+                                       core::CardSet)>
+  bucketFn() const;
+
+  // --- Computation (used by the generator) ---
+
+  /// Equity on a five-card board of every hole pair (by
+  /// Range::comboIndex) against one random hand; 0 for pairs that touch
+  /// the board. Hands are ranked once and swept in strength order with
+  /// per-card counts for card removal, so this is O(n log n) in the pairs.
+  static void riverEquities(core::CardSet board,
+                            std::span<float, Range::kNumCombos> out);
+
+  /// riverEquities() of every river class, scaled to 0..65535.
+  [[nodiscard]] static std::vector<uint16_t>
+  riverEquityTable(ThreadPool &pool);
+
+  /// Cumulative equity histograms, `bins` per class, of every flop or turn
+  /// class over all of its runouts, read from riverEquityTable(). If
+  /// `means` is given it receives each class's average equity. Throws
+  /// std::invalid_argument for another street or no bins.
+  [[nodiscard]] static std::vector<float>
+  equityHistograms(core::Street street, std::span<const uint16_t> riverEquity,
+                   size_t bins, ThreadPool &pool,
+                   std::vector<float> *means = nullptr);
+
+  /// Cumulative histograms of flop equity over every flop for the preflop
+  /// classes, from the flop means of equityHistograms().
+  [[nodiscard]] static std::vector<float>
+  preflopHistograms(std::span<const float> flopMeans, size_t bins,
+                    ThreadPool &pool);
+
+  /// Run the whole pipeline: equities, histograms and k-means per street.
+  /// Throws std::invalid_argument for zero buckets or bins.
+  [[nodiscard]] static Buckets build(const BucketBuildOptions &options);
+
+private:
+  struct Section {
+    const HandIndexer *indexer = nullptr;
+    const uint8_t *data = nullptr;
+    uint64_t numBuckets = 0;
+    uint32_t width = 0; ///< Bytes per bucket; 0 = lossless.
+  };
+
+  BucketTable() = default;
+
+  MappedFile file_;
+  std::array<Section, kNumStreets> sections_{};
+};
+
+} // namespace poker::utils
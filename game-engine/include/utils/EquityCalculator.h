@@ -0,0 +1,134 @@
+#pragma once
+
+#include "core/CardSet.h"
+#include "utils/Range.h"
+#include "utils/ThreadPool.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+
+namespace poker::utils {
+
+/// @brief Cards known to the caller when equity is requested.
+struct EquityQuery {
+  /// One entry per player: 0–2 known hole cards (missing cards are random).
+  std::vector<core::CardSet> holeCards;
+  core::CardSet board; ///< 0–5 community cards.
+  core::CardSet dead;  ///< Cards known to be out of play (mucked, burned).
+};
+
+/// @brief Stopping rules and tuning for Monte Carlo sampling.
+/// Sampling stops at whichever enabled limit is reached first.
+struct EquityOptions {
+  uint64_t maxSamples = 100000;            ///< Sample budget (0 = none).
+  std::chrono::microseconds timeBudget{0}; ///< Wall-clock budget (0 = none).
+  /// Stop once every player's equity standard error is at or below this
+  /// (0 = off). This is the knob for "latency at fixed accuracy".
+  double targetStdError = 0.0;
+  uint64_t seed = 0;         ///< Base seed for the per-thread streams.
+  double confidenceZ = 1.96; ///< z-score for the reported interval.
+};
+
+/// @brief Outcome for one player.
+struct PlayerEquity {
+  double win = 0.0;      ///< Fraction of runouts won outright.
+  double tie = 0.0;      ///< Fraction of runouts ending in a split.
+  double equity = 0.0;   ///< Expected share of the pot.
+  double stdError = 0.0; ///< Standard error of `equity`.
+  double margin = 0.0;   ///< Confidence half-width: equity ± margin.
+};
+
+/// @brief Result of an equity calculation.
+struct EquityResult {
+  std::vector<PlayerEquity> players;
+  /// Runouts sampled, or (for enumeration) all runouts, counted with their
+  /// isomorphism weights.
+  uint64_t samples = 0;
+  /// Runouts actually scored; below `samples` when isomorphic runouts were
+  /// collapsed.
+  uint64_t evaluated = 0;
+  bool exact = false; ///< True for enumerated (zero-variance) results.
+  double elapsedSeconds = 0.0;
+};
+
+/// @brief Two weighted ranges facing off on a (possibly partial) board.
+struct RangeEquityQuery {
+  Range hero;
+  Range villain;
+  core::CardSet board; ///< 0–5 community cards.
+  core::CardSet dead;  ///< Cards known to be out of play.
+};
+
+/// @brief Board coverage for range-vs-range equity.
+struct RangeEquityOptions {
+  /// Evaluate every completion of the board when there are at most this
+  /// many, otherwise this many uniformly sampled ones (0 = always all).
+  uint64_t maxBoards = 0;
+  uint64_t seed = 0; ///< Seed for board sampling (0 = random).
+};
+
+/// @brief Hero's equity against the villain range.
+struct RangeEquityResult {
+  double win = 0.0;    ///< Weighted fraction of matchups won outright.
+  double tie = 0.0;    ///< Weighted fraction of matchups split.
+  double equity = 0.0; ///< Hero's expected pot share (villain: 1 - equity).
+  /// Per hero combo (indexed by Range::comboIndex); 0 for combos that are
+  /// out of range or fully blocked.
+  std::vector<double> comboEquity;
+  uint64_t boards = 0; ///< Board completions evaluated.
+  bool exact = false;  ///< True when every completion was evaluated.
+  double elapsedSeconds = 0.0;
+};
+
+/// @brief Computes all-in equity for N players, either by Monte Carlo
+/// sampling or by exhaustive enumeration of the remaining board.
+///
+/// Both modes run on a persistent thread pool; each worker owns its RNG
+/// stream and scratch buffers, so the inner loops perform no heap
+/// allocation. Runouts are scored in blocks through
+/// HandEvaluator::evaluateBatch.
+class EquityCalculator {
+public:
+  /// @param numThreads  Worker count (0 = all hardware threads).
+  explicit EquityCalculator(size_t numThreads = 0);
+
+  /// Estimate equities by sampling the unknown cards.
+  /// Throws std::invalid_argument on overlapping or impossible inputs.
+  [[nodiscard]] EquityResult calculate(const EquityQuery &query,
+                                       const EquityOptions &options = {});
+
+  /// Exact equity over every possible completion of the board. All hole
+  /// cards must be known (the usual case for an all-in).
+  ///
+  /// Suit permutations that leave every player's hand, the board and the
+  /// dead cards unchanged map runouts onto runouts of identical outcome;
+  /// only one runout per such class is evaluated, weighted by the class
+  /// size. Work is split across threads by the first card to come (the
+  /// turn, for a flop all-in) and tallied in integers, so the result is
+  /// bit-identical across runs and thread counts.
+  /// Throws std::invalid_argument on overlapping or missing cards.
+  [[nodiscard]] EquityResult enumerate(const EquityQuery &query);
+
+  /// Equity of one weighted range against another, with card removal
+  /// between the ranges, the board and the dead cards.
+  ///
+  /// Each board is handled in O(n log n) for n live combos: both ranges are
+  /// ranked once with a shared-board evaluateBatch and sorted by strength,
+  /// then a single sweep keeps running weight sums (total and per card) of
+  /// the weaker villain combos, so each hero combo's win / tie / blocked
+  /// weights come from a few subtractions instead of a pass over the
+  /// villain range. Boards are distributed over the thread pool.
+  /// Throws std::invalid_argument on an invalid board or empty ranges.
+  [[nodiscard]] RangeEquityResult
+  rangeEquity(const RangeEquityQuery &query,
+              const RangeEquityOptions &options = {});
+
+  [[nodiscard]] size_t numThreads() const noexcept { return pool_.size(); }
+
+private:
+  ThreadPool pool_;
+};
+
+} // namespace poker::utils
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/Card.h"
+#include "core/CardSet.h"
 
 #include <array>
 #include <compare>
@@ -44,20 +45,76 @@ struct HandResult {
   [[nodiscard]] static std::string rankName(HandRank r);
 };
 
+/// @brief Packed hand strength. Higher is better.
+///
+/// The top four bits hold the HandRank category and the low twelve bits the
+/// ordinal of the hand within that category, so two strengths compare exactly
+/// like the HandResults they encode.
+using HandStrength = uint16_t;
+
+/// Instruction-set kernels available to HandEvaluator::evaluateBatch.
+enum class EvalKernel : uint8_t { Scalar, SSE42, AVX2 };
+
 /// @brief Evaluates poker hands.
 ///
-/// Given up to 7 cards (2 hole + 5 community), finds the best
-/// 5-card hand by exhaustive C(7,5)=21 combination search.
-/// This is simple, correct, and fast enough for game-play purposes.
+/// Given 5 to 7 cards, the best 5-card hand is resolved with table lookups:
+/// a flush table indexed by the 13-bit rank mask of a suit holding five or
+/// more cards, and a perfect hash over the rank multiset for everything else.
+/// The exhaustive C(7,5)=21 combination search is kept as a reference path.
+///
+/// Build with POKER_VERIFY_EVALUATOR to have every table lookup cross-checked
+/// against the reference path (throws std::logic_error on disagreement).
 class HandEvaluator {
 public:
   /// Evaluate the best 5-card hand from a set of cards (5–7 cards).
   [[nodiscard]] static HandResult evaluate(std::span<const core::Card> cards);
 
+  /// Evaluate the best 5-card hand as a packed strength (5–7 cards).
+  [[nodiscard]] static HandStrength
+  evaluateStrength(std::span<const core::Card> cards);
+
+  /// Bitmask overloads: hole cards and board merge with a single OR.
+  [[nodiscard]] static HandResult evaluate(core::CardSet cards);
+  [[nodiscard]] static HandStrength evaluateStrength(core::CardSet cards);
+
+  /// Evaluate many hands in one call, writing one strength per hand.
+  /// Hands must hold 5–7 cards each and are not validated; `out` must be at
+  /// least as long as `hands`. The kernel defaults to the best one the CPU
+  /// supports, and every kernel matches evaluateStrength exactly.
+  static void evaluateBatch(std::span<const core::CardSet> hands,
+                            std::span<HandStrength> out,
+                            EvalKernel kernel = bestKernel());
+
+  /// As above, with a shared board OR-ed into every hand (e.g. one board
+  /// against many hole-card pairs).
+  static void evaluateBatch(core::CardSet board,
+                            std::span<const core::CardSet> hands,
+                            std::span<HandStrength> out,
+                            EvalKernel kernel = bestKernel());
+
+  /// Fastest kernel supported by the running CPU.
+  [[nodiscard]] static EvalKernel bestKernel() noexcept;
+  [[nodiscard]] static bool isKernelSupported(EvalKernel kernel) noexcept;
+  [[nodiscard]] static std::string kernelName(EvalKernel kernel);
+
+  /// Reference evaluation by exhaustive combination search over evaluate5.
+  [[nodiscard]] static HandResult
+  evaluateReference(std::span<const core::Card> cards);
+
   /// Compare two players' hands. Returns <0, 0, >0.
   [[nodiscard]] static int compare(std::span<const core::Card> hand1,
                                    std::span<const core::Card> hand2);
 
+  /// Convert between the packed and the descriptive representation.
+  [[nodiscard]] static HandResult toResult(HandStrength strength);
+  [[nodiscard]] static HandStrength toStrength(const HandResult &result);
+
+  /// Category of a packed strength.
+  [[nodiscard]] static constexpr HandRank
+  categoryOf(HandStrength strength) noexcept {
+    return static_cast<HandRank>(strength >> 12);
+  }
+
 private:
   /// Evaluate exactly 5 cards.
   [[nodiscard]] static HandResult
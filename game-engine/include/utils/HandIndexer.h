@@ -0,0 +1,80 @@
+#pragma once
+
+#include "core/BettingRound.h"
+#include "core/CardSet.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace poker::utils {
+
+/// @brief Perfect, minimal index of a street's hands up to suit isomorphism.
+///
+/// Relabelling the suits does not change how a hand plays (AsKs on Qs7h2d
+/// is AhKh on Qh7d2c), so a card abstraction needs one entry per class of
+/// such hands. index() maps hole cards and a board to 0..size()-1, equal
+/// for isomorphic hands and distinct otherwise, with a few table lookups
+/// and no search; unindex() goes back to the class's canonical hand.
+///
+/// The board is a set: which cards came on the flop and which on the turn
+/// is forgotten, as in imperfect-recall abstractions. The method is Waugh's
+/// ("A Fast and Optimal Hand Isomorphism Algorithm"): each suit's hole and
+/// board ranks are ranked with the combinatorial number system, the suits
+/// are sorted into a canonical order, and suits holding the same number of
+/// hole and board cards, being interchangeable, are ranked as a multiset.
+/// Sizes: preflop 169, flop 1,286,792, turn 13,960,050, river 123,156,254.
+class HandIndexer {
+public:
+  static constexpr size_t kHoleCards = 2;
+
+  /// Indexer for two hole cards and `boardCards` board cards.
+  /// Throws std::invalid_argument unless boardCards is 0, 3, 4 or 5.
+  explicit HandIndexer(size_t boardCards);
+
+  /// Shared indexer for a street (Preflop to River). Throws
+  /// std::invalid_argument for Showdown.
+  [[nodiscard]] static const HandIndexer &forStreet(core::Street street);
+
+  [[nodiscard]] size_t getBoardCards() const noexcept { return boardCards_; }
+  /// Number of classes.
+  [[nodiscard]] uint64_t size() const noexcept { return size_; }
+
+  /// Class of a hand. `hole` must hold two cards and `board`
+  /// getBoardCards() others; this is not validated.
+  [[nodiscard]] uint64_t index(core::CardSet hole,
+                               core::CardSet board) const noexcept;
+
+  /// The canonical hand of class `index`. Throws std::out_of_range if
+  /// index >= size().
+  void unindex(uint64_t index, core::CardSet &hole, core::CardSet &board) const;
+
+private:
+  /// Card counts of the four suits, sorted descending; each count is
+  /// hole * kShapeRadix + board.
+  using Shape = std::array<uint8_t, 4>;
+  static constexpr size_t kShapeRadix = 6;
+  /// Distinct descending shapes of four counts below 3 * kShapeRadix.
+  static constexpr size_t kNumShapes = 5985;
+  static constexpr uint16_t kNoConfiguration = 0xFFFF;
+
+  struct Configuration {
+    uint64_t offset = 0; ///< First index of hands with this shape.
+    Shape shape{};
+    /// At the first suit of each run of equal counts: the run's length
+    /// and its number of multisets (0 elsewhere).
+    std::array<uint8_t, 4> group{};
+    std::array<uint64_t, 4> radix{};
+  };
+
+  [[nodiscard]] static size_t shapeRank(const Shape &shape) noexcept;
+
+  size_t boardCards_;
+  uint64_t size_ = 0;
+  std::vector<Configuration> configurations_; ///< Ascending offset.
+  std::array<uint16_t, kNumShapes> configurationOf_;
+};
+
+} // namespace poker::utils
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "utils/ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace poker::utils {
+
+/// @brief Settings for one k-means run.
+struct KMeansOptions {
+  size_t clusters = 8;
+  size_t maxIterations = 50; ///< Lloyd iterations at most.
+  /// Points k-means++ picks the initial centres from; larger inputs are
+  /// sampled down to this many.
+  size_t seedSample = size_t{1} << 16;
+  uint64_t seed = 1;
+};
+
+/// @brief Centres and memberships found by KMeans::fit().
+struct KMeansResult {
+  std::vector<float> centers;       ///< clusters x dims, row-major.
+  std::vector<uint32_t> assignment; ///< Cluster of each point.
+  double inertia = 0.0;  ///< Weighted sum of squared distances to centres.
+  size_t iterations = 0; ///< Assignment passes run.
+};
+
+/// @brief Weighted k-means over dense float vectors, on a thread pool.
+///
+/// Centres are seeded with k-means++ on a sample of the points and refined
+/// with Lloyd's iterations until no point changes cluster. Both passes
+/// split the points into fixed blocks over the pool: the assignment pass
+/// per point, the update pass into per-block partial sums that are added
+/// up in block order, so results depend on the seed but not on the thread
+/// count. A cluster that empties is re-seeded with the point farthest from
+/// its centre.
+///
+/// Distance is squared Euclidean. On cumulative histograms it behaves like
+/// the earth mover's distance between the histograms, which is how the
+/// card abstraction uses it.
+class KMeans {
+public:
+  /// @param numThreads  Worker count (0 = all hardware threads).
+  explicit KMeans(size_t numThreads = 0);
+
+  /// Cluster `points`, n rows of `dims` floats. `weights` is empty (all
+  /// 1) or one non-negative weight per point. Throws std::invalid_argument
+  /// if dims is 0 or does not divide the points, the weights do not match,
+  /// or clusters is 0 or more than the points.
+  [[nodiscard]] KMeansResult fit(std::span<const float> points, size_t dims,
+                                 std::span<const float> weights,
+                                 const KMeansOptions &options);
+
+  [[nodiscard]] size_t numThreads() const noexcept { return pool_.size(); }
+
+private:
+  ThreadPool pool_;
+};
+
+} // namespace poker::utils
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace poker::utils {
+
+/// How a MappedFile will be read, passed on to the kernel as a hint.
+enum class MapAccess : uint8_t {
+  Normal,
+  Sequential, ///< Front to back, as when streaming records.
+  Random,     ///< Scattered lookups: the whole file is faulted in up front.
+};
+
+/// @brief A whole file mapped read-only and shared.
+///
+/// Every process on a host that opens the same file shares its page-cache
+/// pages. Where mmap is unavailable (Windows) the file is read into a
+/// private buffer instead. Move-only; the bytes stay valid until the
+/// MappedFile is destroyed or assigned to.
+class MappedFile {
+public:
+  MappedFile() = default;
+
+  /// Map `path`. Errors are std::runtime_error prefixed with `owner`
+  /// (e.g. "PreflopTable: cannot open <path>"). An empty file gives an
+  /// empty mapping.
+  [[nodiscard]] static MappedFile open(const std::string &path,
+                                       std::string_view owner,
+                                       MapAccess access = MapAccess::Normal);
+
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  [[nodiscard]] const std::byte *data() const noexcept { return data_; }
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+    return {data_, size_};
+  }
+
+private:
+  void release() noexcept;
+
+  const std::byte *data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<std::byte> buffer_; ///< Used where mmap is unavailable.
+};
+
+/// Write `path` through `fill`, which streams the contents. The bytes go to
+/// `path` + ".tmp" first, which then replaces `path` by rename, so
+/// processes that already mapped the old file keep a consistent view and
+/// nobody sees a partial file. Errors are std::runtime_error prefixed with
+/// `owner`, including a stream left failed by `fill`.
+void writeFileAtomically(const std::string &path, std::string_view owner,
+                         const std::function<void(std::ostream &)> &fill);
+
+} // namespace poker::utils
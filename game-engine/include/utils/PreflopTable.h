@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/CardSet.h"
+#include "utils/MappedFile.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace poker::utils {
+
+class EquityCalculator;
+
+/// @brief Read-only, memory-mapped table of precomputed preflop all-in
+/// equities.
+///
+/// Holds the full 169 x 169 heads-up matrix of starting-hand classes and a
+/// set of common 3-way spots. The file is mapped read-only and shared, so
+/// every process on a host that opens it shares the same page-cache pages;
+/// lookups read straight from the mapping.
+///
+/// File layout (version 1, host byte order, checked by an endian tag):
+///   Header
+///   float headsUp[169][169]   equity of row class against column class
+///   ThreeWayEntry[slots]      open-addressed hash of 3-way spots
+///
+/// Files are produced by the `generate_preflop_table` tool.
+class PreflopTable {
+public:
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kNumClasses = 169;
+
+  /// One precomputed 3-way spot (classes in any order).
+  struct ThreeWaySpot {
+    std::array<uint8_t, 3> classes;
+    std::array<float, 3> equity;
+  };
+
+  /// Map a table file. Throws std::runtime_error if the file is missing,
+  /// truncated, or has the wrong magic, version or byte order.
+  [[nodiscard]] static PreflopTable open(const std::string &path);
+
+  /// Write a table file. `headsUp` is row-major, kNumClasses^2 entries.
+  /// Throws std::invalid_argument on bad sizes, std::runtime_error on I/O
+  /// failure.
+  static void write(const std::string &path, std::span<const float> headsUp,
+                    std::span<const ThreeWaySpot> threeWay);
+
+  PreflopTable(PreflopTable &&other) noexcept;
+  PreflopTable &operator=(PreflopTable &&other) noexcept;
+  PreflopTable(const PreflopTable &) = delete;
+  PreflopTable &operator=(const PreflopTable &) = delete;
+  ~PreflopTable();
+
+  // --- Lookups (O(1)) ---
+
+  /// Equity of `hero` against `villain`, both class indices.
+  [[nodiscard]] float headsUp(size_t hero, size_t villain) const noexcept {
+    return headsUp_[hero * kNumClasses + villain];
+  }
+  /// Class-level equity for two concrete hands of two cards each.
+  [[nodiscard]] float headsUp(core::CardSet hero, core::CardSet villain) const;
+
+  /// Equities in argument order, or nullopt if the spot is not in the table.
+  [[nodiscard]] std::optional<std::array<float, 3>>
+  threeWay(size_t a, size_t b, size_t c) const noexcept;
+
+  [[nodiscard]] size_t numThreeWay() const noexcept { return numThreeWay_; }
+
+  // --- Starting-hand classes ---
+
+  /// Class index 0..168 on the usual 13 x 13 grid (Aces first): pairs on
+  /// the diagonal, suited hands above it, offsuit below.
+  [[nodiscard]] static size_t handClass(core::Card a, core::Card b);
+  /// As above for a two-card set. Throws std::invalid_argument otherwise.
+  [[nodiscard]] static size_t handClass(core::CardSet hand);
+  /// Class index from a name such as "AKs", "T9o" or "77".
+  /// Throws std::invalid_argument on malformed names.
+  [[nodiscard]] static size_t handClass(std::string_view name);
+  [[nodiscard]] static std::string className(size_t cls);
+  /// The 4, 6 or 12 two-card combos of a class.
+  [[nodiscard]] static std::vector<core::CardSet> combos(size_t cls);
+
+  // --- Computation (used by the generator) ---
+
+  /// Exact equity of one class against another, averaged uniformly over
+  /// their non-overlapping combos. Combo pairs that are suit-isomorphic are
+  /// enumerated once.
+  [[nodiscard]] static double computeHeadsUp(EquityCalculator &calc,
+                                             size_t hero, size_t villain);
+  /// Exact 3-way equities, averaged the same way.
+  [[nodiscard]] static std::array<double, 3>
+  computeThreeWay(EquityCalculator &calc, const std::array<size_t, 3> &classes);
+
+private:
+  PreflopTable() = default;
+
+  MappedFile file_;
+  const float *headsUp_ = nullptr;
+  const void *threeWay_ = nullptr;
+  uint32_t threeWaySlots_ = 0;
+  size_t numThreeWay_ = 0;
+};
+
+} // namespace poker::utils
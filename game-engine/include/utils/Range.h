@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/CardSet.h"
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+
+namespace poker::utils {
+
+/// @brief A weighted set of two-card starting hands.
+///
+/// Holds one weight per combo (1326 of them). Combo indices are ordered by
+/// the dense card indices of their two cards: for dense indices i < j the
+/// combo index is j*(j-1)/2 + i.
+class Range {
+public:
+  static constexpr size_t kNumCombos = 1326;
+
+  /// An empty range (every weight 0).
+  Range() = default;
+
+  /// Parse a comma-separated list such as "QQ+,AKs,T9s-65s,A5o:0.5".
+  ///
+  /// Accepted tokens: pairs ("77"), suited / offsuit / any ("AKs", "AKo",
+  /// "AK"), "+" suffixes ("QQ+", "A2s+"), dash ranges between classes
+  /// sharing a high card or a gap ("A5s-A2s", "T9s-65s", "22-55") and
+  /// specific combos ("AsKd"). An optional ":weight" suffix sets the weight
+  /// (default 1); later tokens overwrite earlier ones.
+  /// Throws std::invalid_argument on malformed input.
+  [[nodiscard]] static Range parse(std::string_view text);
+
+  /// Every combo with weight 1.
+  [[nodiscard]] static Range full();
+
+  // --- Combo indexing ---
+
+  /// Order-insensitive combo index. Throws std::invalid_argument if a == b.
+  [[nodiscard]] static size_t comboIndex(core::Card a, core::Card b);
+  [[nodiscard]] static core::CardSet comboCards(size_t index);
+
+  // --- Weights ---
+  [[nodiscard]] double weight(size_t index) const { return weights_[index]; }
+  void setWeight(size_t index, double w) { weights_[index] = w; }
+  [[nodiscard]] std::span<const double, kNumCombos> weights() const noexcept {
+    return weights_;
+  }
+
+  /// Number of combos with non-zero weight.
+  [[nodiscard]] size_t size() const noexcept;
+  /// Sum of all weights.
+  [[nodiscard]] double totalWeight() const noexcept;
+
+  /// Copy with every combo touching `dead` removed (card removal).
+  [[nodiscard]] Range without(core::CardSet dead) const;
+
+private:
+  std::array<double, kNumCombos> weights_ = {};
+};
+
+} // namespace poker::utils
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace poker::utils {
+
+/// @brief Persistent fork/join pool for latency-sensitive parallel work.
+///
+/// Workers are started once and parked between calls, so a parallel region
+/// costs a wake-up rather than a thread creation. The calling thread takes
+/// part as worker 0.
+class ThreadPool {
+public:
+  /// @param numThreads  Total workers including the caller
+  ///                    (0 = std::thread::hardware_concurrency()).
+  explicit ThreadPool(size_t numThreads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// Number of workers, including the calling thread.
+  [[nodiscard]] size_t size() const noexcept { return workers_.size() + 1; }
+
+  /// Run fn(workerIndex) once on every worker and wait for all of them.
+  /// The first exception thrown by any worker is rethrown here.
+  void runOnAll(const std::function<void(size_t)> &fn);
+
+  /// Run fn(index, workerIndex) for every index in [0, count) and wait.
+  /// Each worker starts on its own contiguous slice; a worker that runs out
+  /// steals the back half of the largest remaining slice, so uneven item
+  /// costs still keep every worker busy. Exceptions as for runOnAll().
+  void parallelFor(size_t count,
+                   const std::function<void(size_t, size_t)> &fn);
+
+private:
+  void workerLoop(size_t index);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(size_t)> *job_ = nullptr;
+  uint64_t generation_ = 0;
+  size_t pending_ = 0;
+  bool stopping_ = false;
+  std::exception_ptr error_;
+};
+
+} // namespace poker::utils
@@ -0,0 +1,174 @@
+#include "engine/ActionAbstraction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace poker::engine {
+
+namespace {
+
+/// Whether an action puts in more than a call, i.e. is a bet to translate.
+bool isBet(const core::Action &a, int64_t toCall) noexcept {
+  return a.type == core::ActionType::Bet ||
+         a.type == core::ActionType::Raise ||
+         (a.type == core::ActionType::AllIn && a.amount > toCall);
+}
+
+/// Chips to call, read off a legal (or abstract) list: its Call, else 0
+/// if it can check, else everything (calling would be all-in).
+int64_t callAmount(std::span<const core::Action> legal) noexcept {
+  for (const auto &a : legal) {
+    if (a.type == core::ActionType::Call)
+      return a.amount;
+    if (a.type == core::ActionType::Check)
+      return 0;
+  }
+  return INT64_MAX;
+}
+
+} // anonymous namespace
+
+void ActionAbstraction::setSizes(core::Street street, size_t raiseCount,
+                                 std::vector<double> potFractions) {
+  const auto s = static_cast<size_t>(street);
+  if (s >= kNumStreets) {
+    throw std::invalid_argument("ActionAbstraction: no betting on showdown");
+  }
+  for (double f : potFractions) {
+    if (!std::isfinite(f) || f <= 0.0) {
+      throw std::invalid_argument(
+          "ActionAbstraction: pot fractions must be positive and finite");
+    }
+  }
+  std::sort(potFractions.begin(), potFractions.end());
+  potFractions.erase(std::unique(potFractions.begin(), potFractions.end()),
+                     potFractions.end());
+  auto &rows = sizes_[s];
+  if (rows.size() <= raiseCount)
+    rows.resize(raiseCount + 1);
+  rows[raiseCount] = std::move(potFractions);
+}
+
+std::span<const double> ActionAbstraction::getSizes(core::Street street,
+                                                    size_t raiseCount) const {
+  const auto s = static_cast<size_t>(street);
+  if (s >= kNumStreets || sizes_[s].empty())
+    return {};
+  const auto &rows = sizes_[s];
+  return rows[std::min(raiseCount, rows.size() - 1)];
+}
+
+size_t ActionAbstraction::getMaxSizes() const noexcept {
+  size_t most = 0;
+  for (const auto &rows : sizes_) {
+    for (const auto &row : rows)
+      most = std::max(most, row.size());
+  }
+  return most;
+}
+
+void ActionAbstraction::expand(const core::GameState &state,
+                               std::span<const core::Action> legal,
+                               size_t raiseCount,
+                               std::vector<core::Action> &out) const {
+  out.clear();
+  const core::Action *bet = nullptr;
+  const core::Action *allIn = nullptr;
+  int64_t toCall = 0;
+  for (const auto &a : legal) {
+    switch (a.type) {
+    case core::ActionType::Fold:
+    case core::ActionType::Check:
+      out.push_back(a);
+      break;
+    case core::ActionType::Call:
+      out.push_back(a);
+      toCall = a.amount;
+      break;
+    case core::ActionType::Bet:
+    case core::ActionType::Raise:
+      bet = &a;
+      break;
+    case core::ActionType::AllIn:
+      allIn = &a;
+      break;
+    }
+  }
+
+  if (bet) {
+    const int64_t stack = state.getPlayer(bet->playerId).getChips();
+    const double base =
+        static_cast<double>(state.getPot().getTotal() + toCall);
+    for (double f : getSizes(state.getStreet(), raiseCount)) {
+      // Clamp to the minimum raise; from the stack up it is the all-in.
+      const int64_t chips =
+          std::max<int64_t>(toCall + std::llround(f * base), bet->amount);
+      if (chips >= stack)
+        break;
+      if (out.back().type == bet->type && out.back().amount == chips)
+        continue;
+      out.emplace_back(bet->type, chips, bet->playerId);
+    }
+  }
+  if (allIn)
+    out.push_back(*allIn);
+}
+
+void ActionAbstraction::expand(GameTreeCursor &cursor,
+                               std::vector<core::Action> &out) const {
+  expand(cursor.getState(), cursor.getLegalActions(),
+         cursor.getRound().getNumRaises(), out);
+}
+
+ActionAbstraction::Translation
+ActionAbstraction::translate(const core::GameState &state,
+                             std::span<const core::Action> abstract,
+                             const core::Action &action) {
+  const int64_t toCall = callAmount(abstract);
+  if (!isBet(action, toCall)) {
+    for (size_t i = 0; i < abstract.size(); ++i) {
+      if (abstract[i].type == action.type)
+        return {i, i, 1.0};
+    }
+    throw std::invalid_argument("ActionAbstraction::translate: no abstract "
+                                "action of this kind");
+  }
+
+  // Bets come last in expand()'s output, ascending by amount.
+  size_t first = 0;
+  while (first < abstract.size() && !isBet(abstract[first], toCall))
+    ++first;
+  if (first == abstract.size()) {
+    throw std::invalid_argument("ActionAbstraction::translate: no abstract "
+                                "bet to map a bet to");
+  }
+  const auto bets = abstract.subspan(first);
+  const auto it = std::lower_bound(
+      bets.begin(), bets.end(), action.amount,
+      [](const core::Action &a, int64_t amount) { return a.amount < amount; });
+  const size_t upper = first + static_cast<size_t>(it - bets.begin());
+  if (it == bets.begin() || (it != bets.end() && it->amount == action.amount))
+    return {upper, upper, 1.0};
+  if (it == bets.end())
+    return {abstract.size() - 1, abstract.size() - 1, 1.0};
+
+  const size_t lower = upper - 1;
+  const double base = static_cast<double>(state.getPot().getTotal() + toCall);
+  auto fraction = [&](int64_t chips) {
+    return static_cast<double>(chips - toCall) / base;
+  };
+  return {lower, upper,
+          pseudoHarmonic(fraction(abstract[lower].amount),
+                         fraction(abstract[upper].amount),
+                         fraction(action.amount))};
+}
+
+double ActionAbstraction::pseudoHarmonic(double a, double b,
+                                         double x) noexcept {
+  if (b <= a)
+    return 1.0;
+  return std::clamp((b - x) * (1.0 + a) / ((b - a) * (1.0 + x)), 0.0, 1.0);
+}
+
+} // namespace poker::engine
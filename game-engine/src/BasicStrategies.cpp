@@ -0,0 +1,55 @@
+#include "sim/BasicStrategies.h"
+
+namespace poker::sim {
+
+namespace {
+
+const core::Action *find(const std::vector<core::Action> &legal,
+                         core::ActionType type) {
+  for (const auto &a : legal) {
+    if (a.type == type)
+      return &a;
+  }
+  return nullptr;
+}
+
+core::Action checkOrCall(const std::vector<core::Action> &legal) {
+  if (const auto *a = find(legal, core::ActionType::Check))
+    return *a;
+  if (const auto *a = find(legal, core::ActionType::Call))
+    return *a;
+  if (const auto *a = find(legal, core::ActionType::AllIn))
+    return *a;
+  return legal.front();
+}
+
+} // anonymous namespace
+
+core::Action CallingStrategy::getAction(const core::GameState &,
+                                        const std::vector<core::Action> &legal) {
+  return checkOrCall(legal);
+}
+
+core::Action
+AggressiveStrategy::getAction(const core::GameState &,
+                              const std::vector<core::Action> &legal) {
+  if (const auto *a = find(legal, core::ActionType::Raise))
+    return *a;
+  if (const auto *a = find(legal, core::ActionType::Bet))
+    return *a;
+  return checkOrCall(legal);
+}
+
+core::Action RandomStrategy::getAction(const core::GameState &,
+                                       const std::vector<core::Action> &legal) {
+  // Fold is always listed first; skip it when checking is free.
+  const size_t first =
+      legal.size() > 1 && legal.front().type == core::ActionType::Fold &&
+              find(legal, core::ActionType::Check)
+          ? 1
+          : 0;
+  std::uniform_int_distribution<size_t> pick(first, legal.size() - 1);
+  return legal[pick(rng_)];
+}
+
+} // namespace poker::sim
@@ -0,0 +1,92 @@
+#include "engine/BatchScheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace poker::engine {
+
+BatchScheduler::BatchScheduler(
+    std::shared_ptr<interfaces::IBatchActionProvider> provider,
+    BatchSchedulerConfig config)
+    : provider_(std::move(provider)), config_(config) {
+  if (!provider_)
+    throw std::invalid_argument("BatchScheduler: provider cannot be null");
+  if (config_.maxBatch == 0)
+    throw std::invalid_argument("BatchScheduler: maxBatch must be positive");
+}
+
+size_t BatchScheduler::addTable(
+    std::shared_ptr<interfaces::IRandomGenerator> rng, core::GameState &state) {
+  tables_.push_back(std::make_unique<Table>(
+      Table{HeadlessPokerEngine(std::move(rng)), &state}));
+  return tables_.size() - 1;
+}
+
+void BatchScheduler::run(const HandCompleteFn &onHandComplete) {
+  runnable_.clear();
+  parked_.clear();
+  const size_t batch = std::min(config_.maxBatch, tables_.size());
+  parked_.reserve(batch);
+  actions_.reserve(batch);
+  for (size_t t = 0; t < tables_.size(); ++t) {
+    tables_[t]->engine.startHand(*tables_[t]->state);
+    runnable_.push_back(t);
+  }
+
+  while (true) {
+    std::swap(runnable_, stepping_);
+    runnable_.clear();
+    for (size_t t : stepping_) {
+      step(t, onHandComplete);
+      if (parked_.size() >= config_.maxBatch) {
+        flush();
+      } else if (!parked_.empty() && std::chrono::steady_clock::now() -
+                                             oldestParked_ >=
+                                         config_.maxWait) {
+        ++stats_.deadlineFlushes;
+        flush();
+      }
+    }
+    if (runnable_.empty()) {
+      if (parked_.empty())
+        break;
+      // Every live table is waiting on the provider.
+      flush();
+    }
+  }
+}
+
+void BatchScheduler::step(size_t table, const HandCompleteFn &onHandComplete) {
+  Table &t = *tables_[table];
+  while (true) {
+    if (t.engine.advance() == StepStatus::AwaitingAction) {
+      const PendingDecision decision = *t.engine.pendingDecision();
+      if (parked_.empty())
+        oldestParked_ = std::chrono::steady_clock::now();
+      parked_.push_back({table, decision.playerId, t.state,
+                         decision.legalActions});
+      return;
+    }
+    ++stats_.hands;
+    if (!onHandComplete(table, *t.state))
+      return;
+    t.engine.startHand(*t.state);
+  }
+}
+
+void BatchScheduler::flush() {
+  actions_.resize(parked_.size());
+  provider_->getActions(parked_, actions_);
+  for (size_t i = 0; i < parked_.size(); ++i) {
+    const size_t table = parked_[i].table;
+    tables_[table]->engine.submit(actions_[i]);
+    runnable_.push_back(table);
+  }
+  ++stats_.batches;
+  stats_.decisions += parked_.size();
+  stats_.largestBatch = std::max(stats_.largestBatch, parked_.size());
+  parked_.clear();
+}
+
+} // namespace poker::engine
@@ -1,30 +1,63 @@
 #include "core/BettingRound.h"
 
+#include <stdexcept>
+
 namespace poker::core {
 
 BettingRound::BettingRound(size_t numPlayers, size_t firstToAct,
-                           int64_t existingBet)
-    : numPlayers_(numPlayers), currentIndex_(firstToAct),
-      currentBet_(existingBet), lastAggressor_(firstToAct),
-      playersToAct_(numPlayers) {}
+                           SeatMask canAct, int64_t currentBet,
+                           int64_t minRaiseSize)
+    : active_(canAct), pending_(canAct), raiseOpen_(canAct),
+      currentIndex_(firstToAct), currentBet_(currentBet),
+      lastRaiseSize_(minRaiseSize), lastAggressor_(firstToAct) {
+  if (numPlayers > kMaxSeats || firstToAct >= numPlayers) {
+    throw std::invalid_argument("BettingRound: bad table size or first seat");
+  }
+  if (numPlayers < kMaxSeats) {
+    active_ &= seatBit(numPlayers) - 1;
+    pending_ = active_;
+  }
+  if (pending_ != 0 && !needsToAct(firstToAct)) {
+    // Start from the first seat at or after firstToAct.
+    const SeatMask from = pending_ & ~(seatBit(firstToAct) - 1);
+    currentIndex_ =
+        static_cast<size_t>(std::countr_zero(from ? from : pending_));
+  }
+}
 
-void BettingRound::playerActed(int64_t newBet) {
+void BettingRound::playerActed(int64_t newBet, bool canActAgain) {
+  const SeatMask self = seatBit(currentIndex_);
   ++actionsThisRound_;
+  if (!canActAgain)
+    active_ &= ~self;
+  actedSinceRaise_ |= self;
   if (newBet > currentBet_) {
+    const int64_t raise = newBet - currentBet_;
     currentBet_ = newBet;
     ++numRaises_;
     lastAggressor_ = currentIndex_;
-    // Everyone else needs to act again.
-    playersToAct_ = numPlayers_ - 1; // minus current player
-  } else {
-    if (playersToAct_ > 0) {
-      --playersToAct_;
+    if (raise >= lastRaiseSize_) {
+      // A full raise reopens raising to everyone.
+      lastRaiseSize_ = raise;
+      actedSinceRaise_ = self;
+      raiseOpen_ = active_;
+    } else {
+      // A short all-in does not reopen it to seats that already acted.
+      raiseOpen_ &= ~actedSinceRaise_;
     }
+    // Everyone else who can still act owes a response.
+    pending_ = active_ & ~self;
+  } else {
+    pending_ &= ~self;
   }
+  advance();
 }
 
-bool BettingRound::isComplete() const noexcept {
-  return actionsThisRound_ > 0 && playersToAct_ == 0;
+void BettingRound::skipCurrent() noexcept {
+  const SeatMask self = seatBit(currentIndex_);
+  active_ &= ~self;
+  pending_ &= ~self;
+  advance();
 }
 
 } // namespace poker::core
@@ -0,0 +1,527 @@
+#include "utils/BucketTable.h"
+#include "utils/HandEvaluator.h"
+#include "utils/KMeans.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace poker::utils {
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'K', 'R', 'B', 'U', 'C', 'K', 'T'};
+constexpr uint32_t kEndianTag = 0x01020304;
+constexpr size_t kNumStreets = BucketTable::kNumStreets;
+/// Sections start on cache-line boundaries after the padded header.
+constexpr uint64_t kAlignment = 64;
+constexpr uint64_t kDataOffset = 192;
+
+struct SectionHeader {
+  uint64_t offset;  ///< 0 for a lossless street.
+  uint64_t classes; ///< HandIndexer::forStreet().size(), or 0.
+  uint32_t numBuckets;
+  uint32_t width; ///< Bytes per bucket: 1, 2, or 0 for lossless.
+};
+
+struct Header {
+  char magic[8];
+  uint32_t endianTag;
+  uint32_t version;
+  uint32_t numStreets;
+  uint32_t reserved;
+  SectionHeader sections[kNumStreets];
+  uint64_t fileSize;
+};
+static_assert(sizeof(Header) <= kDataOffset);
+
+/// Opponent hands on a river once both players' cards are out: C(45, 2).
+constexpr double kRiverOpponents = 990.0;
+/// Classes per unit of parallel work when building features.
+constexpr size_t kClassBlock = 1024;
+
+/// A board is canonical if no suit relabelling gives a smaller bit set.
+/// Every (hole, board) class has a member on a canonical board.
+bool isCanonicalBoard(core::CardSet board) {
+  std::array<uint8_t, 4> perm = {0, 1, 2, 3};
+  while (std::next_permutation(perm.begin(), perm.end())) {
+    if (board.permuteSuits(perm).bits() < board.bits())
+      return false;
+  }
+  return true;
+}
+
+/// Positions of the two cards of a hole pair's bit set.
+inline std::pair<unsigned, unsigned> cardsOf(uint64_t bits) noexcept {
+  // Both bits are set, so neither count reaches 64; the masks say so.
+  return {static_cast<unsigned>(std::countr_zero(bits)) & 63u,
+          static_cast<unsigned>(63 - std::countl_zero(bits)) & 63u};
+}
+
+/// Histogram bin of a scaled equity (0..65535).
+inline size_t binOf(uint32_t equity, size_t bins) noexcept {
+  return static_cast<size_t>(equity) * bins >> 16;
+}
+
+/// Turn counts into cumulative fractions.
+void accumulate(float *histogram, size_t bins, double samples) noexcept {
+  double running = 0.0;
+  for (size_t j = 0; j < bins; ++j) {
+    running += histogram[j];
+    histogram[j] = static_cast<float>(running / samples);
+  }
+}
+
+/// Relabel clusters so bucket 0 is the weakest; `strength` scores a
+/// centre.
+template <typename Strength>
+std::vector<uint16_t> relabel(const KMeansResult &result, size_t dims,
+                              Strength strength) {
+  const size_t k = result.centers.size() / dims;
+  std::vector<uint32_t> order(k);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return strength(&result.centers[a * dims]) <
+           strength(&result.centers[b * dims]);
+  });
+  std::vector<uint16_t> label(k);
+  for (size_t rank = 0; rank < k; ++rank)
+    label[order[rank]] = static_cast<uint16_t>(rank);
+  std::vector<uint16_t> out(result.assignment.size());
+  for (size_t i = 0; i < out.size(); ++i)
+    out[i] = label[result.assignment[i]];
+  return out;
+}
+
+/// Bucket each class by its cumulative histogram; empty if lossless.
+std::vector<uint16_t> clusterHistograms(KMeans &kmeans,
+                                        std::span<const float> features,
+                                        size_t bins, size_t clusters,
+                                        const BucketBuildOptions &options,
+                                        size_t street) {
+  const size_t n = features.size() / bins;
+  if (clusters >= n)
+    return {};
+  KMeansOptions kOptions;
+  kOptions.clusters = clusters;
+  kOptions.maxIterations = options.iterations;
+  kOptions.seed = options.seed + street;
+  const auto result = kmeans.fit(features, bins, {}, kOptions);
+  // A lower cumulative histogram has its mass at higher equity.
+  return relabel(result, bins, [bins](const float *cdf) {
+    return -std::accumulate(cdf, cdf + bins, 0.0);
+  });
+}
+
+/// Bucket river classes by equity: k-means on the distinct scaled values,
+/// weighted by how many classes have each.
+std::vector<uint16_t> clusterRiver(KMeans &kmeans,
+                                   std::span<const uint16_t> equity,
+                                   size_t clusters,
+                                   const BucketBuildOptions &options) {
+  if (clusters >= equity.size())
+    return {};
+  std::vector<uint64_t> counts(65536);
+  for (uint16_t e : equity)
+    ++counts[e];
+  std::vector<float> values, weights;
+  std::vector<uint32_t> point(counts.size());
+  for (size_t v = 0; v < counts.size(); ++v) {
+    if (counts[v] == 0)
+      continue;
+    point[v] = static_cast<uint32_t>(values.size());
+    values.push_back(static_cast<float>(v) / 65535.0f);
+    weights.push_back(static_cast<float>(counts[v]));
+  }
+  KMeansOptions kOptions;
+  kOptions.clusters = std::min(clusters, values.size());
+  kOptions.maxIterations = options.iterations;
+  kOptions.seed = options.seed + 3;
+  const auto result = kmeans.fit(values, 1, weights, kOptions);
+  const auto byValue =
+      relabel(result, 1, [](const float *centre) { return *centre; });
+  std::vector<uint16_t> out(equity.size());
+  for (size_t i = 0; i < out.size(); ++i)
+    out[i] = byValue[point[equity[i]]];
+  return out;
+}
+
+} // anonymous namespace
+
+// --- Loading ---
+
+BucketTable BucketTable::open(const std::string &path) {
+  BucketTable table;
+  // Lookups are random, so the whole table is faulted in up front.
+  table.file_ = MappedFile::open(path, "BucketTable", MapAccess::Random);
+  const std::byte *data = table.file_.data();
+  const size_t size = table.file_.size();
+
+  Header header;
+  if (size < sizeof(Header)) {
+    throw std::runtime_error("BucketTable: truncated file " + path);
+  }
+  std::memcpy(&header, data, sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("BucketTable: not a bucket table: " + path);
+  }
+  if (header.endianTag != kEndianTag) {
+    throw std::runtime_error("BucketTable: byte order mismatch: " + path);
+  }
+  if (header.version != kVersion) {
+    throw std::runtime_error("BucketTable: unsupported version " +
+                             std::to_string(header.version));
+  }
+  if (header.numStreets != kNumStreets || header.fileSize != size) {
+    throw std::runtime_error("BucketTable: corrupt file " + path);
+  }
+  for (size_t s = 0; s < kNumStreets; ++s) {
+    const SectionHeader &sh = header.sections[s];
+    Section &section = table.sections_[s];
+    section.indexer = &HandIndexer::forStreet(static_cast<core::Street>(s));
+    if (sh.width == 0)
+      continue;
+    if ((sh.width != 1 && sh.width != 2) ||
+        sh.classes != section.indexer->size() || sh.numBuckets == 0 ||
+        sh.offset % kAlignment != 0 || sh.offset < kDataOffset ||
+        sh.offset > size || sh.classes * sh.width > size - sh.offset) {
+      throw std::runtime_error("BucketTable: corrupt file " + path);
+    }
+    section.data = reinterpret_cast<const uint8_t *>(data + sh.offset);
+    section.numBuckets = sh.numBuckets;
+    section.width = sh.width;
+  }
+  return table;
+}
+
+BucketTable::BucketTable(BucketTable &&other) noexcept {
+  *this = std::move(other);
+}
+
+BucketTable &BucketTable::operator=(BucketTable &&other) noexcept {
+  if (this != &other) {
+    file_ = std::move(other.file_);
+    sections_ = std::exchange(other.sections_, {});
+  }
+  return *this;
+}
+
+BucketTable::~BucketTable() = default;
+
+// --- Writing ---
+
+void BucketTable::write(const std::string &path, const Buckets &buckets) {
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.endianTag = kEndianTag;
+  header.version = kVersion;
+  header.numStreets = kNumStreets;
+  uint64_t end = kDataOffset;
+  for (size_t s = 0; s < kNumStreets; ++s) {
+    const auto &street = buckets[s];
+    if (street.empty())
+      continue;
+    const uint64_t classes =
+        HandIndexer::forStreet(static_cast<core::Street>(s)).size();
+    if (street.size() != classes) {
+      throw std::invalid_argument("BucketTable: street " + std::to_string(s) +
+                                  " needs one bucket per class (" +
+                                  std::to_string(classes) + ")");
+    }
+    SectionHeader &sh = header.sections[s];
+    sh.numBuckets = *std::max_element(street.begin(), street.end()) + 1u;
+    sh.width = sh.numBuckets <= 256 ? 1 : 2;
+    sh.classes = classes;
+    sh.offset = (end + kAlignment - 1) / kAlignment * kAlignment;
+    end = sh.offset + classes * sh.width;
+  }
+  header.fileSize = end;
+
+  writeFileAtomically(path, "BucketTable", [&](std::ostream &out) {
+    std::array<char, kDataOffset> head = {};
+    std::memcpy(head.data(), &header, sizeof(Header));
+    out.write(head.data(), head.size());
+    uint64_t written = kDataOffset;
+    std::vector<uint8_t> narrow;
+    for (size_t s = 0; s < kNumStreets; ++s) {
+      const SectionHeader &sh = header.sections[s];
+      if (sh.width == 0)
+        continue;
+      const std::array<char, kAlignment> pad = {};
+      out.write(pad.data(), static_cast<std::streamsize>(sh.offset - written));
+      if (sh.width == 2) {
+        out.write(reinterpret_cast<const char *>(buckets[s].data()),
+                  static_cast<std::streamsize>(sh.classes * 2));
+      } else {
+        narrow.assign(buckets[s].begin(), buckets[s].end());
+        out.write(reinterpret_cast<const char *>(narrow.data()),
+                  static_cast<std::streamsize>(narrow.size()));
+      }
+      written = sh.offset + sh.classes * sh.width;
+    }
+  });
+}
+
+// --- Lookups ---
+
+uint64_t BucketTable::numBuckets(core::Street street) const {
+  const auto s = static_cast<size_t>(street);
+  if (s >= kNumStreets) {
+    throw std::invalid_argument("BucketTable: no buckets at showdown");
+  }
+  return sections_[s].width ? sections_[s].numBuckets
+                            : sections_[s].indexer->size();
+}
+
+std::function<uint64_t(core::Street, core::CardSet, core::CardSet)>
+BucketTable::bucketFn() const {
+  return [this](core::Street street, core::CardSet hole, core::CardSet board) {
+    return bucket(street, hole, board);
+  };
+}
+
+// --- Computation ---
+
+void BucketTable::riverEquities(core::CardSet board,
+                                std::span<float, Range::kNumCombos> out) {
+  if (board.size() != 5) {
+    throw std::invalid_argument("BucketTable: river boards have 5 cards");
+  }
+  std::array<core::CardSet, Range::kNumCombos> holes;
+  std::array<uint16_t, Range::kNumCombos> combo;
+  size_t n = 0;
+  for (size_t c = 0; c < Range::kNumCombos; ++c) {
+    out[c] = 0.0f;
+    const core::CardSet hole = Range::comboCards(c);
+    if (hole.intersects(board))
+      continue;
+    holes[n] = hole;
+    combo[n++] = static_cast<uint16_t>(c);
+  }
+  std::array<HandStrength, Range::kNumCombos> strength;
+  HandEvaluator::evaluateBatch(board, std::span(holes.data(), n),
+                               std::span(strength.data(), n));
+  std::array<uint16_t, Range::kNumCombos> order;
+  std::iota(order.begin(), order.begin() + n, 0);
+  std::sort(order.begin(), order.begin() + n, [&](uint16_t a, uint16_t b) {
+    return strength[a] < strength[b];
+  });
+
+  // Sweep weakest first. Opponents sharing a card with the hand are
+  // subtracted through per-card counts; only the hand itself shares both.
+  std::array<uint32_t, 64> weakerWith{};
+  std::array<uint32_t, 64> tiedWith{};
+  uint32_t weaker = 0;
+  for (size_t i = 0; i < n;) {
+    size_t j = i;
+    while (j < n && strength[order[j]] == strength[order[i]])
+      ++j;
+    for (size_t t = i; t < j; ++t) {
+      const auto [lo, hi] = cardsOf(holes[order[t]].bits());
+      ++tiedWith[lo];
+      ++tiedWith[hi];
+    }
+    const auto tied = static_cast<uint32_t>(j - i);
+    for (size_t t = i; t < j; ++t) {
+      const auto [lo, hi] = cardsOf(holes[order[t]].bits());
+      const uint32_t wins = weaker - weakerWith[lo] - weakerWith[hi];
+      const uint32_t ties = tied - tiedWith[lo] - tiedWith[hi] + 1;
+      out[combo[order[t]]] =
+          static_cast<float>((wins + 0.5 * ties) / kRiverOpponents);
+    }
+    for (size_t t = i; t < j; ++t) {
+      const auto [lo, hi] = cardsOf(holes[order[t]].bits());
+      weakerWith[lo] += 1;
+      weakerWith[hi] += 1;
+      tiedWith[lo] = 0;
+      tiedWith[hi] = 0;
+    }
+    weaker += tied;
+    i = j;
+  }
+}
+
+std::vector<uint16_t> BucketTable::riverEquityTable(ThreadPool &pool) {
+  const HandIndexer &river = HandIndexer::forStreet(core::Street::River);
+  std::vector<core::CardSet> boards;
+  const std::vector<core::Card> deck(core::CardSet::fullDeck().begin(),
+                                     core::CardSet::fullDeck().end());
+  std::array<size_t, 5> pick = {0, 1, 2, 3, 4};
+  while (true) {
+    core::CardSet board;
+    for (size_t p : pick)
+      board.insert(deck[p]);
+    if (isCanonicalBoard(board))
+      boards.push_back(board);
+    size_t i = 5;
+    while (i > 0 && pick[i - 1] == deck.size() - 5 + (i - 1))
+      --i;
+    if (i == 0)
+      break;
+    ++pick[i - 1];
+    for (size_t k = i; k < 5; ++k)
+      pick[k] = pick[k - 1] + 1;
+  }
+
+  // Isomorphic pairs on a board write the same value, so the stores can
+  // race harmlessly; atomic_ref keeps them well defined.
+  std::vector<uint16_t> table(river.size());
+  pool.parallelFor(boards.size(), [&](size_t b, size_t) {
+    std::array<float, Range::kNumCombos> equity;
+    riverEquities(boards[b], equity);
+    for (size_t c = 0; c < Range::kNumCombos; ++c) {
+      const core::CardSet hole = Range::comboCards(c);
+      if (hole.intersects(boards[b]))
+        continue;
+      const auto scaled =
+          static_cast<uint16_t>(std::lround(equity[c] * 65535.0f));
+      std::atomic_ref<uint16_t>(table[river.index(hole, boards[b])])
+          .store(scaled, std::memory_order_relaxed);
+    }
+  });
+  return table;
+}
+
+std::vector<float>
+BucketTable::equityHistograms(core::Street street,
+                              std::span<const uint16_t> riverEquity,
+                              size_t bins, ThreadPool &pool,
+                              std::vector<float> *means) {
+  if (street != core::Street::Flop && street != core::Street::Turn) {
+    throw std::invalid_argument(
+        "BucketTable: equity histograms are for the flop and turn");
+  }
+  if (bins == 0) {
+    throw std::invalid_argument("BucketTable: histograms need bins");
+  }
+  const HandIndexer &indexer = HandIndexer::forStreet(street);
+  const HandIndexer &river = HandIndexer::forStreet(core::Street::River);
+  if (riverEquity.size() != river.size()) {
+    throw std::invalid_argument("BucketTable: river equity table size");
+  }
+  const uint64_t n = indexer.size();
+  std::vector<float> features(n * bins);
+  if (means)
+    means->assign(n, 0.0f);
+
+  const size_t blocks = (n + kClassBlock - 1) / kClassBlock;
+  pool.parallelFor(blocks, [&](size_t block, size_t) {
+    const uint64_t end = std::min<uint64_t>(n, (block + 1) * kClassBlock);
+    for (uint64_t i = block * kClassBlock; i < end; ++i) {
+      core::CardSet hole, board;
+      indexer.unindex(i, hole, board);
+      float *histogram = features.data() + i * bins;
+      uint64_t sum = 0, samples = 0;
+      auto add = [&](uint64_t runout) {
+        const uint16_t e =
+            riverEquity[river.index(hole, board | core::CardSet(runout))];
+        histogram[binOf(e, bins)] += 1.0f;
+        sum += e;
+        ++samples;
+      };
+      uint64_t live = (~(hole | board)).bits();
+      while (live) {
+        const uint64_t first = live & -live;
+        live ^= first;
+        if (street == core::Street::Turn) {
+          add(first);
+          continue;
+        }
+        for (uint64_t rest = live; rest; rest &= rest - 1)
+          add(first | (rest & -rest));
+      }
+      accumulate(histogram, bins, static_cast<double>(samples));
+      if (means) {
+        (*means)[i] = static_cast<float>(static_cast<double>(sum) /
+                                         (65535.0 * samples));
+      }
+    }
+  });
+  return features;
+}
+
+std::vector<float> BucketTable::preflopHistograms(
+    std::span<const float> flopMeans, size_t bins, ThreadPool &pool) {
+  if (bins == 0) {
+    throw std::invalid_argument("BucketTable: histograms need bins");
+  }
+  const HandIndexer &preflop = HandIndexer::forStreet(core::Street::Preflop);
+  const HandIndexer &flop = HandIndexer::forStreet(core::Street::Flop);
+  if (flopMeans.size() != flop.size()) {
+    throw std::invalid_argument("BucketTable: flop means table size");
+  }
+  std::vector<float> features(preflop.size() * bins);
+  pool.parallelFor(preflop.size(), [&](size_t i, size_t) {
+    core::CardSet hole, none;
+    preflop.unindex(i, hole, none);
+    float *histogram = features.data() + i * bins;
+    double samples = 0.0;
+    uint64_t live = (~hole).bits();
+    for (uint64_t a = live; a; a &= a - 1) {
+      for (uint64_t b = a & (a - 1); b; b &= b - 1) {
+        for (uint64_t c = b & (b - 1); c; c &= c - 1) {
+          const core::CardSet board((a & -a) | (b & -b) | (c & -c));
+          const float mean = flopMeans[flop.index(hole, board)];
+          const auto scaled = static_cast<uint32_t>(mean * 65535.0f);
+          histogram[binOf(scaled, bins)] += 1.0f;
+          samples += 1.0;
+        }
+      }
+    }
+    accumulate(histogram, bins, samples);
+  });
+  return features;
+}
+
+BucketTable::Buckets BucketTable::build(const BucketBuildOptions &options) {
+  if (options.histogramBins == 0) {
+    throw std::invalid_argument("BucketTable: histograms need bins");
+  }
+  for (size_t k : options.buckets) {
+    if (k == 0 || k > 65536) {
+      throw std::invalid_argument("BucketTable: 1 to 65536 buckets a street");
+    }
+  }
+  auto report = [&](const std::string &stage) {
+    if (options.progress)
+      options.progress(stage);
+  };
+  const size_t bins = options.histogramBins;
+  ThreadPool pool(options.threads);
+  KMeans kmeans(options.threads);
+  Buckets buckets;
+
+  const auto river = riverEquityTable(pool);
+  report("river equities");
+  {
+    const auto turn =
+        equityHistograms(core::Street::Turn, river, bins, pool);
+    report("turn histograms");
+    buckets[2] =
+        clusterHistograms(kmeans, turn, bins, options.buckets[2], options, 2);
+    report("turn buckets");
+  }
+  std::vector<float> flopMeans;
+  {
+    const auto flop =
+        equityHistograms(core::Street::Flop, river, bins, pool, &flopMeans);
+    report("flop histograms");
+    buckets[1] =
+        clusterHistograms(kmeans, flop, bins, options.buckets[1], options, 1);
+    report("flop buckets");
+  }
+  const auto preflop = preflopHistograms(flopMeans, bins, pool);
+  buckets[0] =
+      clusterHistograms(kmeans, preflop, bins, options.buckets[0], options, 0);
+  report("preflop buckets");
+  buckets[3] = clusterRiver(kmeans, river, options.buckets[3], options);
+  report("river buckets");
+  return buckets;
+}
+
+} // namespace poker::utils
@@ -0,0 +1,15 @@
+#include "core/CardSet.h"
+
+namespace poker::core {
+
+std::string CardSet::toString() const {
+  std::string s;
+  for (Card c : *this) {
+    if (!s.empty())
+      s += ' ';
+    s += c.toString();
+  }
+  return s;
+}
+
+} // namespace poker::core
@@ -0,0 +1,134 @@
+#include "core/CompactGameState.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace poker::core {
+
+namespace {
+
+int32_t narrow(int64_t amount) {
+  if (amount < std::numeric_limits<int32_t>::min() ||
+      amount > std::numeric_limits<int32_t>::max()) {
+    throw std::out_of_range("CompactGameState: chip amount exceeds 32 bits");
+  }
+  return static_cast<int32_t>(amount);
+}
+
+uint8_t cardIndex(Card c) { return static_cast<uint8_t>(CardSet::toIndex(c)); }
+
+} // anonymous namespace
+
+CompactGameState CompactGameState::fromGameState(const GameState &state) {
+  const auto &players = state.getPlayers();
+  const auto &history = state.getActionHistory();
+  if (players.size() > kSeatCapacity) {
+    throw std::length_error("CompactGameState: more than 10 seats");
+  }
+  if (history.size() > kActionCapacity) {
+    throw std::length_error("CompactGameState: action log is full");
+  }
+
+  CompactGameState c{};
+  c.smallBlind = narrow(state.getSmallBlind());
+  c.bigBlind = narrow(state.getBigBlind());
+  c.street = state.getStreet();
+  c.numSeats = static_cast<uint8_t>(players.size());
+  c.dealer = static_cast<uint8_t>(state.getDealerPosition());
+  c.currentPlayer = static_cast<uint8_t>(state.getCurrentPlayerIndex());
+
+  const auto &board = state.getCommunityCards();
+  c.numBoard = static_cast<uint8_t>(board.size());
+  for (size_t i = 0; i < sizeof(c.board); ++i) {
+    c.board[i] = i < board.size() ? cardIndex(board[i]) : kNoCard;
+  }
+
+  for (size_t i = 0; i < players.size(); ++i) {
+    const Player &p = players[i];
+    Seat &seat = c.seats[i];
+    seat.chips = narrow(p.getChips());
+    seat.currentBet = narrow(p.getCurrentBet());
+    seat.contributed = narrow(state.getPot().getPlayerContribution(p.getId()));
+    const auto &hole = p.getHoleCards();
+    seat.hole[0] = hole.size() > 0 ? cardIndex(hole[0]) : kNoCard;
+    seat.hole[1] = hole.size() > 1 ? cardIndex(hole[1]) : kNoCard;
+    seat.flags = static_cast<uint8_t>((p.isFolded() ? kFolded : 0) |
+                                      (p.isAllIn() ? kAllIn : 0));
+  }
+
+  c.numActions = static_cast<uint8_t>(history.size());
+  for (size_t i = 0; i < history.size(); ++i) {
+    c.actions[i].type = history[i].type;
+    c.actions[i].seat = static_cast<uint8_t>(history[i].playerId);
+    c.actions[i].amount = narrow(history[i].amount);
+  }
+  return c;
+}
+
+GameState
+CompactGameState::toGameState(std::span<const std::string> names) const {
+  GameState state;
+  std::vector<Player> players;
+  players.reserve(numSeats);
+  for (size_t i = 0; i < numSeats; ++i) {
+    const Seat &seat = seats[i];
+    players.emplace_back(i,
+                         i < names.size() ? names[i]
+                                          : "Seat " + std::to_string(i),
+                         0);
+    Player &p = players.back();
+    for (uint8_t card : seat.hole) {
+      if (card != kNoCard)
+        p.dealCard(CardSet::fromIndex(card));
+    }
+    p.restoreBettingState(seat.chips, seat.currentBet,
+                          (seat.flags & kFolded) != 0,
+                          (seat.flags & kAllIn) != 0);
+  }
+  state.setPlayers(std::move(players));
+  state.setSmallBlind(smallBlind);
+  state.setBigBlind(bigBlind);
+  state.setDealerPosition(dealer);
+  state.setStreet(street);
+  state.setCurrentPlayerIndex(currentPlayer);
+
+  for (size_t i = 0; i < numBoard; ++i) {
+    state.addCommunityCard(CardSet::fromIndex(board[i]));
+  }
+  for (size_t i = 0; i < numSeats; ++i) {
+    if (seats[i].contributed != 0)
+      state.getMutablePot().addContribution(i, seats[i].contributed);
+  }
+  for (size_t i = 0; i < numActions; ++i) {
+    state.recordAction(
+        Action(actions[i].type, actions[i].amount, actions[i].seat));
+  }
+  return state;
+}
+
+int64_t CompactGameState::getPotTotal() const noexcept {
+  int64_t total = 0;
+  for (size_t i = 0; i < numSeats; ++i) {
+    total += seats[i].contributed;
+  }
+  return total;
+}
+
+CardSet CompactGameState::getBoardSet() const noexcept {
+  CardSet set;
+  for (size_t i = 0; i < numBoard; ++i) {
+    set.insert(CardSet::fromIndex(board[i]));
+  }
+  return set;
+}
+
+CardSet CompactGameState::getHoleCardSet(size_t seat) const noexcept {
+  CardSet set;
+  for (uint8_t card : seats[seat].hole) {
+    if (card != kNoCard)
+      set.insert(CardSet::fromIndex(card));
+  }
+  return set;
+}
+
+} // namespace poker::core
@@ -1,14 +1,33 @@
 #include "core/Deck.h"
 
 #include <algorithm>
+#include <array>
 #include <random>
 
 namespace poker::core {
 
-Deck::Deck() { reset(); }
+namespace {
+
+/// All 52 cards in canonical order (suit by suit, Two to Ace), copied in
+/// by reset() rather than rebuilt card by card.
+constexpr std::array<Card, 52> kOrderedDeck = [] {
+  std::array<Card, 52> cards;
+  for (unsigned i = 0; i < 52; ++i) {
+    cards[i] = CardSet::fromIndex(i);
+  }
+  return cards;
+}();
+
+} // anonymous namespace
+
+Deck::Deck() {
+  cards_.reserve(52);
+  reset();
+}
 
 void Deck::shuffle(interfaces::IRandomGenerator &rng) {
   dealIndex_ = 0;
+  remaining_ = CardSet(cards_);
   rng.shuffle(cards_);
 }
 
@@ -16,17 +35,24 @@ std::optional<Card> Deck::deal() {
   if (dealIndex_ >= cards_.size()) {
     return std::nullopt;
   }
+  remaining_.erase(cards_[dealIndex_]);
   return cards_[dealIndex_++];
 }
 
-void Deck::reset() {
-  cards_.clear();
-  cards_.reserve(52);
-  for (uint8_t s = 0; s < 4; ++s) {
-    for (uint8_t r = 2; r <= 14; ++r) {
-      cards_.emplace_back(static_cast<Rank>(r), static_cast<Suit>(s));
+void Deck::reset() { reset(CardSet()); }
+
+void Deck::reset(CardSet dead) {
+  if (dead.empty()) {
+    cards_.assign(kOrderedDeck.begin(), kOrderedDeck.end());
+  } else {
+    cards_.clear();
+    for (const Card &c : kOrderedDeck) {
+      if (!dead.contains(c)) {
+        cards_.push_back(c);
+      }
     }
   }
+  remaining_ = ~dead;
   dealIndex_ = 0;
 }
 
@@ -0,0 +1,669 @@
+#include "utils/EquityCalculator.h"
+#include "core/Random.h"
+#include "utils/HandEvaluator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+namespace poker::utils {
+
+namespace {
+
+/// Runouts scored per evaluateBatch call.
+constexpr size_t kBlockSize = 256;
+/// 2 * 22 hole cards + 5 board cards still fit in one deck.
+constexpr size_t kMaxPlayers = 22;
+/// Samples required before a standard-error target may stop the run.
+constexpr uint64_t kMinSamplesForTarget = 1024;
+
+/// Validated description of what must be drawn for one runout.
+struct SamplingPlan {
+  size_t numPlayers = 0;
+  std::array<uint64_t, kMaxPlayers> known = {};
+  std::array<uint8_t, kMaxPlayers> missing = {};
+  uint64_t board = 0;
+  uint64_t dead = 0;
+  size_t boardMissing = 0;
+  std::array<uint8_t, 52> deck = {}; ///< Bit indices of undealt cards.
+  size_t deckSize = 0;
+  size_t toDraw = 0;
+};
+
+SamplingPlan makePlan(const EquityQuery &query) {
+  SamplingPlan plan;
+  plan.numPlayers = query.holeCards.size();
+  if (plan.numPlayers < 2 || plan.numPlayers > kMaxPlayers) {
+    throw std::invalid_argument("EquityCalculator requires 2-22 players");
+  }
+  if (query.board.size() > 5) {
+    throw std::invalid_argument("EquityCalculator board has more than 5 cards");
+  }
+
+  core::CardSet used = query.board;
+  if (used.intersects(query.dead)) {
+    throw std::invalid_argument("EquityCalculator board overlaps dead cards");
+  }
+  used |= query.dead;
+  for (size_t p = 0; p < plan.numPlayers; ++p) {
+    const auto hole = query.holeCards[p];
+    if (hole.size() > 2) {
+      throw std::invalid_argument("EquityCalculator hole cards exceed 2");
+    }
+    if (used.intersects(hole)) {
+      throw std::invalid_argument("EquityCalculator got overlapping cards");
+    }
+    used |= hole;
+    plan.known[p] = hole.bits();
+    plan.missing[p] = static_cast<uint8_t>(2 - hole.size());
+    plan.toDraw += plan.missing[p];
+  }
+  plan.board = query.board.bits();
+  plan.dead = query.dead.bits();
+  plan.boardMissing = 5 - query.board.size();
+  plan.toDraw += plan.boardMissing;
+
+  for (core::Card c : ~used) {
+    plan.deck[plan.deckSize++] =
+        static_cast<uint8_t>(core::CardSet::bitIndex(c));
+  }
+  if (plan.toDraw > plan.deckSize) {
+    throw std::invalid_argument("EquityCalculator needs more cards than remain");
+  }
+  return plan;
+}
+
+/// Per-player tallies; shared totals and per-worker partials use the same.
+struct Tally {
+  std::array<uint64_t, kMaxPlayers> wins = {};
+  std::array<uint64_t, kMaxPlayers> ties = {};
+  std::array<double, kMaxPlayers> share = {};
+  std::array<double, kMaxPlayers> shareSq = {};
+  uint64_t samples = 0;
+
+  void add(const Tally &o, size_t numPlayers) {
+    for (size_t p = 0; p < numPlayers; ++p) {
+      wins[p] += o.wins[p];
+      ties[p] += o.ties[p];
+      share[p] += o.share[p];
+      shareSq[p] += o.shareSq[p];
+    }
+    samples += o.samples;
+  }
+
+  double stdError(size_t p) const {
+    if (samples == 0)
+      return 0.0;
+    double n = static_cast<double>(samples);
+    double mean = share[p] / n;
+    double var = std::max(0.0, shareSq[p] / n - mean * mean);
+    return std::sqrt(var / n);
+  }
+};
+
+/// lcm(1..22): any split among up to kMaxPlayers divides it exactly, so
+/// enumerated pot shares can be summed in integers.
+constexpr uint64_t kShareUnit = 232792560;
+
+/// Integer tallies for enumeration; addition is order-independent, which is
+/// what makes the result bit-identical regardless of thread scheduling.
+struct ExactTally {
+  std::array<uint64_t, kMaxPlayers> wins = {};
+  std::array<uint64_t, kMaxPlayers> ties = {};
+  std::array<uint64_t, kMaxPlayers> shareUnits = {};
+  uint64_t runouts = 0;
+  uint64_t evaluated = 0;
+
+  void add(const ExactTally &o, size_t numPlayers) {
+    for (size_t p = 0; p < numPlayers; ++p) {
+      wins[p] += o.wins[p];
+      ties[p] += o.ties[p];
+      shareUnits[p] += o.shareUnits[p];
+    }
+    runouts += o.runouts;
+    evaluated += o.evaluated;
+  }
+};
+
+/// perm[s] is the suit that suit s is mapped to.
+using SuitPerm = std::array<uint8_t, 4>;
+
+uint64_t permuteSuits(uint64_t bits, const SuitPerm &perm) {
+  return core::CardSet(bits).permuteSuits(perm).bits();
+}
+
+/// Non-identity suit permutations that fix every known card group.
+std::vector<SuitPerm> suitSymmetries(const SamplingPlan &plan) {
+  std::vector<SuitPerm> out;
+  SuitPerm perm = {0, 1, 2, 3};
+  while (std::next_permutation(perm.begin(), perm.end())) {
+    bool fixes = permuteSuits(plan.board, perm) == plan.board &&
+                 permuteSuits(plan.dead, perm) == plan.dead;
+    for (size_t p = 0; p < plan.numPlayers && fixes; ++p)
+      fixes = permuteSuits(plan.known[p], perm) == plan.known[p];
+    if (fixes)
+      out.push_back(perm);
+  }
+  return out;
+}
+
+/// Size of the runout's isomorphism class if it is the class representative
+/// (its smallest member), otherwise 0.
+uint32_t classWeight(uint64_t runout, const std::vector<SuitPerm> &symmetries) {
+  uint32_t stabiliser = 1;
+  for (const auto &perm : symmetries) {
+    uint64_t image = permuteSuits(runout, perm);
+    if (image < runout)
+      return 0;
+    if (image == runout)
+      ++stabiliser;
+  }
+  return static_cast<uint32_t>(symmetries.size() + 1) / stabiliser;
+}
+
+/// Boards handed to a worker per claim in range-vs-range equity.
+constexpr size_t kBoardsPerClaim = 8;
+
+/// A combo of a range that survives the fixed board and dead cards.
+struct LiveCombo {
+  uint64_t bits;
+  uint16_t combo;
+  uint8_t card0; ///< Dense card indices, for per-card blocker sums.
+  uint8_t card1;
+  double weight;
+};
+
+std::vector<LiveCombo> liveCombos(const Range &range, uint64_t blocked) {
+  std::vector<LiveCombo> out;
+  for (size_t i = 0; i < Range::kNumCombos; ++i) {
+    const double w = range.weight(i);
+    const core::CardSet cards = Range::comboCards(i);
+    if (w <= 0.0 || (cards.bits() & blocked) != 0)
+      continue;
+    auto it = cards.begin();
+    const auto c0 = static_cast<uint8_t>(core::CardSet::toIndex(*it++));
+    const auto c1 = static_cast<uint8_t>(core::CardSet::toIndex(*it));
+    out.push_back({cards.bits(), static_cast<uint16_t>(i), c0, c1, w});
+  }
+  return out;
+}
+
+/// Every k-card subset of deck[0..n), as bit masks.
+std::vector<uint64_t> allRunouts(const std::array<uint8_t, 52> &deck, size_t n,
+                                 size_t k) {
+  std::vector<uint64_t> out;
+  std::array<size_t, 5> pos;
+  for (size_t j = 0; j < k; ++j)
+    pos[j] = j;
+  while (true) {
+    uint64_t runout = 0;
+    for (size_t j = 0; j < k; ++j)
+      runout |= uint64_t{1} << deck[pos[j]];
+    out.push_back(runout);
+    size_t j = k;
+    while (j > 0 && pos[j - 1] == n - k + (j - 1))
+      --j;
+    if (j == 0)
+      break;
+    ++pos[j - 1];
+    for (size_t m = j; m < k; ++m)
+      pos[m] = pos[m - 1] + 1;
+  }
+  return out;
+}
+
+uint64_t binomial(size_t n, size_t k) {
+  uint64_t r = 1;
+  for (size_t i = 1; i <= k; ++i)
+    r = r * (n - k + i) / i;
+  return r;
+}
+
+/// Scratch and accumulators for one worker of rangeEquity.
+struct RangeSweep {
+  std::vector<core::CardSet> holes;
+  std::vector<HandStrength> strengths;
+  std::vector<uint32_t> heroKeys;   ///< strength << 16 | live position
+  std::vector<uint32_t> villainKeys;
+  std::vector<double> win, tie, valid; ///< Per live hero combo.
+
+  RangeSweep(size_t numHero, size_t numVillain)
+      : holes(std::max(numHero, numVillain)),
+        strengths(std::max(numHero, numVillain)), win(numHero),
+        tie(numHero), valid(numHero) {
+    heroKeys.reserve(numHero);
+    villainKeys.reserve(numVillain);
+  }
+
+  /// Rank the combos not blocked by `runout` and return sorted keys.
+  void rank(const std::vector<LiveCombo> &combos, uint64_t board,
+            uint64_t runout, std::vector<uint32_t> &keys) {
+    size_t n = 0;
+    keys.clear();
+    for (size_t i = 0; i < combos.size(); ++i) {
+      if (combos[i].bits & runout)
+        continue;
+      holes[n] = core::CardSet(combos[i].bits);
+      keys.push_back(static_cast<uint32_t>(i));
+      ++n;
+    }
+    HandEvaluator::evaluateBatch(
+        core::CardSet(board | runout),
+        std::span<const core::CardSet>(holes.data(), n),
+        std::span<HandStrength>(strengths.data(), n));
+    for (size_t i = 0; i < n; ++i)
+      keys[i] |= static_cast<uint32_t>(strengths[i]) << 16;
+    std::sort(keys.begin(), keys.end());
+  }
+
+  void sweep(const std::vector<LiveCombo> &hero,
+             const std::vector<LiveCombo> &villain,
+             const std::array<double, Range::kNumCombos> &villainWeight) {
+    std::array<double, 52> cardAll = {}, cardLess = {}, cardGroup = {};
+    double totalV = 0.0;
+    for (uint32_t key : villainKeys) {
+      const LiveCombo &v = villain[key & 0xFFFF];
+      totalV += v.weight;
+      cardAll[v.card0] += v.weight;
+      cardAll[v.card1] += v.weight;
+    }
+
+    double less = 0.0;
+    size_t vi = 0;
+    size_t hi = 0;
+    while (hi < heroKeys.size()) {
+      const uint32_t strength = heroKeys[hi] >> 16;
+      for (; vi < villainKeys.size() && (villainKeys[vi] >> 16) < strength;
+           ++vi) {
+        const LiveCombo &v = villain[villainKeys[vi] & 0xFFFF];
+        less += v.weight;
+        cardLess[v.card0] += v.weight;
+        cardLess[v.card1] += v.weight;
+      }
+      double group = 0.0;
+      size_t vj = vi;
+      for (; vj < villainKeys.size() && (villainKeys[vj] >> 16) == strength;
+           ++vj) {
+        const LiveCombo &v = villain[villainKeys[vj] & 0xFFFF];
+        group += v.weight;
+        cardGroup[v.card0] += v.weight;
+        cardGroup[v.card1] += v.weight;
+      }
+      for (; hi < heroKeys.size() && (heroKeys[hi] >> 16) == strength; ++hi) {
+        const size_t h = heroKeys[hi] & 0xFFFF;
+        const LiveCombo &c = hero[h];
+        // The identical villain combo, if any, shares both cards and has
+        // the same strength; it was subtracted twice and is added back once.
+        const double same = villainWeight[c.combo];
+        win[h] += less - cardLess[c.card0] - cardLess[c.card1];
+        tie[h] += group - cardGroup[c.card0] - cardGroup[c.card1] + same;
+        valid[h] += totalV - cardAll[c.card0] - cardAll[c.card1] + same;
+      }
+      for (size_t k = vi; k < vj; ++k) {
+        const LiveCombo &v = villain[villainKeys[k] & 0xFFFF];
+        cardGroup[v.card0] = 0.0;
+        cardGroup[v.card1] = 0.0;
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+EquityCalculator::EquityCalculator(size_t numThreads) : pool_(numThreads) {}
+
+EquityResult EquityCalculator::calculate(const EquityQuery &query,
+                                         const EquityOptions &options) {
+  if (options.maxSamples == 0 && options.timeBudget.count() <= 0 &&
+      options.targetStdError <= 0.0) {
+    throw std::invalid_argument("EquityCalculator needs a stopping rule");
+  }
+  const SamplingPlan plan = makePlan(query);
+  const size_t numPlayers = plan.numPlayers;
+  uint64_t baseSeed = options.seed;
+  if (baseSeed == 0) {
+    std::random_device rd;
+    baseSeed = (static_cast<uint64_t>(rd()) << 32) | rd();
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  const auto deadline = start + options.timeBudget;
+
+  std::atomic<uint64_t> claimed{0};
+  std::atomic<bool> stop{false};
+  std::mutex totalMutex;
+  Tally total;
+
+  pool_.runOnAll([&](size_t worker) {
+    // Everything the sampling loop touches is set up here, once.
+    core::Xoshiro256Generator rng(
+        core::splitMix64(baseSeed ^ core::splitMix64(worker + 1)));
+    std::array<uint8_t, 52> deck = plan.deck;
+    std::vector<core::CardSet> hands(kBlockSize * numPlayers);
+    std::vector<HandStrength> strengths(kBlockSize * numPlayers);
+    std::array<uint64_t, kMaxPlayers> holes;
+    Tally local;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+      uint64_t first = claimed.fetch_add(kBlockSize, std::memory_order_relaxed);
+      size_t count = kBlockSize;
+      if (options.maxSamples != 0) {
+        if (first >= options.maxSamples)
+          break;
+        count = static_cast<size_t>(
+            std::min<uint64_t>(kBlockSize, options.maxSamples - first));
+      }
+
+      // Draw runouts with a partial Fisher-Yates over the undealt cards.
+      for (size_t t = 0; t < count; ++t) {
+        for (size_t j = 0; j < plan.toDraw; ++j) {
+          const auto left = static_cast<uint32_t>(plan.deckSize - j);
+          size_t r = j + core::uniformBelow(rng, left);
+          std::swap(deck[j], deck[r]);
+        }
+        size_t next = 0;
+        for (size_t p = 0; p < numPlayers; ++p) {
+          holes[p] = plan.known[p];
+          for (uint8_t m = 0; m < plan.missing[p]; ++m)
+            holes[p] |= uint64_t{1} << deck[next++];
+        }
+        uint64_t board = plan.board;
+        for (size_t m = 0; m < plan.boardMissing; ++m)
+          board |= uint64_t{1} << deck[next++];
+        for (size_t p = 0; p < numPlayers; ++p)
+          hands[t * numPlayers + p] = core::CardSet(holes[p] | board);
+      }
+
+      HandEvaluator::evaluateBatch(
+          std::span<const core::CardSet>(hands.data(), count * numPlayers),
+          strengths);
+
+      local = Tally();
+      local.samples = count;
+      for (size_t t = 0; t < count; ++t) {
+        const HandStrength *s = strengths.data() + t * numPlayers;
+        HandStrength best = *std::max_element(s, s + numPlayers);
+        size_t winners = static_cast<size_t>(std::count(s, s + numPlayers, best));
+        double portion = 1.0 / static_cast<double>(winners);
+        for (size_t p = 0; p < numPlayers; ++p) {
+          if (s[p] != best)
+            continue;
+          if (winners == 1)
+            ++local.wins[p];
+          else
+            ++local.ties[p];
+          local.share[p] += portion;
+          local.shareSq[p] += portion * portion;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(totalMutex);
+      total.add(local, numPlayers);
+      if (options.timeBudget.count() > 0 && Clock::now() >= deadline) {
+        stop = true;
+      }
+      if (options.targetStdError > 0.0 &&
+          total.samples >= kMinSamplesForTarget) {
+        bool precise = true;
+        for (size_t p = 0; p < numPlayers && precise; ++p)
+          precise = total.stdError(p) <= options.targetStdError;
+        if (precise)
+          stop = true;
+      }
+    }
+  });
+
+  EquityResult result;
+  result.samples = total.samples;
+  result.evaluated = total.samples;
+  result.elapsedSeconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  result.players.resize(numPlayers);
+  if (total.samples == 0)
+    return result;
+
+  const double n = static_cast<double>(total.samples);
+  for (size_t p = 0; p < numPlayers; ++p) {
+    auto &pe = result.players[p];
+    pe.win = static_cast<double>(total.wins[p]) / n;
+    pe.tie = static_cast<double>(total.ties[p]) / n;
+    pe.equity = total.share[p] / n;
+    pe.stdError = total.stdError(p);
+    pe.margin = options.confidenceZ * pe.stdError;
+  }
+  return result;
+}
+
+EquityResult EquityCalculator::enumerate(const EquityQuery &query) {
+  const SamplingPlan plan = makePlan(query);
+  const size_t numPlayers = plan.numPlayers;
+  for (size_t p = 0; p < numPlayers; ++p) {
+    if (plan.missing[p] != 0) {
+      throw std::invalid_argument(
+          "EquityCalculator::enumerate needs every hole card");
+    }
+  }
+  const std::vector<SuitPerm> symmetries = suitSymmetries(plan);
+  const size_t need = plan.boardMissing;
+  const size_t deckSize = plan.deckSize;
+  // One work item per choice of the first card to come; the rest of the
+  // runout is drawn from the cards after it in deck order.
+  const size_t numItems = need == 0 ? 1 : deckSize - need + 1;
+
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  std::atomic<size_t> nextItem{0};
+  std::mutex totalMutex;
+  ExactTally total;
+
+  pool_.runOnAll([&](size_t) {
+    std::vector<core::CardSet> hands(kBlockSize * numPlayers);
+    std::vector<HandStrength> strengths(kBlockSize * numPlayers);
+    std::array<uint32_t, kBlockSize> weights;
+    size_t pending = 0;
+    ExactTally local;
+
+    auto flush = [&] {
+      HandEvaluator::evaluateBatch(
+          std::span<const core::CardSet>(hands.data(), pending * numPlayers),
+          strengths);
+      for (size_t t = 0; t < pending; ++t) {
+        const HandStrength *s = strengths.data() + t * numPlayers;
+        HandStrength best = *std::max_element(s, s + numPlayers);
+        size_t winners = static_cast<size_t>(std::count(s, s + numPlayers, best));
+        const uint64_t w = weights[t];
+        for (size_t p = 0; p < numPlayers; ++p) {
+          if (s[p] != best)
+            continue;
+          if (winners == 1)
+            local.wins[p] += w;
+          else
+            local.ties[p] += w;
+          local.shareUnits[p] += w * (kShareUnit / winners);
+        }
+        local.runouts += w;
+      }
+      local.evaluated += pending;
+      pending = 0;
+    };
+
+    auto emit = [&](uint64_t runout) {
+      uint32_t weight = classWeight(runout, symmetries);
+      if (weight == 0)
+        return;
+      const uint64_t board = plan.board | runout;
+      for (size_t p = 0; p < numPlayers; ++p)
+        hands[pending * numPlayers + p] = core::CardSet(plan.known[p] | board);
+      weights[pending] = weight;
+      if (++pending == kBlockSize)
+        flush();
+    };
+
+    for (size_t item = nextItem.fetch_add(1, std::memory_order_relaxed);
+         item < numItems;
+         item = nextItem.fetch_add(1, std::memory_order_relaxed)) {
+      if (need == 0) {
+        emit(0);
+        continue;
+      }
+      const uint64_t first = uint64_t{1} << plan.deck[item];
+      const size_t rest = need - 1;
+      std::array<size_t, 4> pos;
+      for (size_t j = 0; j < rest; ++j)
+        pos[j] = item + 1 + j;
+      while (true) {
+        uint64_t runout = first;
+        for (size_t j = 0; j < rest; ++j)
+          runout |= uint64_t{1} << plan.deck[pos[j]];
+        emit(runout);
+
+        // Advance to the next combination of the remaining positions.
+        size_t j = rest;
+        while (j > 0 && pos[j - 1] == deckSize - rest + (j - 1))
+          --j;
+        if (j == 0)
+          break;
+        ++pos[j - 1];
+        for (size_t k = j; k < rest; ++k)
+          pos[k] = pos[k - 1] + 1;
+      }
+    }
+    if (pending != 0)
+      flush();
+
+    std::lock_guard<std::mutex> lock(totalMutex);
+    total.add(local, numPlayers);
+  });
+
+  EquityResult result;
+  result.samples = total.runouts;
+  result.evaluated = total.evaluated;
+  result.exact = true;
+  result.elapsedSeconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  result.players.resize(numPlayers);
+  if (total.runouts == 0)
+    return result;
+
+  const double n = static_cast<double>(total.runouts);
+  for (size_t p = 0; p < numPlayers; ++p) {
+    auto &pe = result.players[p];
+    pe.win = static_cast<double>(total.wins[p]) / n;
+    pe.tie = static_cast<double>(total.ties[p]) / n;
+    pe.equity = static_cast<double>(total.shareUnits[p]) /
+                (static_cast<double>(kShareUnit) * n);
+  }
+  return result;
+}
+
+RangeEquityResult
+EquityCalculator::rangeEquity(const RangeEquityQuery &query,
+                              const RangeEquityOptions &options) {
+  if (query.board.size() > 5) {
+    throw std::invalid_argument("EquityCalculator board has more than 5 cards");
+  }
+  if (query.board.intersects(query.dead)) {
+    throw std::invalid_argument("EquityCalculator board overlaps dead cards");
+  }
+  const uint64_t board = query.board.bits();
+  const uint64_t blocked = board | query.dead.bits();
+  const std::vector<LiveCombo> hero = liveCombos(query.hero, blocked);
+  const std::vector<LiveCombo> villain = liveCombos(query.villain, blocked);
+  if (hero.empty() || villain.empty()) {
+    throw std::invalid_argument("EquityCalculator range is empty");
+  }
+  std::array<double, Range::kNumCombos> villainWeight = {};
+  for (const auto &v : villain)
+    villainWeight[v.combo] = v.weight;
+
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  std::array<uint8_t, 52> deck = {};
+  size_t deckSize = 0;
+  for (core::Card c : ~core::CardSet(blocked)) {
+    deck[deckSize++] = static_cast<uint8_t>(core::CardSet::bitIndex(c));
+  }
+  const size_t need = 5 - query.board.size();
+  const uint64_t completions = binomial(deckSize, need);
+  const bool exact = options.maxBoards == 0 || completions <= options.maxBoards;
+
+  std::vector<uint64_t> runouts;
+  if (exact) {
+    runouts = need == 0 ? std::vector<uint64_t>{0}
+                        : allRunouts(deck, deckSize, need);
+  } else {
+    uint64_t seed = options.seed;
+    if (seed == 0) {
+      std::random_device rd;
+      seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+    core::Xoshiro256Generator rng(core::splitMix64(seed));
+    runouts.resize(options.maxBoards);
+    for (auto &runout : runouts) {
+      runout = 0;
+      for (size_t j = 0; j < need; ++j) {
+        const auto left = static_cast<uint32_t>(deckSize - j);
+        size_t r = j + core::uniformBelow(rng, left);
+        std::swap(deck[j], deck[r]);
+        runout |= uint64_t{1} << deck[j];
+      }
+    }
+  }
+
+  std::atomic<size_t> nextBoard{0};
+  std::mutex totalMutex;
+  std::vector<double> win(hero.size()), tie(hero.size()), valid(hero.size());
+
+  pool_.runOnAll([&](size_t) {
+    RangeSweep local(hero.size(), villain.size());
+    while (true) {
+      size_t first = nextBoard.fetch_add(kBoardsPerClaim,
+                                         std::memory_order_relaxed);
+      if (first >= runouts.size())
+        break;
+      size_t last = std::min(runouts.size(), first + kBoardsPerClaim);
+      for (size_t b = first; b < last; ++b) {
+        local.rank(hero, board, runouts[b], local.heroKeys);
+        local.rank(villain, board, runouts[b], local.villainKeys);
+        local.sweep(hero, villain, villainWeight);
+      }
+    }
+    std::lock_guard<std::mutex> lock(totalMutex);
+    for (size_t h = 0; h < hero.size(); ++h) {
+      win[h] += local.win[h];
+      tie[h] += local.tie[h];
+      valid[h] += local.valid[h];
+    }
+  });
+
+  RangeEquityResult result;
+  result.boards = runouts.size();
+  result.exact = exact;
+  result.comboEquity.assign(Range::kNumCombos, 0.0);
+  double totalWin = 0.0, totalTie = 0.0, totalValid = 0.0;
+  for (size_t h = 0; h < hero.size(); ++h) {
+    if (valid[h] <= 0.0)
+      continue;
+    result.comboEquity[hero[h].combo] = (win[h] + 0.5 * tie[h]) / valid[h];
+    totalWin += hero[h].weight * win[h];
+    totalTie += hero[h].weight * tie[h];
+    totalValid += hero[h].weight * valid[h];
+  }
+  if (totalValid > 0.0) {
+    result.win = totalWin / totalValid;
+    result.tie = totalTie / totalValid;
+    result.equity = (totalWin + 0.5 * totalTie) / totalValid;
+  }
+  result.elapsedSeconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  return result;
+}
+
+} // namespace poker::utils
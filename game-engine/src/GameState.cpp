@@ -1,6 +1,7 @@
 #include "core/GameState.h"
 
 #include <sstream>
+#include <stdexcept>
 
 namespace poker::core {
 
@@ -8,10 +9,34 @@ void GameState::setPlayers(std::vector<Player> players) {
   players_ = std::move(players);
 }
 
-void GameState::addCommunityCard(Card c) { communityCards_.push_back(c); }
+void GameState::addCommunityCard(Card c) {
+  communityCards_.push_back(c);
+  communitySet_.insert(c);
+}
 
 void GameState::recordAction(Action a) { actionHistory_.push_back(a); }
 
+void GameState::removeLastCommunityCard() {
+  if (communityCards_.empty())
+    throw std::logic_error("removeLastCommunityCard: board is empty");
+  communitySet_.erase(communityCards_.back());
+  communityCards_.pop_back();
+}
+
+void GameState::removeLastAction() {
+  if (actionHistory_.empty())
+    throw std::logic_error("removeLastAction: no actions recorded");
+  actionHistory_.pop_back();
+}
+
+CardSet GameState::getDealtCardSet() const noexcept {
+  CardSet dealt = communitySet_;
+  for (const auto &p : players_) {
+    dealt |= p.getHoleCardSet();
+  }
+  return dealt;
+}
+
 size_t GameState::getNumActivePlayers() const {
   size_t count = 0;
   for (const auto &p : players_) {
@@ -47,8 +72,13 @@ size_t GameState::getBigBlindPosition() const noexcept {
 }
 
 void GameState::resetForNewHand() {
+  // clear() keeps capacity, so after the first few hands these buffers stop
+  // allocating; the reserves cover a typical hand up front.
   communityCards_.clear();
+  communityCards_.reserve(5);
+  communitySet_.clear();
   actionHistory_.clear();
+  actionHistory_.reserve(kReservedActions);
   pot_.reset();
   street_ = Street::Preflop;
   for (auto &p : players_) {
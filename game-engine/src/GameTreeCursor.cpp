@@ -0,0 +1,242 @@
+#include "engine/GameTreeCursor.h"
+#include "core/SeatMask.h"
+#include "engine/RuleEngine.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace poker::engine {
+
+namespace {
+
+/// The betting round PokerEngine would run from this state.
+core::BettingRound openRound(const core::GameState &state) {
+  const auto &players = state.getPlayers();
+  if (players.size() < 2 || players.size() > core::kMaxSeats) {
+    throw std::invalid_argument("GameTreeCursor: need 2 to 64 seats");
+  }
+  core::SeatMask canAct = 0;
+  int64_t currentBet = 0;
+  for (size_t i = 0; i < players.size(); ++i) {
+    if (!players[i].isFolded() && !players[i].isAllIn()) {
+      canAct |= core::seatBit(i);
+    }
+    currentBet = std::max(currentBet, players[i].getCurrentBet());
+  }
+  // As in PokerEngine, nobody bets unless two seats can still act.
+  if (std::popcount(canAct) <= 1)
+    canAct = 0;
+  return core::BettingRound(players.size(), RuleEngine::getFirstToAct(state),
+                            canAct, currentBet, state.getBigBlind());
+}
+
+} // anonymous namespace
+
+GameTreeCursor::GameTreeCursor(core::GameState &state) { reset(state); }
+
+void GameTreeCursor::reset(core::GameState &state) {
+  round_ = openRound(state);
+  state_ = &state;
+  log_.clear();
+  // Anything the root settles (e.g. a round with nobody left to act) is
+  // not undoable, so its record is discarded.
+  UndoEntry root{round_};
+  settleNode(root);
+  savedBets_.clear();
+}
+
+const core::ActionList &GameTreeCursor::getLegalActions() {
+  if (node_ == NodeType::Decision) {
+    RuleEngine::getLegalActions(*state_, round_,
+                                round_.getCurrentPlayerIndex(), legalActions_);
+  } else {
+    legalActions_.clear();
+  }
+  return legalActions_;
+}
+
+void GameTreeCursor::apply(const core::Action &action) {
+  if (node_ != NodeType::Decision) {
+    throw std::logic_error("GameTreeCursor::apply: not a decision node");
+  }
+  const size_t seat = round_.getCurrentPlayerIndex();
+  core::Action played = action;
+  played.playerId = seat;
+  if (!RuleEngine::isActionLegal(*state_, round_, played)) {
+    throw std::invalid_argument("GameTreeCursor::apply: illegal action");
+  }
+
+  auto &player = state_->getMutablePlayer(seat);
+  UndoEntry entry{round_};
+  entry.street = state_->getStreet();
+  entry.node = node_;
+  entry.currentPlayer = static_cast<uint8_t>(state_->getCurrentPlayerIndex());
+  entry.isAction = true;
+  entry.wasFolded = player.isFolded();
+  entry.wasAllIn = player.isAllIn();
+  entry.seat = static_cast<uint8_t>(seat);
+
+  switch (played.type) {
+  case core::ActionType::Fold:
+    player.fold();
+    break;
+  case core::ActionType::Check:
+    break;
+  case core::ActionType::Call:
+  case core::ActionType::Bet:
+  case core::ActionType::Raise:
+  case core::ActionType::AllIn:
+    entry.chips = player.placeBet(played.amount);
+    state_->getMutablePot().addContribution(seat, entry.chips);
+    break;
+  }
+  state_->recordAction(played);
+  round_.playerActed(player.getCurrentBet(),
+                     !player.isFolded() && !player.isAllIn());
+
+  settleNode(entry);
+  log_.push_back(entry);
+}
+
+size_t GameTreeCursor::cardsNeeded() const noexcept {
+  if (node_ != NodeType::Chance)
+    return 0;
+  return state_->getStreet() == core::Street::Flop ? 3 : 1;
+}
+
+void GameTreeCursor::dealBoard(std::span<const core::Card> cards) {
+  if (node_ != NodeType::Chance) {
+    throw std::logic_error("GameTreeCursor::dealBoard: not a chance node");
+  }
+  if (cards.size() != cardsNeeded()) {
+    throw std::invalid_argument("GameTreeCursor::dealBoard: wrong card count");
+  }
+  core::CardSet dealt = state_->getDealtCardSet();
+  for (const auto &c : cards) {
+    if (dealt.contains(c)) {
+      throw std::invalid_argument(
+          "GameTreeCursor::dealBoard: card already dealt");
+    }
+    dealt.insert(c);
+  }
+
+  UndoEntry entry{round_};
+  entry.street = state_->getStreet();
+  entry.node = node_;
+  entry.currentPlayer = static_cast<uint8_t>(state_->getCurrentPlayerIndex());
+  entry.cards = static_cast<uint8_t>(cards.size());
+  for (const auto &c : cards) {
+    state_->addCommunityCard(c);
+  }
+  round_ = openRound(*state_);
+
+  settleNode(entry);
+  log_.push_back(entry);
+}
+
+void GameTreeCursor::undo() {
+  if (log_.empty()) {
+    throw std::logic_error("GameTreeCursor::undo: at the root");
+  }
+  const UndoEntry entry = log_.back();
+  log_.pop_back();
+
+  auto &players = state_->getMutablePlayers();
+  if (entry.betsSaved) {
+    // Bets as they stood when the street closed.
+    for (size_t i = players.size(); i-- > 0;) {
+      const int64_t bet = savedBets_.back();
+      savedBets_.pop_back();
+      auto &p = players[i];
+      p.restoreBettingState(p.getChips(), bet, p.isFolded(), p.isAllIn());
+    }
+  }
+
+  if (entry.isAction) {
+    auto &p = players[entry.seat];
+    p.restoreBettingState(p.getChips() + entry.chips,
+                          p.getCurrentBet() - entry.chips, entry.wasFolded,
+                          entry.wasAllIn);
+    if (entry.chips != 0)
+      state_->getMutablePot().removeContribution(entry.seat, entry.chips);
+    state_->removeLastAction();
+  } else {
+    for (size_t i = 0; i < entry.cards; ++i) {
+      state_->removeLastCommunityCard();
+    }
+  }
+
+  round_ = entry.round;
+  node_ = entry.node;
+  state_->setStreet(entry.street);
+  state_->setCurrentPlayerIndex(entry.currentPlayer);
+}
+
+void GameTreeCursor::settleNode(UndoEntry &entry) {
+  if (state_->getNumPlayersInHand() <= 1) {
+    state_->setStreet(core::Street::Showdown);
+    node_ = NodeType::Terminal;
+    return;
+  }
+  if (!round_.isComplete()) {
+    node_ = NodeType::Decision;
+    state_->setCurrentPlayerIndex(round_.getCurrentPlayerIndex());
+    return;
+  }
+
+  // Betting on this street is over.
+  const core::Street street = state_->getStreet();
+  if (street == core::Street::River) {
+    state_->setStreet(core::Street::Showdown);
+    node_ = NodeType::Terminal;
+    return;
+  }
+  auto &players = state_->getMutablePlayers();
+  for (auto &p : players) {
+    savedBets_.push_back(p.getCurrentBet());
+    p.resetCurrentBet();
+  }
+  entry.betsSaved = true;
+  state_->setStreet(static_cast<core::Street>(static_cast<uint8_t>(street) + 1));
+  node_ = NodeType::Chance;
+}
+
+void GameTreeCursor::getPayoffs(std::span<int64_t> out) {
+  if (node_ != NodeType::Terminal) {
+    throw std::logic_error("GameTreeCursor::getPayoffs: hand not over");
+  }
+  const auto &players = state_->getPlayers();
+  if (out.size() < players.size()) {
+    throw std::invalid_argument("GameTreeCursor::getPayoffs: out too small");
+  }
+
+  const core::Pot &pot = state_->getPot();
+  core::SeatMask folded = 0;
+  for (size_t i = 0; i < players.size(); ++i) {
+    out[i] = -pot.getPlayerContribution(i);
+    if (players[i].isFolded())
+      folded |= core::seatBit(i);
+  }
+
+  if (state_->getNumPlayersInHand() == 1) {
+    for (size_t i = 0; i < players.size(); ++i) {
+      if (!players[i].isFolded())
+        out[i] += pot.getTotal();
+    }
+    return;
+  }
+
+  // The same split as PokerEngine's settlement.
+  pot.calculateSidePots(folded, sidePots_);
+  const core::CardSet board = state_->getCommunityCardSet();
+  for (const auto &side : sidePots_) {
+    const PotSplit split = RuleEngine::splitPot(side, players, board);
+    for (core::SeatMask m = split.winners; m != 0; m &= m - 1) {
+      const auto seat = static_cast<size_t>(std::countr_zero(m));
+      out[seat] += split.award(seat);
+    }
+  }
+}
+
+} // namespace poker::engine
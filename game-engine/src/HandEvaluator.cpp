@@ -1,8 +1,11 @@
 #include "utils/HandEvaluator.h"
+#include "HandTables.h"
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <stdexcept>
+#include <vector>
 
 namespace poker::utils {
 
@@ -40,6 +43,13 @@ std::string HandResult::toString() const { return rankName(rank); }
 
 namespace {
 
+using detail::kNumMasks;
+using detail::kNumRanks;
+using detail::kRowBits;
+using detail::kSlotBits;
+using detail::kSlotMask;
+using detail::StrengthTables;
+
 /// Check for flush: all 5 cards same suit.
 bool isFlush(std::span<const core::Card, 5> cards) {
   auto suit = cards[0].suit;
@@ -67,8 +77,300 @@ uint8_t straightHighCard(const std::array<uint8_t, 5> &ranks) {
   return 0;
 }
 
+
+// --- Lookup tables ---
+
+/// Per-rank additive key: base-5 digits hold each rank's multiplicity, so
+/// the key of any multiset with at most four cards per rank is unique.
+constexpr std::array<uint32_t, kNumRanks> kRankKeys = [] {
+  std::array<uint32_t, kNumRanks> keys{};
+  uint32_t k = 1;
+  for (auto &key : keys) {
+    key = k;
+    k *= 5;
+  }
+  return keys;
+}();
+
+/// Highest straight in a 13-bit rank mask (bit 0 = Two), or 0 if none.
+uint8_t straightHighInMask(uint32_t mask) {
+  for (int low = 8; low >= 0; --low) {
+    if (((mask >> low) & 0x1F) == 0x1F) {
+      return static_cast<uint8_t>(low + 6);
+    }
+  }
+  if ((mask & 0x100F) == 0x100F) {
+    return 5; // Wheel
+  }
+  return 0;
+}
+
+/// Best non-flush hand for a rank multiset of 5-7 cards.
+HandResult bestFromRankCounts(const std::array<uint8_t, kNumRanks> &counts) {
+  uint32_t mask = 0;
+  for (size_t r = 0; r < kNumRanks; ++r) {
+    if (counts[r] > 0)
+      mask |= 1u << r;
+  }
+
+  // Highest-first helper: collect up to n ranks satisfying a predicate.
+  auto topRanks = [&](auto pred, size_t n, uint8_t *out) {
+    size_t found = 0;
+    for (int r = kNumRanks - 1; r >= 0 && found < n; --r) {
+      if (pred(static_cast<size_t>(r))) {
+        out[found++] = static_cast<uint8_t>(r + 2);
+      }
+    }
+    return found;
+  };
+
+  HandResult result;
+  uint8_t quad = 0, trip = 0;
+  topRanks([&](size_t r) { return counts[r] == 4; }, 1, &quad);
+  if (quad) {
+    result.rank = HandRank::FourOfAKind;
+    result.kickers[0] = quad;
+    topRanks([&](size_t r) { return counts[r] > 0 && r + 2 != quad; }, 1,
+             &result.kickers[1]);
+    return result;
+  }
+
+  topRanks([&](size_t r) { return counts[r] == 3; }, 1, &trip);
+  uint8_t fullPair = 0;
+  if (trip) {
+    topRanks([&](size_t r) { return counts[r] >= 2 && r + 2 != trip; }, 1,
+             &fullPair);
+  }
+  if (trip && fullPair) {
+    result.rank = HandRank::FullHouse;
+    result.kickers = {trip, fullPair, 0, 0, 0};
+    return result;
+  }
+
+  if (uint8_t high = straightHighInMask(mask)) {
+    result.rank = HandRank::Straight;
+    result.kickers = {high, 0, 0, 0, 0};
+    return result;
+  }
+
+  if (trip) {
+    result.rank = HandRank::ThreeOfAKind;
+    result.kickers[0] = trip;
+    topRanks([&](size_t r) { return counts[r] > 0 && r + 2 != trip; }, 2,
+             &result.kickers[1]);
+    return result;
+  }
+
+  std::array<uint8_t, 2> pairs = {};
+  size_t numPairs = topRanks([&](size_t r) { return counts[r] == 2; }, 2,
+                             pairs.data());
+  if (numPairs == 2) {
+    result.rank = HandRank::TwoPair;
+    result.kickers = {pairs[0], pairs[1], 0, 0, 0};
+    topRanks(
+        [&](size_t r) {
+          return counts[r] > 0 && r + 2 != pairs[0] && r + 2 != pairs[1];
+        },
+        1, &result.kickers[2]);
+    return result;
+  }
+  if (numPairs == 1) {
+    result.rank = HandRank::Pair;
+    result.kickers[0] = pairs[0];
+    topRanks([&](size_t r) { return counts[r] > 0 && r + 2 != pairs[0]; }, 3,
+             &result.kickers[1]);
+    return result;
+  }
+
+  result.rank = HandRank::HighCard;
+  topRanks([&](size_t r) { return counts[r] > 0; }, 5, result.kickers.data());
+  return result;
+}
+
+/// Best hand from a single suit holding 5-7 cards.
+HandResult bestFromFlushMask(uint32_t mask) {
+  HandResult result;
+  if (uint8_t high = straightHighInMask(mask)) {
+    result.rank = high == 14 ? HandRank::RoyalFlush : HandRank::StraightFlush;
+    result.kickers = {high, 0, 0, 0, 0};
+    return result;
+  }
+  result.rank = HandRank::Flush;
+  size_t ki = 0;
+  for (int r = kNumRanks - 1; r >= 0 && ki < 5; --r) {
+    if (mask & (1u << r))
+      result.kickers[ki++] = static_cast<uint8_t>(r + 2);
+  }
+  return result;
+}
+
+/// Visit every rank multiset of minCards..maxCards cards.
+template <typename Fn>
+void forEachRankMultiset(size_t minCards, size_t maxCards, Fn &&fn) {
+  std::array<uint8_t, kNumRanks> counts = {};
+  auto recurse = [&](auto &self, size_t rank, size_t total) -> void {
+    if (rank == kNumRanks) {
+      if (total >= minCards)
+        fn(counts);
+      return;
+    }
+    for (uint8_t c = 0; c <= 4 && total + c <= maxCards; ++c) {
+      counts[rank] = c;
+      self(self, rank + 1, total + c);
+    }
+    counts[rank] = 0;
+  };
+  recurse(recurse, 0, 0);
+}
+
+/// Place every key with a displacement per row (first fit, largest rows
+/// first). Returns false if two keys of one row share a column.
+bool buildPerfectHash(StrengthTables &t,
+                      const std::vector<std::pair<uint32_t, HandStrength>> &kv) {
+  const size_t numRows = size_t{1} << kRowBits;
+  std::vector<std::vector<size_t>> rows(numRows);
+  for (size_t i = 0; i < kv.size(); ++i) {
+    rows[(kv[i].first * t.rowMultiplier) >> (32 - kRowBits)].push_back(i);
+  }
+
+  std::vector<size_t> order(numRows);
+  for (size_t i = 0; i < numRows; ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return rows[a].size() > rows[b].size();
+  });
+
+  std::vector<bool> used(kSlotMask + 1, false);
+  t.rowOffsets.assign(numRows, 0);
+  t.slots.assign(kSlotMask + 2, 0);
+  std::vector<uint32_t> cols;
+  for (size_t row : order) {
+    if (rows[row].empty())
+      break;
+    cols.clear();
+    for (size_t i : rows[row]) {
+      cols.push_back((kv[i].first * t.colMultiplier) >> (32 - kSlotBits));
+    }
+    for (size_t j = 1; j < cols.size(); ++j) {
+      if (std::find(cols.begin(), cols.begin() + j, cols[j]) !=
+          cols.begin() + j)
+        return false;
+    }
+    uint32_t offset = 0;
+    for (; offset <= kSlotMask; ++offset) {
+      bool fits = true;
+      for (size_t j = 0; j < cols.size() && fits; ++j) {
+        fits = !used[(cols[j] + offset) & kSlotMask];
+      }
+      if (fits)
+        break;
+    }
+    if (offset > kSlotMask)
+      return false;
+    t.rowOffsets[row] = offset;
+    for (size_t j = 0; j < cols.size(); ++j) {
+      uint32_t slot = (cols[j] + offset) & kSlotMask;
+      used[slot] = true;
+      t.slots[slot] = kv[rows[row][j]].second;
+    }
+  }
+  return true;
+}
+
+StrengthTables buildTables() {
+  StrengthTables t;
+
+  // Enumerate every 5-card hand class once to fix the strength ordinals.
+  forEachRankMultiset(5, 5, [&](const auto &counts) {
+    t.classes.push_back(bestFromRankCounts(counts));
+  });
+  for (uint32_t m = 0; m < kNumMasks; ++m) {
+    if (std::popcount(m) == 5)
+      t.classes.push_back(bestFromFlushMask(m));
+  }
+  std::sort(t.classes.begin(), t.classes.end());
+  t.classes.erase(std::unique(t.classes.begin(), t.classes.end()),
+                  t.classes.end());
+  for (size_t cat = 0; cat < t.categoryStart.size(); ++cat) {
+    auto it = std::find_if(t.classes.begin(), t.classes.end(),
+                           [&](const HandResult &r) {
+                             return static_cast<size_t>(r.rank) >= cat;
+                           });
+    t.categoryStart[cat] = static_cast<uint16_t>(it - t.classes.begin());
+  }
+
+  for (uint32_t m = 0; m < kNumMasks; ++m) {
+    for (size_t r = 0; r < kNumRanks; ++r) {
+      if (m & (1u << r))
+        t.maskKey[m] += kRankKeys[r];
+    }
+    if (std::popcount(m) >= 5)
+      t.flush[m] = t.strengthOf(bestFromFlushMask(m));
+  }
+
+  std::vector<std::pair<uint32_t, HandStrength>> kv;
+  forEachRankMultiset(5, 7, [&](const auto &counts) {
+    uint32_t key = 0;
+    for (size_t r = 0; r < kNumRanks; ++r)
+      key += counts[r] * kRankKeys[r];
+    kv.emplace_back(key, t.strengthOf(bestFromRankCounts(counts)));
+  });
+
+  // Deterministic column multiplier search; only an intra-row column
+  // collision forces another candidate, and that is rare.
+  t.rowMultiplier = 0x9E3779B1u;
+  uint32_t candidate = 0x85EBCA77u;
+  do {
+    t.colMultiplier = candidate | 1;
+    candidate += 0x632BE5ABu;
+  } while (!buildPerfectHash(t, kv));
+
+  return t;
+}
+
+const StrengthTables &tables() { return detail::strengthTables(); }
+
+/// Suit-separated 13-bit rank masks. Throws unless 5-7 cards.
+std::array<uint32_t, 4> toSuitMasks(core::CardSet cards) {
+  if (cards.size() < 5 || cards.size() > 7) {
+    throw std::invalid_argument("HandEvaluator::evaluate requires 5-7 cards");
+  }
+  return {cards.suitMask(core::Suit::Hearts),
+          cards.suitMask(core::Suit::Diamonds),
+          cards.suitMask(core::Suit::Clubs),
+          cards.suitMask(core::Suit::Spades)};
+}
+
+/// As above, additionally rejecting duplicate cards.
+std::array<uint32_t, 4> toSuitMasks(std::span<const core::Card> cards) {
+  if (cards.size() < 5 || cards.size() > 7) {
+    throw std::invalid_argument("HandEvaluator::evaluate requires 5-7 cards");
+  }
+  core::CardSet set(cards);
+  if (set.size() != cards.size()) {
+    throw std::invalid_argument("HandEvaluator::evaluate got duplicate cards");
+  }
+  return toSuitMasks(set);
+}
+
 } // anonymous namespace
 
+HandStrength detail::StrengthTables::strengthOf(const HandResult &r) const {
+  auto it = std::lower_bound(classes.begin(), classes.end(), r);
+  if (it == classes.end() || *it != r) {
+    throw std::invalid_argument("HandResult is not a valid 5-card hand");
+  }
+  auto cat = static_cast<size_t>(r.rank);
+  auto ordinal =
+      static_cast<uint16_t>(it - classes.begin()) - categoryStart[cat];
+  return static_cast<HandStrength>((cat << 12) | ordinal);
+}
+
+const detail::StrengthTables &detail::strengthTables() {
+  static const StrengthTables instance = buildTables();
+  return instance;
+}
+
 HandResult HandEvaluator::evaluate5(std::span<const core::Card, 5> cards) {
   // Get sorted ranks (descending).
   std::array<uint8_t, 5> ranks;
@@ -169,7 +471,41 @@ HandResult HandEvaluator::evaluate5(std::span<const core::Card, 5> cards) {
   return result;
 }
 
+HandStrength
+HandEvaluator::evaluateStrength(std::span<const core::Card> cards) {
+  HandStrength strength = tables().lookup(toSuitMasks(cards));
+#ifdef POKER_VERIFY_EVALUATOR
+  if (toResult(strength) != evaluateReference(cards)) {
+    throw std::logic_error(
+        "HandEvaluator: table and reference evaluation disagree");
+  }
+#endif
+  return strength;
+}
+
 HandResult HandEvaluator::evaluate(std::span<const core::Card> cards) {
+  return toResult(evaluateStrength(cards));
+}
+
+HandStrength HandEvaluator::evaluateStrength(core::CardSet cards) {
+  HandStrength strength = tables().lookup(toSuitMasks(cards));
+#ifdef POKER_VERIFY_EVALUATOR
+  std::array<core::Card, 7> list;
+  std::copy(cards.begin(), cards.end(), list.begin());
+  if (toResult(strength) !=
+      evaluateReference(std::span<const core::Card>(list.data(), cards.size()))) {
+    throw std::logic_error(
+        "HandEvaluator: table and reference evaluation disagree");
+  }
+#endif
+  return strength;
+}
+
+HandResult HandEvaluator::evaluate(core::CardSet cards) {
+  return toResult(evaluateStrength(cards));
+}
+
+HandResult HandEvaluator::evaluateReference(std::span<const core::Card> cards) {
   if (cards.size() < 5 || cards.size() > 7) {
     throw std::invalid_argument("HandEvaluator::evaluate requires 5-7 cards");
   }
@@ -208,13 +544,27 @@ HandResult HandEvaluator::evaluate(std::span<const core::Card> cards) {
 
 int HandEvaluator::compare(std::span<const core::Card> hand1,
                            std::span<const core::Card> hand2) {
-  auto r1 = evaluate(hand1);
-  auto r2 = evaluate(hand2);
-  if (r1 > r2)
+  auto s1 = evaluateStrength(hand1);
+  auto s2 = evaluateStrength(hand2);
+  if (s1 > s2)
     return 1;
-  if (r1 < r2)
+  if (s1 < s2)
     return -1;
   return 0;
 }
 
+HandResult HandEvaluator::toResult(HandStrength strength) {
+  const auto &t = tables();
+  auto cat = static_cast<size_t>(strength >> 12);
+  size_t index = t.categoryStart[std::min(cat, size_t{10})] + (strength & 0xFFF);
+  if (cat > 9 || index >= t.categoryStart[cat + 1]) {
+    throw std::invalid_argument("HandEvaluator::toResult got invalid strength");
+  }
+  return t.classes[index];
+}
+
+HandStrength HandEvaluator::toStrength(const HandResult &result) {
+  return tables().strengthOf(result);
+}
+
 } // namespace poker::utils
@@ -0,0 +1,274 @@
+#include "utils/HandEvaluator.h"
+#include "HandTables.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define POKER_EVAL_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define POKER_EVAL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define POKER_EVAL_TARGET(isa)
+#endif
+
+namespace poker::utils {
+
+namespace {
+
+using detail::kRowBits;
+using detail::kSlotBits;
+using detail::kSlotMask;
+using detail::StrengthTables;
+
+// All kernels use the branch-free form of StrengthTables::lookup: the
+// non-flush slot and the four per-suit flush entries (0 below five cards)
+// are combined with max. With at most 7 cards a flush rules out quads and
+// full houses, so the flush entry always wins when present.
+
+void evaluateScalar(const StrengthTables &t, const core::CardSet *hands,
+                    size_t n, uint64_t board, HandStrength *out) {
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t bits = hands[i].bits() | board;
+    uint32_t m0 = bits & 0x1FFF;
+    uint32_t m1 = (bits >> 16) & 0x1FFF;
+    uint32_t m2 = (bits >> 32) & 0x1FFF;
+    uint32_t m3 = (bits >> 48) & 0x1FFF;
+    uint32_t key = t.maskKey[m0] + t.maskKey[m1] + t.maskKey[m2] +
+                   t.maskKey[m3];
+    HandStrength best = t.slots[t.slotOf(key)];
+    best = std::max({best, t.flush[m0], t.flush[m1], t.flush[m2],
+                     t.flush[m3]});
+    out[i] = best;
+  }
+}
+
+#ifdef POKER_EVAL_X86
+
+/// Four hands per step: masks, keys and hashing in 128-bit lanes; the
+/// table loads stay scalar since SSE has no gather.
+POKER_EVAL_TARGET("sse4.2")
+void evaluateSse42(const StrengthTables &t, const core::CardSet *hands,
+                   size_t n, uint64_t board, HandStrength *out) {
+  const __m128i boardV = _mm_set1_epi64x(static_cast<long long>(board));
+  const __m128i rankMask = _mm_set1_epi32(0x1FFF);
+  const __m128i rowMul = _mm_set1_epi32(static_cast<int>(t.rowMultiplier));
+  const __m128i colMul = _mm_set1_epi32(static_cast<int>(t.colMultiplier));
+  const __m128i slotMask = _mm_set1_epi32(static_cast<int>(kSlotMask));
+
+  alignas(16) uint32_t m[4][4];
+  alignas(16) uint32_t lane[4];
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i a = _mm_or_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(hands + i)), boardV);
+    __m128i b = _mm_or_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(hands + i + 2)),
+        boardV);
+    __m128i lo = _mm_castps_si128(_mm_shuffle_ps(
+        _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+    __m128i hi = _mm_castps_si128(_mm_shuffle_ps(
+        _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+    _mm_store_si128(reinterpret_cast<__m128i *>(m[0]),
+                    _mm_and_si128(lo, rankMask));
+    _mm_store_si128(reinterpret_cast<__m128i *>(m[1]),
+                    _mm_and_si128(_mm_srli_epi32(lo, 16), rankMask));
+    _mm_store_si128(reinterpret_cast<__m128i *>(m[2]),
+                    _mm_and_si128(hi, rankMask));
+    _mm_store_si128(reinterpret_cast<__m128i *>(m[3]),
+                    _mm_and_si128(_mm_srli_epi32(hi, 16), rankMask));
+
+    __m128i flush = _mm_setzero_si128();
+    for (size_t s = 0; s < 4; ++s) {
+      flush = _mm_max_epu32(
+          flush, _mm_setr_epi32(t.flush[m[s][0]], t.flush[m[s][1]],
+                                t.flush[m[s][2]], t.flush[m[s][3]]));
+    }
+
+    for (size_t j = 0; j < 4; ++j) {
+      lane[j] = t.maskKey[m[0][j]] + t.maskKey[m[1][j]] + t.maskKey[m[2][j]] +
+                t.maskKey[m[3][j]];
+    }
+    __m128i key = _mm_load_si128(reinterpret_cast<const __m128i *>(lane));
+    __m128i row = _mm_srli_epi32(_mm_mullo_epi32(key, rowMul), 32 - kRowBits);
+    __m128i col = _mm_srli_epi32(_mm_mullo_epi32(key, colMul), 32 - kSlotBits);
+
+    _mm_store_si128(reinterpret_cast<__m128i *>(lane), row);
+    __m128i offset = _mm_setr_epi32(
+        static_cast<int>(t.rowOffsets[lane[0]]),
+        static_cast<int>(t.rowOffsets[lane[1]]),
+        static_cast<int>(t.rowOffsets[lane[2]]),
+        static_cast<int>(t.rowOffsets[lane[3]]));
+    __m128i slot = _mm_and_si128(_mm_add_epi32(col, offset), slotMask);
+
+    _mm_store_si128(reinterpret_cast<__m128i *>(lane), slot);
+    __m128i value = _mm_setr_epi32(t.slots[lane[0]], t.slots[lane[1]],
+                                   t.slots[lane[2]], t.slots[lane[3]]);
+
+    __m128i best = _mm_max_epu32(value, flush);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i),
+                     _mm_packus_epi32(best, best));
+  }
+  evaluateScalar(t, hands + i, n - i, board, out + i);
+}
+
+/// Gather a uint16 table entry per 32-bit lane (tables carry one spare
+/// entry, so the 4-byte read at a 2-byte scale stays in bounds).
+POKER_EVAL_TARGET("avx2")
+inline __m256i gather16(const HandStrength *table, __m256i index) {
+  return _mm256_and_si256(
+      _mm256_i32gather_epi32(reinterpret_cast<const int *>(table), index, 2),
+      _mm256_set1_epi32(0xFFFF));
+}
+
+/// Eight hands per step with every table load done by hardware gathers.
+POKER_EVAL_TARGET("avx2")
+void evaluateAvx2(const StrengthTables &t, const core::CardSet *hands,
+                  size_t n, uint64_t board, HandStrength *out) {
+  const __m256i boardV = _mm256_set1_epi64x(static_cast<long long>(board));
+  const __m256i rankMask = _mm256_set1_epi32(0x1FFF);
+  const __m256i rowMul =
+      _mm256_set1_epi32(static_cast<int>(t.rowMultiplier));
+  const __m256i colMul =
+      _mm256_set1_epi32(static_cast<int>(t.colMultiplier));
+  const __m256i slotMask = _mm256_set1_epi32(static_cast<int>(kSlotMask));
+  const int *maskKey = reinterpret_cast<const int *>(t.maskKey.data());
+  const int *rowOffsets = reinterpret_cast<const int *>(t.rowOffsets.data());
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i a = _mm256_or_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hands + i)),
+        boardV);
+    __m256i b = _mm256_or_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hands + i + 4)),
+        boardV);
+    // Split each 64-bit hand into its low (hearts, diamonds) and high
+    // (clubs, spades) halves, restoring hand order across 128-bit lanes.
+    __m256i lo = _mm256_castps_si256(_mm256_shuffle_ps(
+        _mm256_castsi256_ps(a), _mm256_castsi256_ps(b),
+        _MM_SHUFFLE(2, 0, 2, 0)));
+    __m256i hi = _mm256_castps_si256(_mm256_shuffle_ps(
+        _mm256_castsi256_ps(a), _mm256_castsi256_ps(b),
+        _MM_SHUFFLE(3, 1, 3, 1)));
+    lo = _mm256_permute4x64_epi64(lo, _MM_SHUFFLE(3, 1, 2, 0));
+    hi = _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(3, 1, 2, 0));
+
+    __m256i m0 = _mm256_and_si256(lo, rankMask);
+    __m256i m1 = _mm256_and_si256(_mm256_srli_epi32(lo, 16), rankMask);
+    __m256i m2 = _mm256_and_si256(hi, rankMask);
+    __m256i m3 = _mm256_and_si256(_mm256_srli_epi32(hi, 16), rankMask);
+
+    __m256i key = _mm256_add_epi32(
+        _mm256_add_epi32(_mm256_i32gather_epi32(maskKey, m0, 4),
+                         _mm256_i32gather_epi32(maskKey, m1, 4)),
+        _mm256_add_epi32(_mm256_i32gather_epi32(maskKey, m2, 4),
+                         _mm256_i32gather_epi32(maskKey, m3, 4)));
+    __m256i flush = _mm256_max_epu32(
+        _mm256_max_epu32(gather16(t.flush.data(), m0),
+                         gather16(t.flush.data(), m1)),
+        _mm256_max_epu32(gather16(t.flush.data(), m2),
+                         gather16(t.flush.data(), m3)));
+
+    __m256i row =
+        _mm256_srli_epi32(_mm256_mullo_epi32(key, rowMul), 32 - kRowBits);
+    __m256i col =
+        _mm256_srli_epi32(_mm256_mullo_epi32(key, colMul), 32 - kSlotBits);
+    __m256i slot = _mm256_and_si256(
+        _mm256_add_epi32(col, _mm256_i32gather_epi32(rowOffsets, row, 4)),
+        slotMask);
+
+    __m256i best = _mm256_max_epu32(gather16(t.slots.data(), slot), flush);
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(best, best),
+                                              _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     _mm256_castsi256_si128(packed));
+  }
+  evaluateScalar(t, hands + i, n - i, board, out + i);
+}
+
+#endif // POKER_EVAL_X86
+
+} // anonymous namespace
+
+bool HandEvaluator::isKernelSupported(EvalKernel kernel) noexcept {
+  switch (kernel) {
+  case EvalKernel::Scalar:
+    return true;
+#if defined(POKER_EVAL_X86) && (defined(__GNUC__) || defined(__clang__))
+  case EvalKernel::SSE42:
+    return __builtin_cpu_supports("sse4.2");
+  case EvalKernel::AVX2:
+    return __builtin_cpu_supports("avx2");
+#else
+  case EvalKernel::SSE42:
+  case EvalKernel::AVX2:
+    return false;
+#endif
+  }
+  return false;
+}
+
+EvalKernel HandEvaluator::bestKernel() noexcept {
+  static const EvalKernel best = [] {
+    if (isKernelSupported(EvalKernel::AVX2))
+      return EvalKernel::AVX2;
+    if (isKernelSupported(EvalKernel::SSE42))
+      return EvalKernel::SSE42;
+    return EvalKernel::Scalar;
+  }();
+  return best;
+}
+
+std::string HandEvaluator::kernelName(EvalKernel kernel) {
+  switch (kernel) {
+  case EvalKernel::Scalar:
+    return "scalar";
+  case EvalKernel::SSE42:
+    return "sse4.2";
+  case EvalKernel::AVX2:
+    return "avx2";
+  }
+  return "unknown";
+}
+
+void HandEvaluator::evaluateBatch(std::span<const core::CardSet> hands,
+                                  std::span<HandStrength> out,
+                                  EvalKernel kernel) {
+  evaluateBatch(core::CardSet(), hands, out, kernel);
+}
+
+void HandEvaluator::evaluateBatch(core::CardSet board,
+                                  std::span<const core::CardSet> hands,
+                                  std::span<HandStrength> out,
+                                  EvalKernel kernel) {
+  if (out.size() < hands.size()) {
+    throw std::invalid_argument(
+        "HandEvaluator::evaluateBatch output is smaller than input");
+  }
+  if (!isKernelSupported(kernel)) {
+    throw std::invalid_argument("HandEvaluator::evaluateBatch kernel " +
+                                kernelName(kernel) + " is not supported");
+  }
+
+  const auto &t = detail::strengthTables();
+  switch (kernel) {
+#ifdef POKER_EVAL_X86
+  case EvalKernel::AVX2:
+    evaluateAvx2(t, hands.data(), hands.size(), board.bits(), out.data());
+    return;
+  case EvalKernel::SSE42:
+    evaluateSse42(t, hands.data(), hands.size(), board.bits(), out.data());
+    return;
+#endif
+  default:
+    evaluateScalar(t, hands.data(), hands.size(), board.bits(), out.data());
+    return;
+  }
+}
+
+} // namespace poker::utils
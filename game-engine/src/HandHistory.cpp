@@ -0,0 +1,440 @@
+#include "engine/HandHistory.h"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace poker::engine {
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'K', 'R', 'H', 'I', 'S', 'T', '\0'};
+constexpr uint8_t kNoCard = 0xFF;
+constexpr uint64_t kHasAmount = 0x8;
+constexpr uint64_t kMaxAmount =
+    static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+constexpr size_t kMaxVarintBytes = 10;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+static_assert(sizeof(Header) == hand_history::kHeaderSize);
+
+/// LEB128-encode `value` into `out`; returns the bytes used.
+size_t putVarint(uint8_t *out, uint64_t value) noexcept {
+  size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = static_cast<uint8_t>(value);
+  return n;
+}
+
+void putVarint(std::vector<uint8_t> &out, uint64_t value) {
+  uint8_t bytes[kMaxVarintBytes];
+  out.insert(out.end(), bytes, bytes + putVarint(bytes, value));
+}
+
+uint64_t zigzag(int64_t value) noexcept {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) noexcept {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+uint64_t checkedAmount(int64_t amount) {
+  if (amount < 0) {
+    throw std::invalid_argument("HandHistory: amounts cannot be negative");
+  }
+  return static_cast<uint64_t>(amount);
+}
+
+[[noreturn]] void corrupt() {
+  throw std::runtime_error("HandHistory: corrupt record");
+}
+
+/// Bounds-checked cursor over encoded bytes.
+class ByteReader {
+public:
+  ByteReader(const uint8_t *pos, const uint8_t *end) noexcept
+      : pos_(pos), end_(end) {}
+
+  uint8_t byte() {
+    if (pos_ == end_)
+      corrupt();
+    return *pos_++;
+  }
+
+  uint64_t varint() {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 7 * kMaxVarintBytes; shift += 7) {
+      const uint8_t b = byte();
+      value |= static_cast<uint64_t>(b & 0x7F) << shift;
+      if (b < 0x80)
+        return value;
+    }
+    corrupt();
+  }
+
+  /// A varint that must not exceed `max`.
+  uint64_t varint(uint64_t max) {
+    const uint64_t value = varint();
+    if (value > max)
+      corrupt();
+    return value;
+  }
+
+  core::Card card() {
+    const uint8_t bit = byte();
+    if (bit >= 64 || !((core::CardSet::kFullDeckBits >> bit) & 1))
+      corrupt();
+    return core::CardSet::fromBitIndex(bit);
+  }
+
+  [[nodiscard]] const uint8_t *position() const noexcept { return pos_; }
+  [[nodiscard]] bool atEnd() const noexcept { return pos_ == end_; }
+
+private:
+  const uint8_t *pos_;
+  const uint8_t *end_;
+};
+
+/// Walk the length prefixes of the records in [begin, end), counting them
+/// in `hands`, and return where the last complete one ends.
+const uint8_t *completeRecordsEnd(const uint8_t *begin, const uint8_t *end,
+                                  size_t &hands) noexcept {
+  ByteReader in(begin, end);
+  hands = 0;
+  try {
+    while (!in.atEnd()) {
+      const uint64_t length =
+          in.varint(static_cast<uint64_t>(end - in.position()));
+      ByteReader body(in.position(), in.position() + length);
+      (void)body.varint(); // The iterator reads the hand id eagerly.
+      in = ByteReader(in.position() + length, end);
+      begin = in.position();
+      ++hands;
+    }
+  } catch (const std::runtime_error &) {
+    // `begin` is still the end of the last record that parsed.
+  }
+  return begin;
+}
+
+} // anonymous namespace
+
+// --- Encoding ---
+
+namespace hand_history {
+
+void encode(const HandRecord &record, std::vector<uint8_t> &out) {
+  const size_t seats = record.numSeats();
+  if (seats > core::kMaxSeats || record.holeCards.size() != seats ||
+      record.finalStacks.size() != seats || (seats && record.dealer >= seats)) {
+    throw std::invalid_argument(
+        "HandHistory: per-seat fields must agree and fit 64 seats");
+  }
+  if (record.board.size() > 5) {
+    throw std::invalid_argument("HandHistory: board has at most 5 cards");
+  }
+
+  // Encode the body after room for the longest length prefix, then slide
+  // it down once its length is known. A rejected field drops the partial
+  // record again.
+  const size_t start = out.size();
+  out.resize(start + kMaxVarintBytes);
+  const size_t bodyStart = out.size();
+  try {
+    putVarint(out, record.handId);
+    putVarint(out, seats);
+    putVarint(out, record.dealer);
+    putVarint(out, checkedAmount(record.smallBlind));
+    putVarint(out, checkedAmount(record.bigBlind));
+    for (int64_t stack : record.startingStacks)
+      putVarint(out, checkedAmount(stack));
+    for (core::CardSet hole : record.holeCards) {
+      if (!hole.empty() && hole.size() != 2) {
+        throw std::invalid_argument("HandHistory: hole cards must be 0 or 2");
+      }
+      std::array<uint8_t, 2> cards = {kNoCard, kNoCard};
+      size_t i = 0;
+      for (core::Card c : hole)
+        cards[i++] = static_cast<uint8_t>(core::CardSet::bitIndex(c));
+      out.insert(out.end(), cards.begin(), cards.end());
+    }
+    out.push_back(static_cast<uint8_t>(record.board.size()));
+    for (core::Card c : record.board)
+      out.push_back(static_cast<uint8_t>(core::CardSet::bitIndex(c)));
+
+    putVarint(out, record.actions.size());
+    for (const core::Action &a : record.actions) {
+      if (a.playerId >= seats) {
+        throw std::invalid_argument("HandHistory: action by an unknown seat");
+      }
+      const uint64_t amount = checkedAmount(a.amount);
+      putVarint(out, (uint64_t{a.playerId} << 4) | (amount ? kHasAmount : 0) |
+                         static_cast<uint64_t>(a.type));
+      if (amount)
+        putVarint(out, amount);
+    }
+    for (size_t s = 0; s < seats; ++s) {
+      checkedAmount(record.finalStacks[s]);
+      putVarint(out, zigzag(record.finalStacks[s] - record.startingStacks[s]));
+    }
+  } catch (...) {
+    out.resize(start);
+    throw;
+  }
+
+  uint8_t prefix[kMaxVarintBytes];
+  const size_t prefixBytes = putVarint(prefix, out.size() - bodyStart);
+  std::memmove(out.data() + start + prefixBytes, out.data() + bodyStart,
+               out.size() - bodyStart);
+  std::memcpy(out.data() + start, prefix, prefixBytes);
+  out.resize(out.size() - (kMaxVarintBytes - prefixBytes));
+}
+
+void decode(std::span<const uint8_t> body, HandRecord &record) {
+  ByteReader in(body.data(), body.data() + body.size());
+  record.handId = in.varint();
+  const auto seats = static_cast<size_t>(in.varint(core::kMaxSeats));
+  record.dealer = static_cast<size_t>(in.varint(seats ? seats - 1 : 0));
+  record.smallBlind = static_cast<int64_t>(in.varint(kMaxAmount));
+  record.bigBlind = static_cast<int64_t>(in.varint(kMaxAmount));
+
+  record.startingStacks.resize(seats);
+  for (auto &stack : record.startingStacks)
+    stack = static_cast<int64_t>(in.varint(kMaxAmount));
+
+  record.holeCards.resize(seats);
+  for (auto &hole : record.holeCards) {
+    ByteReader peek = in;
+    if (peek.byte() == kNoCard && peek.byte() == kNoCard) {
+      hole = core::CardSet();
+      in = peek;
+      continue;
+    }
+    hole = core::CardSet::of(in.card());
+    const core::Card second = in.card();
+    if (hole.contains(second))
+      corrupt();
+    hole.insert(second);
+  }
+
+  const uint8_t boardCount = in.byte();
+  if (boardCount > 5)
+    corrupt();
+  record.board.resize(boardCount);
+  for (auto &card : record.board)
+    card = in.card();
+
+  // Each action takes at least one byte, which bounds a sane count.
+  const auto numActions = static_cast<size_t>(in.varint(body.size()));
+  record.actions.resize(numActions);
+  for (auto &action : record.actions) {
+    const uint64_t tag = in.varint();
+    const uint64_t type = tag & 0x7;
+    const uint64_t seat = tag >> 4;
+    if (type > static_cast<uint64_t>(core::ActionType::AllIn) || seat >= seats)
+      corrupt();
+    const uint64_t amount = (tag & kHasAmount) ? in.varint(kMaxAmount) : 0;
+    action = core::Action(static_cast<core::ActionType>(type),
+                          static_cast<int64_t>(amount),
+                          static_cast<size_t>(seat));
+  }
+
+  record.finalStacks.resize(seats);
+  for (size_t s = 0; s < seats; ++s) {
+    record.finalStacks[s] = static_cast<int64_t>(
+        static_cast<uint64_t>(record.startingStacks[s]) +
+        static_cast<uint64_t>(unzigzag(in.varint())));
+    if (record.finalStacks[s] < 0)
+      corrupt();
+  }
+  if (!in.atEnd())
+    corrupt();
+}
+
+} // namespace hand_history
+
+// --- Writing ---
+
+HandHistoryWriter::HandHistoryWriter(const std::string &path,
+                                     uint64_t firstHandId)
+    : path_(path), nextHandId_(firstHandId) {
+  Header header{};
+  std::ifstream existing(path, std::ios::binary);
+  existing.read(reinterpret_cast<char *>(&header), sizeof(Header));
+  const auto headerBytes = static_cast<size_t>(existing.gcount());
+  existing.close();
+  if (headerBytes == sizeof(Header)) {
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+      throw std::runtime_error("HandHistory: not a hand history: " + path);
+    }
+    if (header.version != hand_history::kVersion) {
+      throw std::runtime_error("HandHistory: unsupported version " +
+                               std::to_string(header.version));
+    }
+    // A crash mid-write can leave a torn last record; cut it off, or the
+    // hands appended after it could never be read back.
+    size_t complete = 0;
+    {
+      const utils::MappedFile file = utils::MappedFile::open(
+          path, "HandHistory", utils::MapAccess::Sequential);
+      const auto *data = reinterpret_cast<const uint8_t *>(file.data());
+      size_t hands = 0;
+      complete = static_cast<size_t>(
+          completeRecordsEnd(data + sizeof(Header), data + file.size(),
+                             hands) -
+          data);
+      if (complete == file.size())
+        complete = 0;
+    }
+    if (complete != 0) {
+      std::error_code error;
+      std::filesystem::resize_file(path, complete, error);
+      if (error) {
+        throw std::runtime_error("HandHistory: cannot truncate " + path);
+      }
+    }
+  } else if (headerBytes != 0) {
+    throw std::runtime_error("HandHistory: truncated file " + path);
+  } else {
+    // New (or empty) file: start it with a header.
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = hand_history::kVersion;
+    std::ofstream create(path, std::ios::binary | std::ios::trunc);
+    create.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    if (!create) {
+      throw std::runtime_error("HandHistory: cannot create " + path);
+    }
+  }
+  out_.open(path, std::ios::binary | std::ios::app);
+  if (!out_) {
+    throw std::runtime_error("HandHistory: cannot open " + path);
+  }
+  buffer_.reserve(kBufferBytes + 1024);
+}
+
+HandHistoryWriter::~HandHistoryWriter() {
+  try {
+    flush();
+  } catch (...) {
+    // Destructors must not throw; call flush() to see write errors.
+  }
+}
+
+void HandHistoryWriter::append(const HandRecord &record) {
+  const size_t before = buffer_.size();
+  hand_history::encode(record, buffer_);
+  bytes_ += buffer_.size() - before;
+  ++hands_;
+  if (buffer_.size() >= kBufferBytes)
+    flush();
+}
+
+void HandHistoryWriter::onEvent(const HandEvent &event,
+                                const core::GameState &state) {
+  if (std::holds_alternative<HandStarted>(event)) {
+    // Blinds are not posted yet, so the stacks are the starting ones.
+    const auto &players = state.getPlayers();
+    pending_.dealer = state.getDealerPosition();
+    pending_.smallBlind = state.getSmallBlind();
+    pending_.bigBlind = state.getBigBlind();
+    pending_.startingStacks.resize(players.size());
+    for (size_t i = 0; i < players.size(); ++i)
+      pending_.startingStacks[i] = players[i].getChips();
+    inHand_ = true;
+  } else if (std::holds_alternative<HandEnded>(event) && inHand_) {
+    const auto &players = state.getPlayers();
+    pending_.handId = nextHandId_++;
+    pending_.holeCards.resize(players.size());
+    pending_.finalStacks.resize(players.size());
+    for (size_t i = 0; i < players.size(); ++i) {
+      pending_.holeCards[i] = players[i].getHoleCardSet();
+      pending_.finalStacks[i] = players[i].getChips();
+    }
+    const auto &board = state.getCommunityCards();
+    pending_.board.assign(board.begin(), board.end());
+    const auto &actions = state.getActionHistory();
+    pending_.actions.assign(actions.begin(), actions.end());
+    inHand_ = false;
+    append(pending_);
+  }
+}
+
+void HandHistoryWriter::flush() {
+  if (buffer_.empty())
+    return;
+  out_.write(reinterpret_cast<const char *>(buffer_.data()),
+             static_cast<std::streamsize>(buffer_.size()));
+  out_.flush();
+  buffer_.clear();
+  if (!out_) {
+    throw std::runtime_error("HandHistory: cannot write " + path_);
+  }
+}
+
+// --- Reading ---
+
+HandHistoryReader HandHistoryReader::open(const std::string &path) {
+  HandHistoryReader reader;
+  // Hands are read front to back.
+  reader.file_ = utils::MappedFile::open(path, "HandHistory",
+                                         utils::MapAccess::Sequential);
+  const auto *data = reinterpret_cast<const uint8_t *>(reader.file_.data());
+  const size_t size = reader.file_.size();
+
+  if (size < sizeof(Header)) {
+    throw std::runtime_error("HandHistory: truncated file " + path);
+  }
+  Header header;
+  std::memcpy(&header, data, sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("HandHistory: not a hand history: " + path);
+  }
+  if (header.version != hand_history::kVersion) {
+    throw std::runtime_error("HandHistory: unsupported version " +
+                             std::to_string(header.version));
+  }
+
+  // Walk the length prefixes so iteration can trust them.
+  const uint8_t *end = data + size;
+  if (completeRecordsEnd(data + sizeof(Header), end, reader.numHands_) !=
+      end) {
+    throw std::runtime_error("HandHistory: truncated or corrupt file " + path);
+  }
+  reader.records_ = data + sizeof(Header);
+  reader.end_ = end;
+  reader.fileSize_ = size;
+  return reader;
+}
+
+HandHistoryReader::HandHistoryReader(HandHistoryReader &&other) noexcept {
+  *this = std::move(other);
+}
+
+HandHistoryReader &
+HandHistoryReader::operator=(HandHistoryReader &&other) noexcept {
+  if (this != &other) {
+    file_ = std::move(other.file_);
+    records_ = std::exchange(other.records_, nullptr);
+    end_ = std::exchange(other.end_, nullptr);
+    numHands_ = std::exchange(other.numHands_, 0);
+    fileSize_ = std::exchange(other.fileSize_, 0);
+  }
+  return *this;
+}
+
+HandHistoryReader::~HandHistoryReader() = default;
+
+} // namespace poker::engine
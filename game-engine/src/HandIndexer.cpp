@@ -0,0 +1,286 @@
+#include "utils/HandIndexer.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace poker::utils {
+
+namespace {
+
+constexpr unsigned kNumRanks = 13;
+constexpr unsigned kNumSuits = 4;
+
+/// Binomial coefficients C(n, k) for n, k <= 13.
+constexpr auto kChoose = [] {
+  std::array<std::array<uint32_t, kNumRanks + 1>, kNumRanks + 1> c{};
+  for (unsigned n = 0; n <= kNumRanks; ++n) {
+    c[n][0] = 1;
+    for (unsigned k = 1; k <= n; ++k)
+      c[n][k] = c[n - 1][k - 1] + (k < n ? c[n - 1][k] : 0);
+  }
+  return c;
+}();
+
+/// Per 13-bit rank mask: its colex rank among the masks with as many bits
+/// (the sum of C(position, i) over its bits, lowest first, i from 1) in the
+/// low 12 bits and that number of bits above, so no popcount is needed.
+constexpr auto kColex = [] {
+  std::array<uint16_t, 1u << kNumRanks> table{};
+  for (uint32_t mask = 0; mask < table.size(); ++mask) {
+    uint32_t r = 0;
+    unsigned i = 1;
+    for (unsigned pos = 0; pos < kNumRanks; ++pos) {
+      if (mask >> pos & 1)
+        r += kChoose[pos][i++];
+    }
+    table[mask] = static_cast<uint16_t>(r | (i - 1) << 12);
+  }
+  return table;
+}();
+
+constexpr unsigned colexRank(uint32_t mask) noexcept {
+  return kColex[mask] & 0xFFF;
+}
+constexpr unsigned bitCount(uint32_t mask) noexcept {
+  return kColex[mask] >> 12;
+}
+
+/// C(n, k) for the small k of multiset ranking (k <= 4). The divisors are
+/// constants, so this compiles to multiplications.
+constexpr uint64_t choose(uint64_t n, unsigned k) noexcept {
+  if (n < k)
+    return 0;
+  switch (k) {
+  case 0:
+    return 1;
+  case 1:
+    return n;
+  case 2:
+    return n * (n - 1) / 2;
+  case 3:
+    return n * (n - 1) * (n - 2) / 6;
+  default:
+    return n * (n - 1) * (n - 2) * (n - 3) / 24;
+  }
+}
+
+/// Multisets of m values below s.
+constexpr uint64_t multisets(uint64_t s, unsigned m) noexcept {
+  return choose(s + m - 1, m);
+}
+
+/// A suit's counts are packed as hole * 6 + board (kShapeRadix).
+constexpr unsigned holeOf(uint8_t count) noexcept { return count / 6; }
+constexpr unsigned boardOf(uint8_t count) noexcept { return count % 6; }
+
+/// Ways one suit can hold `count` (hole and board) cards.
+constexpr uint64_t suitSize(uint8_t count) noexcept {
+  const unsigned h = holeOf(count);
+  return uint64_t{kChoose[kNumRanks][h]} *
+         kChoose[kNumRanks - h][boardOf(count)];
+}
+
+/// Delete the bit positions of `holes` from `mask` (they are clear in it).
+constexpr uint32_t compress(uint32_t mask, uint32_t holes) noexcept {
+  while (holes) {
+    const unsigned r = 31 - static_cast<unsigned>(std::countl_zero(holes));
+    mask = (mask & ((1u << r) - 1)) | ((mask >> (r + 1)) << r);
+    holes &= ~(1u << r);
+  }
+  return mask;
+}
+
+/// Inverse of compress(): open a clear bit at each position of `holes`.
+constexpr uint32_t expand(uint32_t mask, uint32_t holes) noexcept {
+  while (holes) {
+    const unsigned r = static_cast<unsigned>(std::countr_zero(holes));
+    mask = (mask & ((1u << r) - 1)) | ((mask >> r) << (r + 1));
+    holes &= holes - 1;
+  }
+  return mask;
+}
+
+/// The k-bit mask below 1 << n with colex rank r.
+uint32_t colexUnrank(uint32_t r, unsigned k, unsigned n) noexcept {
+  uint32_t mask = 0;
+  for (; k > 0; --k) {
+    unsigned pos = n;
+    while (kChoose[--pos][k] > r) {
+    }
+    mask |= 1u << pos;
+    r -= kChoose[pos][k];
+    n = pos;
+  }
+  return mask;
+}
+
+/// Rank of one suit's cards among suitSize() possibilities.
+inline uint64_t suitIndex(uint32_t hole, uint32_t board) noexcept {
+  return uint64_t{colexRank(hole)} *
+             kChoose[kNumRanks - bitCount(hole)][bitCount(board)] +
+         colexRank(compress(board, hole));
+}
+
+} // anonymous namespace
+
+HandIndexer::HandIndexer(size_t boardCards) : boardCards_(boardCards) {
+  if (boardCards != 0 && (boardCards < 3 || boardCards > 5)) {
+    throw std::invalid_argument("HandIndexer: board of " +
+                                std::to_string(boardCards) + " cards");
+  }
+  configurationOf_.fill(kNoConfiguration);
+
+  // Every descending shape whose counts add up to the hand.
+  constexpr uint8_t kCounts = 3 * kShapeRadix;
+  Shape shape{};
+  for (shape[0] = 0; shape[0] < kCounts; ++shape[0]) {
+    for (shape[1] = 0; shape[1] <= shape[0]; ++shape[1]) {
+      for (shape[2] = 0; shape[2] <= shape[1]; ++shape[2]) {
+        for (shape[3] = 0; shape[3] <= shape[2]; ++shape[3]) {
+          size_t holes = 0, boards = 0;
+          for (uint8_t count : shape) {
+            holes += holeOf(count);
+            boards += boardOf(count);
+          }
+          if (holes != kHoleCards || boards != boardCards_)
+            continue;
+          Configuration config{size_, shape, {}, {}};
+          uint64_t count = 1;
+          for (size_t i = 0; i < kNumSuits;) {
+            size_t j = i;
+            while (j < kNumSuits && shape[j] == shape[i])
+              ++j;
+            config.group[i] = static_cast<uint8_t>(j - i);
+            config.radix[i] =
+                multisets(suitSize(shape[i]), static_cast<unsigned>(j - i));
+            count *= config.radix[i];
+            i = j;
+          }
+          configurationOf_[shapeRank(shape)] =
+              static_cast<uint16_t>(configurations_.size());
+          configurations_.push_back(config);
+          size_ += count;
+        }
+      }
+    }
+  }
+}
+
+const HandIndexer &HandIndexer::forStreet(core::Street street) {
+  static const std::array<HandIndexer, 4> kIndexers = {
+      HandIndexer(0), HandIndexer(3), HandIndexer(4), HandIndexer(5)};
+  const auto s = static_cast<size_t>(street);
+  if (s >= kIndexers.size()) {
+    throw std::invalid_argument("HandIndexer: no cards to index at showdown");
+  }
+  return kIndexers[s];
+}
+
+size_t HandIndexer::shapeRank(const Shape &shape) noexcept {
+  return static_cast<size_t>(choose(shape[0] + 3u, 4) +
+                             choose(shape[1] + 2u, 3) +
+                             choose(shape[2] + 1u, 2) + shape[3]);
+}
+
+uint64_t HandIndexer::index(core::CardSet hole,
+                            core::CardSet board) const noexcept {
+  // Sort key per suit: its counts above its suit index, so a descending
+  // sort gives the canonical suit order.
+  std::array<uint64_t, kNumSuits> keys;
+  for (unsigned s = 0; s < kNumSuits; ++s) {
+    const auto suit = static_cast<core::Suit>(s);
+    const uint32_t h = hole.suitMask(suit);
+    const uint32_t b = board.suitMask(suit);
+    const uint64_t count = bitCount(h) * kShapeRadix + bitCount(b);
+    keys[s] = count << 32 | suitIndex(h, b);
+  }
+  // Sorting network with min/max, which compile to conditional moves.
+  auto order = [&](size_t i, size_t j) {
+    const uint64_t a = keys[i], b = keys[j];
+    keys[i] = std::max(a, b);
+    keys[j] = std::min(a, b);
+  };
+  order(0, 1);
+  order(2, 3);
+  order(0, 2);
+  order(1, 3);
+  order(1, 2);
+
+  Shape shape;
+  for (size_t i = 0; i < kNumSuits; ++i)
+    shape[i] = static_cast<uint8_t>(keys[i] >> 32);
+  const Configuration &config =
+      configurations_[configurationOf_[shapeRank(shape)]];
+  uint64_t index = 0;
+  for (size_t i = 0; i < kNumSuits; i += config.group[i]) {
+    // Multiset rank of the group's suit indices, largest first.
+    const unsigned m = config.group[i];
+    uint64_t rank = 0;
+    for (unsigned t = 0; t < m; ++t)
+      rank += choose((keys[i + t] & 0xFFFFFFFF) + m - 1 - t, m - t);
+    index = index * config.radix[i] + rank;
+  }
+  return config.offset + index;
+}
+
+void HandIndexer::unindex(uint64_t index, core::CardSet &hole,
+                          core::CardSet &board) const {
+  if (index >= size_) {
+    throw std::out_of_range("HandIndexer: index " + std::to_string(index) +
+                            " of " + std::to_string(size_));
+  }
+  const auto config =
+      std::upper_bound(configurations_.begin(), configurations_.end(), index,
+                       [](uint64_t i, const Configuration &c) {
+                         return i < c.offset;
+                       }) -
+      1;
+  const Shape &shape = config->shape;
+  uint64_t rest = index - config->offset;
+
+  // Groups were combined first to last, so they come apart last first.
+  std::array<uint64_t, kNumSuits> suits{};
+  for (size_t j = kNumSuits; j > 0;) {
+    size_t i = j - 1;
+    while (i > 0 && shape[i - 1] == shape[j - 1])
+      --i;
+    const auto m = static_cast<unsigned>(j - i);
+    const uint64_t size = suitSize(shape[i]);
+    const uint64_t count = multisets(size, m);
+    uint64_t rank = rest % count;
+    rest /= count;
+    for (unsigned t = 0; t < m; ++t) {
+      // Largest q with C(q, k) <= rank; the suit index is q - (k - 1).
+      const unsigned k = m - t;
+      uint64_t lo = k - 1, hi = size + k - 1;
+      while (hi - lo > 1) {
+        const uint64_t mid = (lo + hi) / 2;
+        (choose(mid, k) <= rank ? lo : hi) = mid;
+      }
+      suits[i + t] = lo - (k - 1);
+      rank -= choose(lo, k);
+    }
+    j = i;
+  }
+
+  hole.clear();
+  board.clear();
+  for (unsigned s = 0; s < kNumSuits; ++s) {
+    const unsigned h = holeOf(shape[s]);
+    const unsigned b = boardOf(shape[s]);
+    const uint64_t boards = kChoose[kNumRanks - h][b];
+    const uint32_t holeMask =
+        colexUnrank(static_cast<uint32_t>(suits[s] / boards), h, kNumRanks);
+    const uint32_t boardMask = expand(
+        colexUnrank(static_cast<uint32_t>(suits[s] % boards), b,
+                    kNumRanks - h),
+        holeMask);
+    const unsigned shift = s * core::CardSet::kBitsPerSuit;
+    hole |= core::CardSet(uint64_t{holeMask} << shift);
+    board |= core::CardSet(uint64_t{boardMask} << shift);
+  }
+}
+
+} // namespace poker::utils
@@ -0,0 +1,63 @@
+#pragma once
+
+// Internal lookup tables shared by the scalar and batched hand evaluators.
+
+#include "utils/HandEvaluator.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace poker::utils::detail {
+
+constexpr size_t kNumRanks = 13;
+constexpr size_t kNumMasks = size_t{1} << kNumRanks;
+
+/// Perfect hash geometry: rows pick a displacement, slots hold strengths.
+constexpr unsigned kRowBits = 13;
+constexpr unsigned kSlotBits = 17;
+constexpr uint32_t kSlotMask = (1u << kSlotBits) - 1;
+
+/// Strength tables. The uint16 tables carry one spare entry so that 32-bit
+/// vector gathers at a 2-byte scale never read past the end.
+struct StrengthTables {
+  /// Every distinct 5-card hand class, sorted weakest first.
+  std::vector<HandResult> classes;
+  /// Index of the first class of each category within `classes`.
+  std::array<uint16_t, 11> categoryStart = {};
+
+  /// Sum of the per-rank keys of the ranks set in a 13-bit mask.
+  std::array<uint32_t, kNumMasks> maskKey = {};
+  /// Best flush for a suit's rank mask; 0 when fewer than 5 cards.
+  std::array<HandStrength, kNumMasks + 1> flush = {};
+
+  /// Row and column multipliers of the perfect hash (32-bit products).
+  uint32_t rowMultiplier = 0;
+  uint32_t colMultiplier = 0;
+  std::vector<uint32_t> rowOffsets;
+  std::vector<HandStrength> slots;
+
+  [[nodiscard]] HandStrength strengthOf(const HandResult &r) const;
+
+  [[nodiscard]] uint32_t slotOf(uint32_t key) const noexcept {
+    uint32_t row = (key * rowMultiplier) >> (32 - kRowBits);
+    uint32_t col = (key * colMultiplier) >> (32 - kSlotBits);
+    return (col + rowOffsets[row]) & kSlotMask;
+  }
+
+  [[nodiscard]] HandStrength
+  lookup(const std::array<uint32_t, 4> &suitMasks) const noexcept {
+    for (uint32_t m : suitMasks) {
+      if (std::popcount(m) >= 5)
+        return flush[m];
+    }
+    return slots[slotOf(maskKey[suitMasks[0]] + maskKey[suitMasks[1]] +
+                        maskKey[suitMasks[2]] + maskKey[suitMasks[3]])];
+  }
+};
+
+/// Lazily built, process-wide tables.
+const StrengthTables &strengthTables();
+
+} // namespace poker::utils::detail
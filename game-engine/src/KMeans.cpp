@@ -0,0 +1,202 @@
+#include "utils/KMeans.h"
+#include "core/Random.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace poker::utils {
+
+namespace {
+
+/// Points per unit of parallel work in the assignment pass.
+constexpr size_t kBlock = 4096;
+
+/// Most doubles the update pass's per-block partial sums may take.
+constexpr size_t kPartialBudget = size_t{1} << 22;
+
+float squaredDistance(const float *a, const float *b, size_t dims) noexcept {
+  float d = 0.0f;
+  for (size_t j = 0; j < dims; ++j) {
+    const float diff = a[j] - b[j];
+    d += diff * diff;
+  }
+  return d;
+}
+
+/// Uniform double in [0, 1).
+double uniform(core::PhiloxGenerator &rng) noexcept {
+  return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+}
+
+/// k-means++ on a sample: each centre is drawn with probability
+/// proportional to weight times squared distance to the nearest one so far.
+std::vector<float> seedCenters(std::span<const float> points, size_t dims,
+                               std::span<const float> weights,
+                               const KMeansOptions &options) {
+  const size_t n = points.size() / dims;
+  core::PhiloxGenerator rng(options.seed);
+  std::vector<size_t> sample;
+  if (n <= options.seedSample) {
+    for (size_t i = 0; i < n; ++i)
+      sample.push_back(i);
+  } else {
+    for (size_t i = 0; i < options.seedSample; ++i)
+      sample.push_back(static_cast<size_t>(rng() % n));
+  }
+  auto weight = [&](size_t i) {
+    return weights.empty() ? 1.0 : static_cast<double>(weights[i]);
+  };
+  auto row = [&](size_t i) { return points.data() + i * dims; };
+
+  std::vector<float> centers;
+  centers.reserve(options.clusters * dims);
+  std::vector<double> nearest(sample.size(),
+                              std::numeric_limits<double>::infinity());
+  while (centers.size() < options.clusters * dims) {
+    double total = 0.0;
+    for (size_t s = 0; s < sample.size(); ++s) {
+      if (centers.empty())
+        nearest[s] = 1.0;
+      total += weight(sample[s]) * nearest[s];
+    }
+    size_t pick = static_cast<size_t>(rng() % sample.size());
+    if (total > 0.0) {
+      double target = uniform(rng) * total;
+      for (pick = 0; pick + 1 < sample.size(); ++pick) {
+        target -= weight(sample[pick]) * nearest[pick];
+        if (target < 0.0)
+          break;
+      }
+    }
+    const float *center = row(sample[pick]);
+    centers.insert(centers.end(), center, center + dims);
+    for (size_t s = 0; s < sample.size(); ++s) {
+      nearest[s] = std::min(
+          nearest[s],
+          static_cast<double>(squaredDistance(row(sample[s]), center, dims)));
+    }
+  }
+  return centers;
+}
+
+} // anonymous namespace
+
+KMeans::KMeans(size_t numThreads) : pool_(numThreads) {}
+
+KMeansResult KMeans::fit(std::span<const float> points, size_t dims,
+                         std::span<const float> weights,
+                         const KMeansOptions &options) {
+  if (dims == 0 || points.size() % dims != 0) {
+    throw std::invalid_argument("KMeans: points must be rows of dims floats");
+  }
+  const size_t n = points.size() / dims;
+  const size_t k = options.clusters;
+  if (!weights.empty() && weights.size() != n) {
+    throw std::invalid_argument("KMeans: one weight per point");
+  }
+  if (k == 0 || k > n) {
+    throw std::invalid_argument("KMeans: need 1 to n clusters");
+  }
+
+  KMeansResult result;
+  result.centers = seedCenters(points, dims, weights, options);
+  result.assignment.assign(n, 0);
+  std::vector<float> distance(n);
+  const size_t blocks = (n + kBlock - 1) / kBlock;
+  std::vector<double> blockInertia(blocks);
+  std::vector<size_t> blockMoves(blocks);
+  std::vector<double> sums(k * dims);
+  std::vector<double> mass(k);
+  // The update pass sums each block's members into its own k x dims sums
+  // and k masses, then adds the blocks up in block order, so the centres
+  // do not depend on the thread count. Blocks are kBlock points, or more
+  // when that many partials would not fit in kPartialBudget.
+  const size_t stride = k * (dims + 1);
+  const size_t sumBlocks =
+      std::clamp<size_t>(kPartialBudget / stride, 1, blocks);
+  const size_t sumBlockSize = (n + sumBlocks - 1) / sumBlocks;
+  std::vector<double> partial(sumBlocks * stride);
+  auto weight = [&](size_t i) {
+    return weights.empty() ? 1.0 : static_cast<double>(weights[i]);
+  };
+
+  while (true) {
+    pool_.parallelFor(blocks, [&](size_t b, size_t) {
+      double inertia = 0.0;
+      size_t moves = 0;
+      const size_t end = std::min(n, (b + 1) * kBlock);
+      for (size_t i = b * kBlock; i < end; ++i) {
+        const float *p = points.data() + i * dims;
+        uint32_t best = 0;
+        float bestDistance = std::numeric_limits<float>::infinity();
+        for (size_t c = 0; c < k; ++c) {
+          const float d =
+              squaredDistance(p, result.centers.data() + c * dims, dims);
+          if (d < bestDistance) {
+            bestDistance = d;
+            best = static_cast<uint32_t>(c);
+          }
+        }
+        moves += best != result.assignment[i];
+        result.assignment[i] = best;
+        distance[i] = bestDistance;
+        inertia += weight(i) * bestDistance;
+      }
+      blockInertia[b] = inertia;
+      blockMoves[b] = moves;
+    });
+    size_t moves = 0;
+    result.inertia = 0.0;
+    for (size_t b = 0; b < blocks; ++b) {
+      result.inertia += blockInertia[b];
+      moves += blockMoves[b];
+    }
+    ++result.iterations;
+    if ((moves == 0 && result.iterations > 1) ||
+        result.iterations >= options.maxIterations)
+      break;
+
+    pool_.parallelFor(sumBlocks, [&](size_t b, size_t) {
+      double *blockSums = partial.data() + b * stride;
+      double *blockMass = blockSums + k * dims;
+      std::fill_n(blockSums, stride, 0.0);
+      const size_t end = std::min(n, (b + 1) * sumBlockSize);
+      for (size_t i = b * sumBlockSize; i < end; ++i) {
+        const double w = weight(i);
+        const size_t c = result.assignment[i];
+        blockMass[c] += w;
+        for (size_t j = 0; j < dims; ++j)
+          blockSums[c * dims + j] += w * points[i * dims + j];
+      }
+    });
+    pool_.parallelFor(k, [&](size_t c, size_t) {
+      double *centerSums = sums.data() + c * dims;
+      std::fill_n(centerSums, dims, 0.0);
+      mass[c] = 0.0;
+      for (size_t b = 0; b < sumBlocks; ++b) {
+        const double *blockSums = partial.data() + b * stride;
+        for (size_t j = 0; j < dims; ++j)
+          centerSums[j] += blockSums[c * dims + j];
+        mass[c] += blockSums[k * dims + c];
+      }
+    });
+    for (size_t c = 0; c < k; ++c) {
+      float *center = result.centers.data() + c * dims;
+      if (mass[c] > 0.0) {
+        for (size_t j = 0; j < dims; ++j)
+          center[j] = static_cast<float>(sums[c * dims + j] / mass[c]);
+        continue;
+      }
+      // Empty: move it onto the worst-fitting point.
+      const size_t far = static_cast<size_t>(
+          std::max_element(distance.begin(), distance.end()) -
+          distance.begin());
+      std::copy_n(points.data() + far * dims, dims, center);
+      distance[far] = 0.0f;
+    }
+  }
+  return result;
+}
+
+} // namespace poker::utils
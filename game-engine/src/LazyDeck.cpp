@@ -0,0 +1,23 @@
+#include "core/LazyDeck.h"
+
+namespace poker::core {
+
+void LazyDeck::reset(CardSet dead) {
+  size_ = 0;
+  dealt_ = 0;
+  for (unsigned i = 0; i < 52; ++i) {
+    const Card c = CardSet::fromIndex(i);
+    if (!dead.contains(c))
+      cards_[size_++] = c;
+  }
+}
+
+CardSet LazyDeck::remainingCards() const noexcept {
+  CardSet set;
+  for (size_t i = dealt_; i < size_; ++i) {
+    set.insert(cards_[i]);
+  }
+  return set;
+}
+
+} // namespace poker::core
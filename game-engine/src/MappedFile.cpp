@@ -0,0 +1,128 @@
+#include "utils/MappedFile.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace poker::utils {
+
+namespace {
+
+[[noreturn]] void fail(std::string_view owner, const char *what,
+                       const std::string &path) {
+  throw std::runtime_error(std::string(owner) + ": " + what + " " + path);
+}
+
+} // anonymous namespace
+
+MappedFile MappedFile::open(const std::string &path, std::string_view owner,
+                            MapAccess access) {
+  MappedFile file;
+#if defined(_WIN32)
+  // No shared mapping here; fall back to a private copy.
+  (void)access;
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    fail(owner, "cannot open", path);
+  }
+  std::vector<char> bytes((std::istreambuf_iterator<char>(in)),
+                          std::istreambuf_iterator<char>());
+  file.buffer_.resize(bytes.size());
+  std::memcpy(file.buffer_.data(), bytes.data(), bytes.size());
+  file.data_ = file.buffer_.data();
+  file.size_ = file.buffer_.size();
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    fail(owner, "cannot open", path);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    fail(owner, "cannot stat", path);
+  }
+  const auto size = static_cast<size_t>(st.st_size);
+  if (size == 0) {
+    ::close(fd);
+    return file; // mmap rejects empty mappings.
+  }
+  void *mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    fail(owner, "cannot map", path);
+  }
+  if (access == MapAccess::Sequential) {
+    ::madvise(mapped, size, MADV_SEQUENTIAL);
+  } else if (access == MapAccess::Random) {
+    // Ask for everything now rather than a page fault per first touch.
+    ::madvise(mapped, size, MADV_WILLNEED);
+  }
+  file.data_ = static_cast<const std::byte *>(mapped);
+  file.size_ = size;
+  file.mapped_ = true;
+#endif
+  return file;
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mapped_ = std::exchange(other.mapped_, false);
+    buffer_ = std::move(other.buffer_);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { release(); }
+
+void MappedFile::release() noexcept {
+#if !defined(_WIN32)
+  if (mapped_)
+    ::munmap(const_cast<std::byte *>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  buffer_.clear();
+}
+
+void writeFileAtomically(const std::string &path, std::string_view owner,
+                         const std::function<void(std::ostream &)> &fill) {
+  const std::string tmp = path + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      fail(owner, "cannot create", tmp);
+    }
+    fill(out);
+    if (!out.flush()) {
+      fail(owner, "cannot write", tmp);
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(tmp, path, error);
+  if (error) {
+    throw std::runtime_error(std::string(owner) + ": cannot replace " + path +
+                             ": " + error.message());
+  }
+}
+
+} // namespace poker::utils
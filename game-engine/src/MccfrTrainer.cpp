@@ -0,0 +1,441 @@
+#include "solver/MccfrTrainer.h"
+#include "core/GameState.h"
+#include "core/LazyDeck.h"
+#include "core/Random.h"
+#include "engine/GameTreeCursor.h"
+#include "utils/MappedFile.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace poker::solver {
+
+namespace {
+
+/// Slots looked at past the home slot before the table counts as full.
+constexpr size_t kMaxProbes = 64;
+
+constexpr char kMagic[8] = {'P', 'K', 'R', 'M', 'C', 'C', 'F', 'R'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kEndianTag = 0x01020304;
+
+struct CheckpointHeader {
+  char magic[8];
+  uint32_t endianTag;
+  uint32_t version;
+  uint32_t maxActions;
+  uint32_t reserved;
+  uint64_t gameHash; ///< Stacks, blinds and the action abstraction.
+  uint64_t iterations;
+  uint64_t numInfoSets;
+};
+
+struct CheckpointRecord {
+  uint64_t key;
+  float regret[MccfrTrainer::kMaxActions];
+  float strategy[MccfrTrainer::kMaxActions];
+};
+
+uint64_t mix(uint64_t h, uint64_t value) noexcept {
+  return core::splitMix64(h ^ (value * 0x9E3779B97F4A7C15ull));
+}
+
+/// Everything a checkpoint's regrets depend on besides the card buckets.
+uint64_t gameHash(const MccfrConfig &c) {
+  uint64_t h = mix(0, static_cast<uint64_t>(c.startingStack));
+  h = mix(h, static_cast<uint64_t>(c.smallBlind));
+  h = mix(h, static_cast<uint64_t>(c.bigBlind));
+  h = mix(h, c.maxRaisesPerStreet);
+  for (size_t s = 0; s < engine::ActionAbstraction::kNumStreets; ++s) {
+    // Sizes past the raise cap are never offered.
+    for (size_t r = 0; r < c.maxRaisesPerStreet; ++r) {
+      for (double f : c.actions.getSizes(static_cast<core::Street>(s), r)) {
+        uint64_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        h = mix(h, bits);
+      }
+      h = mix(h, 0xFF);
+    }
+  }
+  return h;
+}
+
+/// Regret matching: positive regrets normalised, else uniform.
+template <typename Slot>
+void regretMatching(const Slot &slot, size_t n, float *sigma) noexcept {
+  float sum = 0.0f;
+  for (size_t a = 0; a < n; ++a) {
+    sigma[a] = std::max(slot.regret[a].load(std::memory_order_relaxed), 0.0f);
+    sum += sigma[a];
+  }
+  for (size_t a = 0; a < n; ++a)
+    sigma[a] = sum > 0.0f ? sigma[a] / sum : 1.0f / static_cast<float>(n);
+}
+
+} // anonymous namespace
+
+// --- Worker: one thread's hand, cursor and scratch space ---
+
+class MccfrTrainer::Worker {
+public:
+  explicit Worker(MccfrTrainer &trainer) : trainer_(trainer) {
+    const MccfrConfig &c = trainer.config_;
+    std::vector<core::Player> players;
+    players.emplace_back(0, "Button", c.startingStack);
+    players.emplace_back(1, "Big blind", c.startingStack);
+    state_.setPlayers(std::move(players));
+    state_.setSmallBlind(c.smallBlind);
+    state_.setBigBlind(c.bigBlind);
+    state_.setDealerPosition(0);
+  }
+
+  /// Iteration t: deal, then traverse for seat t mod 2.
+  void iterate(uint64_t t) {
+    const MccfrConfig &c = trainer_.config_;
+    rng_ = core::PhiloxGenerator(c.seed, 0, t);
+    deck_.restore();
+    state_.resetForNewHand();
+    for (auto &p : state_.getMutablePlayers())
+      p.restoreBettingState(c.startingStack, 0, false, false);
+    for (int round = 0; round < 2; ++round) {
+      for (auto &p : state_.getMutablePlayers())
+        p.dealCard(*deck_.draw(rng_));
+    }
+    for (auto &card : board_)
+      card = *deck_.draw(rng_);
+    postBlind(state_.getSmallBlindPosition(), c.smallBlind);
+    postBlind(state_.getBigBlindPosition(), c.bigBlind);
+
+    constexpr size_t kBoardSize[] = {0, 3, 4, 5};
+    for (size_t seat = 0; seat < 2; ++seat) {
+      const core::CardSet hole = state_.getPlayer(seat).getHoleCardSet();
+      for (size_t s = 0; s < 4; ++s) {
+        buckets_[seat][s] = trainer_.cardBucket(
+            static_cast<core::Street>(s), hole,
+            core::CardSet(std::span<const core::Card>(board_.data(),
+                                                      kBoardSize[s])));
+      }
+    }
+    cursor_.reset(state_);
+    (void)traverse(static_cast<size_t>(t & 1), kRootHistory);
+  }
+
+private:
+  void postBlind(size_t seat, int64_t amount) {
+    const int64_t paid = state_.getMutablePlayer(seat).placeBet(amount);
+    state_.getMutablePot().addContribution(seat, paid);
+    state_.recordAction(core::Action(core::ActionType::Bet, paid, seat));
+  }
+
+  /// Expected value for `traverser`, in big blinds, of the subtree below
+  /// the cursor.
+  double traverse(size_t traverser, uint64_t history) {
+    switch (cursor_.getNodeType()) {
+    case engine::GameTreeCursor::NodeType::Terminal:
+      cursor_.getPayoffs(payoffs_);
+      return static_cast<double>(payoffs_[traverser]) /
+             static_cast<double>(trainer_.config_.bigBlind);
+    case engine::GameTreeCursor::NodeType::Chance: {
+      const size_t have = state_.getCommunityCards().size();
+      cursor_.dealBoard(std::span<const core::Card>(board_).subspan(
+          have, cursor_.cardsNeeded()));
+      const double value = traverse(traverser, streetStep(history));
+      cursor_.undo();
+      return value;
+    }
+    case engine::GameTreeCursor::NodeType::Decision:
+      break;
+    }
+
+    std::array<core::Action, kMaxActions> actions;
+    const size_t n = abstractActions(actions);
+    const size_t seat = cursor_.getCurrentPlayer();
+    const auto street = static_cast<size_t>(state_.getStreet());
+    Slot &slot = trainer_.findOrInsert(
+        infoSetKey(history, seat, buckets_[seat][street]));
+    std::array<float, kMaxActions> sigma;
+    regretMatching(slot, n, sigma.data());
+
+    if (seat != traverser) {
+      // Opponent: add to the average strategy and sample one action.
+      for (size_t a = 0; a < n; ++a)
+        slot.strategy[a].fetch_add(sigma[a], std::memory_order_relaxed);
+      const float u = static_cast<float>(rng_() >> 40) * 0x1.0p-24f;
+      size_t pick = 0;
+      float cumulative = sigma[0];
+      while (pick + 1 < n && u >= cumulative)
+        cumulative += sigma[++pick];
+      cursor_.apply(actions[pick]);
+      const double value = traverse(traverser, historyStep(history, pick));
+      cursor_.undo();
+      return value;
+    }
+
+    // Traverser: explore every action and update regrets.
+    std::array<double, kMaxActions> values;
+    double nodeValue = 0.0;
+    for (size_t a = 0; a < n; ++a) {
+      cursor_.apply(actions[a]);
+      values[a] = traverse(traverser, historyStep(history, a));
+      cursor_.undo();
+      nodeValue += sigma[a] * values[a];
+    }
+    for (size_t a = 0; a < n; ++a) {
+      slot.regret[a].fetch_add(static_cast<float>(values[a] - nodeValue),
+                               std::memory_order_relaxed);
+    }
+    return nodeValue;
+  }
+
+  /// The abstract actions at the cursor's decision, with the raise cap.
+  size_t abstractActions(std::array<core::Action, kMaxActions> &out) {
+    trainer_.config_.actions.expand(cursor_, scratch_);
+    const bool capped = cursor_.getRound().getNumRaises() >=
+                        trainer_.config_.maxRaisesPerStreet;
+    bool canCall = false;
+    for (const auto &a : scratch_) {
+      canCall |= a.type == core::ActionType::Check ||
+                 a.type == core::ActionType::Call;
+    }
+    size_t n = 0;
+    for (const auto &a : scratch_) {
+      const bool raises =
+          a.type == core::ActionType::Bet ||
+          a.type == core::ActionType::Raise ||
+          (a.type == core::ActionType::AllIn && canCall);
+      if (capped && raises)
+        continue;
+      if (n == kMaxActions) {
+        throw std::logic_error("MccfrTrainer: more than kMaxActions actions");
+      }
+      out[n++] = a;
+    }
+    return n;
+  }
+
+  MccfrTrainer &trainer_;
+  core::GameState state_;
+  engine::GameTreeCursor cursor_;
+  core::LazyDeck deck_;
+  core::PhiloxGenerator rng_{0};
+  std::array<core::Card, 5> board_;
+  std::array<std::array<uint64_t, 4>, 2> buckets_{};
+  std::array<int64_t, 2> payoffs_{};
+  std::vector<core::Action> scratch_;
+};
+
+// --- Trainer ---
+
+MccfrTrainer::MccfrTrainer(MccfrConfig config) : config_(std::move(config)) {
+  if (config_.startingStack <= 0 || config_.smallBlind <= 0 ||
+      config_.bigBlind < config_.smallBlind) {
+    throw std::invalid_argument(
+        "MccfrTrainer: stacks and blinds must be positive");
+  }
+  if (config_.actions.getMaxSizes() + 3 > kMaxActions) {
+    throw std::invalid_argument("MccfrTrainer: at most " +
+                                std::to_string(kMaxActions - 3) +
+                                " bet sizes per decision");
+  }
+  if (config_.tableBits < 4 || config_.tableBits > 32) {
+    throw std::invalid_argument("MccfrTrainer: tableBits must be 4..32");
+  }
+  if (config_.checkpointEvery != 0 && config_.checkpointPath.empty()) {
+    throw std::invalid_argument("MccfrTrainer: checkpoints need a path");
+  }
+  const size_t capacity = size_t{1} << config_.tableBits;
+  slots_ = std::make_unique<Slot[]>(capacity);
+  mask_ = capacity - 1;
+}
+
+MccfrTrainer::~MccfrTrainer() = default;
+
+void MccfrTrainer::train(uint64_t iterations, size_t threads) {
+  utils::ThreadPool pool(threads);
+  std::vector<std::unique_ptr<Worker>> workers;
+  for (size_t w = 0; w < pool.size(); ++w)
+    workers.push_back(std::make_unique<Worker>(*this));
+
+  const uint64_t every = config_.checkpointEvery;
+  while (iterations > 0) {
+    const uint64_t chunk =
+        every ? std::min(iterations, every - iterations_ % every) : iterations;
+    const uint64_t first = iterations_;
+    pool.parallelFor(static_cast<size_t>(chunk),
+                     [&](size_t i, size_t worker) {
+                       workers[worker]->iterate(first + i);
+                     });
+    iterations_ += chunk;
+    iterations -= chunk;
+    if (every && iterations_ % every == 0)
+      saveCheckpoint(config_.checkpointPath);
+  }
+}
+
+uint64_t MccfrTrainer::historyStep(uint64_t history,
+                                   size_t actionIndex) noexcept {
+  return mix(history, actionIndex + 1);
+}
+
+uint64_t MccfrTrainer::streetStep(uint64_t history) noexcept {
+  return mix(history, 0);
+}
+
+uint64_t MccfrTrainer::cardBucket(core::Street street, core::CardSet hole,
+                                  core::CardSet board) const {
+  if (config_.cardBuckets)
+    return config_.cardBuckets(street, hole, board);
+  return mix(hole.bits(), board.bits());
+}
+
+uint64_t MccfrTrainer::infoSetKey(uint64_t history, size_t seat,
+                                  uint64_t bucket) noexcept {
+  const uint64_t key = mix(mix(history, seat), bucket);
+  return key ? key : 1; // 0 marks an empty slot.
+}
+
+MccfrTrainer::Slot &MccfrTrainer::findOrInsert(uint64_t key) {
+  size_t i = static_cast<size_t>(key) & mask_;
+  for (size_t probe = 0; probe < kMaxProbes; ++probe, i = (i + 1) & mask_) {
+    Slot &slot = slots_[i];
+    uint64_t found = slot.key.load(std::memory_order_acquire);
+    if (found == key)
+      return slot;
+    if (found == 0) {
+      if (slot.key.compare_exchange_strong(found, key,
+                                           std::memory_order_acq_rel)) {
+        used_.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+      }
+      if (found == key)
+        return slot; // Another worker claimed it for the same key.
+    }
+  }
+  throw std::runtime_error(
+      "MccfrTrainer: information-set table full; raise tableBits");
+}
+
+const MccfrTrainer::Slot *MccfrTrainer::find(uint64_t key) const noexcept {
+  size_t i = static_cast<size_t>(key) & mask_;
+  for (size_t probe = 0; probe < kMaxProbes; ++probe, i = (i + 1) & mask_) {
+    const uint64_t found = slots_[i].key.load(std::memory_order_acquire);
+    if (found == key)
+      return &slots_[i];
+    if (found == 0)
+      return nullptr;
+  }
+  return nullptr;
+}
+
+bool MccfrTrainer::averageStrategy(uint64_t key, std::span<float> out) const {
+  if (out.empty() || out.size() > kMaxActions) {
+    throw std::invalid_argument("MccfrTrainer: 1 to kMaxActions actions");
+  }
+  const Slot *slot = find(key);
+  float sum = 0.0f;
+  for (size_t a = 0; a < out.size(); ++a) {
+    out[a] = slot ? slot->strategy[a].load(std::memory_order_relaxed) : 0.0f;
+    sum += out[a];
+  }
+  for (auto &p : out)
+    p = sum > 0.0f ? p / sum : 1.0f / static_cast<float>(out.size());
+  return slot != nullptr;
+}
+
+void MccfrTrainer::clear() noexcept {
+  for (size_t i = 0; i <= mask_; ++i) {
+    Slot &slot = slots_[i];
+    slot.key.store(0, std::memory_order_relaxed);
+    for (size_t a = 0; a < kMaxActions; ++a) {
+      slot.regret[a].store(0.0f, std::memory_order_relaxed);
+      slot.strategy[a].store(0.0f, std::memory_order_relaxed);
+    }
+  }
+  used_.store(0, std::memory_order_relaxed);
+}
+
+// --- Checkpoints ---
+
+void MccfrTrainer::saveCheckpoint(const std::string &path) const {
+  utils::writeFileAtomically(path, "MccfrTrainer", [&](std::ostream &out) {
+    CheckpointHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.endianTag = kEndianTag;
+    header.version = kVersion;
+    header.maxActions = kMaxActions;
+    header.gameHash = gameHash(config_);
+    header.iterations = iterations_;
+    header.numInfoSets = numInfoSets();
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (size_t i = 0; i <= mask_; ++i) {
+      const Slot &slot = slots_[i];
+      CheckpointRecord record{};
+      record.key = slot.key.load(std::memory_order_relaxed);
+      if (record.key == 0)
+        continue;
+      for (size_t a = 0; a < kMaxActions; ++a) {
+        record.regret[a] = slot.regret[a].load(std::memory_order_relaxed);
+        record.strategy[a] = slot.strategy[a].load(std::memory_order_relaxed);
+      }
+      out.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    }
+  });
+}
+
+void MccfrTrainer::loadCheckpoint(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("MccfrTrainer: cannot open " + path);
+  }
+  CheckpointHeader header{};
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.endianTag != kEndianTag) {
+    throw std::runtime_error("MccfrTrainer: not a checkpoint: " + path);
+  }
+  if (header.version != kVersion || header.maxActions != kMaxActions) {
+    throw std::runtime_error("MccfrTrainer: unsupported checkpoint version " +
+                             std::to_string(header.version));
+  }
+  if (header.gameHash != gameHash(config_)) {
+    throw std::runtime_error("MccfrTrainer: checkpoint is for another game: " +
+                             path);
+  }
+
+  if (header.numInfoSets > tableCapacity()) {
+    throw std::runtime_error(
+        "MccfrTrainer: checkpoint holds " +
+        std::to_string(header.numInfoSets) +
+        " information sets, more than the table; raise tableBits");
+  }
+
+  clear();
+  try {
+    for (uint64_t r = 0; r < header.numInfoSets; ++r) {
+      CheckpointRecord record{};
+      if (!in.read(reinterpret_cast<char *>(&record), sizeof(record)) ||
+          record.key == 0) {
+        throw std::runtime_error("MccfrTrainer: truncated or corrupt " + path);
+      }
+      Slot &slot = findOrInsert(record.key); // Throws if the probes run out.
+      for (size_t a = 0; a < kMaxActions; ++a) {
+        slot.regret[a].store(record.regret[a], std::memory_order_relaxed);
+        slot.strategy[a].store(record.strategy[a], std::memory_order_relaxed);
+      }
+    }
+  } catch (...) {
+    // An empty trainer rather than a half-loaded one.
+    clear();
+    iterations_ = 0;
+    throw;
+  }
+  iterations_ = header.iterations;
+}
+
+} // namespace poker::solver
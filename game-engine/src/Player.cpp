@@ -17,6 +17,7 @@ void Player::dealCard(Card c) {
     throw std::logic_error("Player already has 2 hole cards");
   }
   holeCards_.push_back(c);
+  holeSet_.insert(c);
 }
 
 void Player::fold() { folded_ = true; }
@@ -35,6 +36,7 @@ void Player::awardChips(int64_t amount) { chips_ += amount; }
 
 void Player::resetForNewHand() {
   holeCards_.clear();
+  holeSet_.clear();
   folded_ = false;
   allIn_ = false;
   currentBet_ = 0;
@@ -1,6 +1,7 @@
 #include "core/Pot.h"
 
 #include <algorithm>
+#include <array>
 #include <numeric>
 
 namespace poker::core {
@@ -15,6 +16,17 @@ void Pot::addContribution(size_t playerId, int64_t amount) {
   contributions_.emplace_back(playerId, amount);
 }
 
+void Pot::removeContribution(size_t playerId, int64_t amount) {
+  for (auto it = contributions_.begin(); it != contributions_.end(); ++it) {
+    if (it->first == playerId) {
+      it->second -= amount;
+      if (it->second == 0)
+        contributions_.erase(it);
+      return;
+    }
+  }
+}
+
 int64_t Pot::getTotal() const noexcept {
   int64_t total = 0;
   for (const auto &[pid, contrib] : contributions_) {
@@ -78,6 +90,43 @@ Pot::calculateSidePots(const std::unordered_set<size_t> &foldedPlayers) const {
   return pots;
 }
 
+void Pot::calculateSidePots(SeatMask folded, std::vector<SidePot> &out) const {
+  out.clear();
+
+  // Distinct contribution levels, ascending (insertion sort; n <= kMaxSeats).
+  std::array<int64_t, kMaxSeats> levels;
+  size_t numLevels = 0;
+  for (const auto &[pid, contrib] : contributions_) {
+    if (contrib <= 0)
+      continue;
+    size_t i = 0;
+    while (i < numLevels && levels[i] < contrib)
+      ++i;
+    if (i < numLevels && levels[i] == contrib)
+      continue;
+    for (size_t j = numLevels; j > i; --j)
+      levels[j] = levels[j - 1];
+    levels[i] = contrib;
+    ++numLevels;
+  }
+
+  int64_t prevLevel = 0;
+  for (size_t l = 0; l < numLevels; ++l) {
+    const int64_t level = levels[l];
+    SidePot pot;
+    for (const auto &[pid, contrib] : contributions_) {
+      if (contrib <= prevLevel)
+        continue;
+      pot.amount += std::min(contrib, level) - prevLevel;
+      if ((folded & seatBit(pid)) == 0)
+        pot.eligible |= seatBit(pid);
+    }
+    if (pot.amount > 0)
+      out.push_back(pot);
+    prevLevel = level;
+  }
+}
+
 void Pot::reset() { contributions_.clear(); }
 
 } // namespace poker::core
@@ -0,0 +1,388 @@
+#include "utils/PreflopTable.h"
+#include "utils/EquityCalculator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace poker::utils {
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'K', 'R', 'P', 'F', 'E', 'Q', '\0'};
+constexpr uint32_t kEndianTag = 0x01020304;
+constexpr size_t kNumClasses = PreflopTable::kNumClasses;
+/// The heads-up matrix starts here; the header is padded up to it.
+constexpr uint64_t kHeadsUpOffset = 64;
+
+struct Header {
+  char magic[8];
+  uint32_t endianTag;
+  uint32_t version;
+  uint32_t numClasses;
+  uint32_t numThreeWay;
+  uint32_t threeWaySlots; ///< Power of two.
+  uint32_t reserved;
+  uint64_t headsUpOffset;
+  uint64_t threeWayOffset;
+  uint64_t fileSize;
+};
+static_assert(sizeof(Header) <= kHeadsUpOffset);
+
+/// Hash slot of a 3-way spot; classes are stored sorted ascending.
+struct ThreeWayEntry {
+  uint32_t key; ///< 0 = empty slot.
+  float equity[3];
+};
+static_assert(sizeof(ThreeWayEntry) == 16);
+
+uint32_t threeWayKey(const std::array<size_t, 3> &sorted) {
+  return static_cast<uint32_t>((sorted[0] * kNumClasses + sorted[1]) *
+                                   kNumClasses +
+                               sorted[2] + 1);
+}
+
+uint32_t slotOf(uint32_t key, uint32_t slots) {
+  const int bits = std::countr_zero(slots);
+  return bits == 0 ? 0 : (key * 0x9E3779B1u) >> (32 - bits);
+}
+
+/// The 24 relabelings of the four suits.
+const std::vector<std::array<uint8_t, 4>> &suitPermutations() {
+  static const auto perms = [] {
+    std::vector<std::array<uint8_t, 4>> out;
+    std::array<uint8_t, 4> perm = {0, 1, 2, 3};
+    do {
+      out.push_back(perm);
+    } while (std::next_permutation(perm.begin(), perm.end()));
+    return out;
+  }();
+  return perms;
+}
+
+/// Smallest image of a tuple of hands under the suit relabelings.
+template <size_t N>
+std::array<uint64_t, N> canonical(const std::array<core::CardSet, N> &hands) {
+  std::array<uint64_t, N> best;
+  best.fill(~uint64_t{0});
+  for (const auto &perm : suitPermutations()) {
+    std::array<uint64_t, N> image;
+    for (size_t i = 0; i < N; ++i)
+      image[i] = hands[i].permuteSuits(perm).bits();
+    best = std::min(best, image);
+  }
+  return best;
+}
+
+/// Average the exact equities of every non-overlapping combination of
+/// combos from the given classes, enumerating each suit-isomorphism class
+/// of combinations once.
+template <size_t N>
+std::array<double, N> averageOverCombos(EquityCalculator &calc,
+                                        const std::array<size_t, N> &classes) {
+  std::array<std::vector<core::CardSet>, N> combos;
+  for (size_t i = 0; i < N; ++i)
+    combos[i] = PreflopTable::combos(classes[i]);
+
+  std::map<std::array<uint64_t, N>, uint64_t> counts;
+  std::array<size_t, N> pick = {};
+  while (true) {
+    std::array<core::CardSet, N> hands;
+    core::CardSet used;
+    bool disjoint = true;
+    for (size_t i = 0; i < N && disjoint; ++i) {
+      hands[i] = combos[i][pick[i]];
+      disjoint = !used.intersects(hands[i]);
+      used |= hands[i];
+    }
+    if (disjoint)
+      ++counts[canonical(hands)];
+
+    size_t i = 0;
+    while (i < N && ++pick[i] == combos[i].size())
+      pick[i++] = 0;
+    if (i == N)
+      break;
+  }
+  if (counts.empty()) {
+    throw std::invalid_argument("PreflopTable: classes cannot coexist");
+  }
+
+  std::array<double, N> sum = {};
+  uint64_t total = 0;
+  for (const auto &[hands, count] : counts) {
+    EquityQuery q;
+    for (uint64_t bits : hands)
+      q.holeCards.push_back(core::CardSet(bits));
+    const EquityResult r = calc.enumerate(q);
+    for (size_t i = 0; i < N; ++i)
+      sum[i] += static_cast<double>(count) * r.players[i].equity;
+    total += count;
+  }
+  for (auto &s : sum)
+    s /= static_cast<double>(total);
+  return sum;
+}
+
+int rankOf(char c) {
+  static constexpr std::string_view kRanks = "23456789TJQKA";
+  size_t pos = kRanks.find(c);
+  return pos == std::string_view::npos ? -1 : static_cast<int>(pos) + 2;
+}
+
+char rankChar(int rank) { return "23456789TJQKA"[rank - 2]; }
+
+size_t classFromRanks(int high, int low, bool suited) {
+  if (high < low)
+    std::swap(high, low);
+  const size_t hi = static_cast<size_t>(14 - high);
+  const size_t lo = static_cast<size_t>(14 - low);
+  return suited ? hi * 13 + lo : lo * 13 + hi;
+}
+
+} // anonymous namespace
+
+// --- Loading ---
+
+PreflopTable PreflopTable::open(const std::string &path) {
+  PreflopTable table;
+  table.file_ = MappedFile::open(path, "PreflopTable");
+  const std::byte *data = table.file_.data();
+  const size_t size = table.file_.size();
+
+  Header header;
+  if (size < sizeof(Header)) {
+    throw std::runtime_error("PreflopTable: truncated file " + path);
+  }
+  std::memcpy(&header, data, sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("PreflopTable: not a preflop table: " + path);
+  }
+  if (header.endianTag != kEndianTag) {
+    throw std::runtime_error("PreflopTable: byte order mismatch: " + path);
+  }
+  if (header.version != kVersion) {
+    throw std::runtime_error("PreflopTable: unsupported version " +
+                             std::to_string(header.version));
+  }
+  const uint64_t headsUpBytes = kNumClasses * kNumClasses * sizeof(float);
+  const uint64_t threeWayBytes =
+      uint64_t{header.threeWaySlots} * sizeof(ThreeWayEntry);
+  if (header.numClasses != kNumClasses || header.fileSize != size ||
+      header.headsUpOffset % alignof(float) != 0 ||
+      header.headsUpOffset > size ||
+      headsUpBytes > size - header.headsUpOffset ||
+      header.threeWayOffset % alignof(ThreeWayEntry) != 0 ||
+      header.threeWayOffset > size ||
+      threeWayBytes > size - header.threeWayOffset ||
+      !std::has_single_bit(header.threeWaySlots) ||
+      header.numThreeWay > header.threeWaySlots) {
+    throw std::runtime_error("PreflopTable: corrupt file " + path);
+  }
+
+  table.headsUp_ =
+      reinterpret_cast<const float *>(data + header.headsUpOffset);
+  table.threeWay_ = data + header.threeWayOffset;
+  table.threeWaySlots_ = header.threeWaySlots;
+  table.numThreeWay_ = header.numThreeWay;
+  return table;
+}
+
+PreflopTable::PreflopTable(PreflopTable &&other) noexcept {
+  *this = std::move(other);
+}
+
+PreflopTable &PreflopTable::operator=(PreflopTable &&other) noexcept {
+  if (this != &other) {
+    file_ = std::move(other.file_);
+    headsUp_ = std::exchange(other.headsUp_, nullptr);
+    threeWay_ = std::exchange(other.threeWay_, nullptr);
+    threeWaySlots_ = std::exchange(other.threeWaySlots_, 0);
+    numThreeWay_ = std::exchange(other.numThreeWay_, 0);
+  }
+  return *this;
+}
+
+PreflopTable::~PreflopTable() = default;
+
+// --- Writing ---
+
+void PreflopTable::write(const std::string &path,
+                         std::span<const float> headsUp,
+                         std::span<const ThreeWaySpot> threeWay) {
+  if (headsUp.size() != kNumClasses * kNumClasses) {
+    throw std::invalid_argument("PreflopTable: heads-up matrix must be 169x169");
+  }
+  const uint32_t slots =
+      std::bit_ceil(std::max<uint32_t>(4, static_cast<uint32_t>(2 * threeWay.size())));
+  std::vector<ThreeWayEntry> entries(slots, ThreeWayEntry{0, {}});
+  size_t stored = 0;
+  for (const auto &spot : threeWay) {
+    std::array<size_t, 3> order = {0, 1, 2};
+    for (size_t i : order) {
+      if (spot.classes[i] >= kNumClasses) {
+        throw std::invalid_argument("PreflopTable: class index out of range");
+      }
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return spot.classes[a] < spot.classes[b];
+    });
+    ThreeWayEntry entry{};
+    std::array<size_t, 3> sorted;
+    for (size_t i = 0; i < 3; ++i) {
+      sorted[i] = spot.classes[order[i]];
+      entry.equity[i] = spot.equity[order[i]];
+    }
+    entry.key = threeWayKey(sorted);
+    uint32_t slot = slotOf(entry.key, slots);
+    while (entries[slot].key != 0 && entries[slot].key != entry.key)
+      slot = (slot + 1) & (slots - 1);
+    stored += entries[slot].key == 0;
+    entries[slot] = entry;
+  }
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.endianTag = kEndianTag;
+  header.version = kVersion;
+  header.numClasses = kNumClasses;
+  header.numThreeWay = static_cast<uint32_t>(stored);
+  header.threeWaySlots = slots;
+  header.headsUpOffset = kHeadsUpOffset;
+  header.threeWayOffset = kHeadsUpOffset + headsUp.size_bytes();
+  header.fileSize = header.threeWayOffset + entries.size() * sizeof(ThreeWayEntry);
+
+  writeFileAtomically(path, "PreflopTable", [&](std::ostream &out) {
+    std::array<char, kHeadsUpOffset> head = {};
+    std::memcpy(head.data(), &header, sizeof(Header));
+    out.write(head.data(), head.size());
+    out.write(reinterpret_cast<const char *>(headsUp.data()),
+              static_cast<std::streamsize>(headsUp.size_bytes()));
+    out.write(reinterpret_cast<const char *>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(ThreeWayEntry)));
+  });
+}
+
+// --- Lookups ---
+
+float PreflopTable::headsUp(core::CardSet hero, core::CardSet villain) const {
+  return headsUp(handClass(hero), handClass(villain));
+}
+
+std::optional<std::array<float, 3>>
+PreflopTable::threeWay(size_t a, size_t b, size_t c) const noexcept {
+  std::array<size_t, 3> classes = {a, b, c};
+  std::array<size_t, 3> order = {0, 1, 2};
+  for (size_t cls : classes) {
+    if (cls >= kNumClasses)
+      return std::nullopt;
+  }
+  std::sort(order.begin(), order.end(),
+            [&](size_t x, size_t y) { return classes[x] < classes[y]; });
+  const uint32_t key = threeWayKey(
+      {classes[order[0]], classes[order[1]], classes[order[2]]});
+
+  const auto *entries = static_cast<const ThreeWayEntry *>(threeWay_);
+  for (uint32_t slot = slotOf(key, threeWaySlots_); entries[slot].key != 0;
+       slot = (slot + 1) & (threeWaySlots_ - 1)) {
+    if (entries[slot].key == key) {
+      std::array<float, 3> out;
+      for (size_t i = 0; i < 3; ++i)
+        out[order[i]] = entries[slot].equity[i];
+      return out;
+    }
+  }
+  return std::nullopt;
+}
+
+// --- Starting-hand classes ---
+
+size_t PreflopTable::handClass(core::Card a, core::Card b) {
+  if (a == b) {
+    throw std::invalid_argument("PreflopTable: a hand needs two distinct cards");
+  }
+  return classFromRanks(static_cast<int>(a.rank), static_cast<int>(b.rank),
+                        a.suit == b.suit);
+}
+
+size_t PreflopTable::handClass(core::CardSet hand) {
+  if (hand.size() != 2) {
+    throw std::invalid_argument("PreflopTable: a hand has exactly two cards");
+  }
+  auto it = hand.begin();
+  core::Card a = *it++;
+  return handClass(a, *it);
+}
+
+size_t PreflopTable::handClass(std::string_view name) {
+  const int high = name.size() >= 2 ? rankOf(name[0]) : -1;
+  const int low = name.size() >= 2 ? rankOf(name[1]) : -1;
+  const bool valid =
+      high > 0 && low > 0 &&
+      ((name.size() == 2 && high == low) ||
+       (name.size() == 3 && high != low && (name[2] == 's' || name[2] == 'o')));
+  if (!valid) {
+    throw std::invalid_argument("PreflopTable: bad hand class '" +
+                                std::string(name) + "'");
+  }
+  return classFromRanks(high, low, name.size() == 3 && name[2] == 's');
+}
+
+std::string PreflopTable::className(size_t cls) {
+  const int row = static_cast<int>(cls / 13);
+  const int col = static_cast<int>(cls % 13);
+  if (row == col)
+    return {rankChar(14 - row), rankChar(14 - row)};
+  if (row < col)
+    return {rankChar(14 - row), rankChar(14 - col), 's'};
+  return {rankChar(14 - col), rankChar(14 - row), 'o'};
+}
+
+std::vector<core::CardSet> PreflopTable::combos(size_t cls) {
+  const int row = static_cast<int>(cls / 13);
+  const int col = static_cast<int>(cls % 13);
+  const auto high = static_cast<core::Rank>(14 - std::min(row, col));
+  const auto low = static_cast<core::Rank>(14 - std::max(row, col));
+  std::vector<core::CardSet> out;
+  for (unsigned s1 = 0; s1 < 4; ++s1) {
+    for (unsigned s2 = 0; s2 < 4; ++s2) {
+      const bool keep = row == col ? s1 < s2 : (row < col) == (s1 == s2);
+      if (!keep)
+        continue;
+      out.push_back(
+          core::CardSet::of(core::Card(high, static_cast<core::Suit>(s1))) |
+          core::CardSet::of(core::Card(low, static_cast<core::Suit>(s2))));
+    }
+  }
+  return out;
+}
+
+// --- Computation ---
+
+double PreflopTable::computeHeadsUp(EquityCalculator &calc, size_t hero,
+                                    size_t villain) {
+  if (hero >= kNumClasses || villain >= kNumClasses) {
+    throw std::invalid_argument("PreflopTable: class index out of range");
+  }
+  // Every combo pair has a mirror with the seats swapped.
+  if (hero == villain)
+    return 0.5;
+  return averageOverCombos<2>(calc, {hero, villain})[0];
+}
+
+std::array<double, 3>
+PreflopTable::computeThreeWay(EquityCalculator &calc,
+                              const std::array<size_t, 3> &classes) {
+  for (size_t cls : classes) {
+    if (cls >= kNumClasses) {
+      throw std::invalid_argument("PreflopTable: class index out of range");
+    }
+  }
+  return averageOverCombos<3>(calc, classes);
+}
+
+} // namespace poker::utils
@@ -0,0 +1,10 @@
+#include "core/Random.h"
+
+namespace poker::core {
+
+Xoshiro256Generator::Xoshiro256Generator() {
+  std::random_device rd;
+  seed((static_cast<uint64_t>(rd()) << 32) | rd());
+}
+
+} // namespace poker::core
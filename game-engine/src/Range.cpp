@@ -0,0 +1,239 @@
+#include "utils/Range.h"
+
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace poker::utils {
+
+namespace {
+
+/// Hand class shape parsed from tokens like "AKs" or "77".
+enum class Suitedness { Any, Suited, Offsuit };
+
+struct HandClass {
+  int high = 0; ///< 2..14
+  int low = 0;  ///< 2..14, low <= high
+  Suitedness suited = Suitedness::Any;
+};
+
+/// Dense card index (see CardSet::toIndex) from rank 2..14 and suit 0..3.
+unsigned denseIndex(int rank, unsigned suit) {
+  return suit * 13 + static_cast<unsigned>(rank - 2);
+}
+
+size_t comboFromDense(unsigned a, unsigned b) {
+  if (a > b)
+    std::swap(a, b);
+  return static_cast<size_t>(b) * (b - 1) / 2 + a;
+}
+
+[[noreturn]] void fail(std::string_view token) {
+  throw std::invalid_argument("Range: cannot parse '" + std::string(token) +
+                              "'");
+}
+
+int parseRank(char c, std::string_view token) {
+  static constexpr std::string_view kRanks = "23456789TJQKA";
+  size_t pos = kRanks.find(static_cast<char>(std::toupper(
+      static_cast<unsigned char>(c))));
+  if (pos == std::string_view::npos)
+    fail(token);
+  return static_cast<int>(pos) + 2;
+}
+
+unsigned parseSuit(char c, std::string_view token) {
+  static constexpr std::string_view kSuits = "hdcs";
+  size_t pos = kSuits.find(static_cast<char>(std::tolower(
+      static_cast<unsigned char>(c))));
+  if (pos == std::string_view::npos)
+    fail(token);
+  return static_cast<unsigned>(pos);
+}
+
+HandClass parseClass(std::string_view text, std::string_view token) {
+  if (text.size() < 2 || text.size() > 3)
+    fail(token);
+  HandClass hc;
+  hc.high = parseRank(text[0], token);
+  hc.low = parseRank(text[1], token);
+  if (hc.low > hc.high)
+    std::swap(hc.low, hc.high);
+  if (text.size() == 3) {
+    if (text[2] == 's')
+      hc.suited = Suitedness::Suited;
+    else if (text[2] == 'o')
+      hc.suited = Suitedness::Offsuit;
+    else
+      fail(token);
+    if (hc.high == hc.low)
+      fail(token);
+  }
+  return hc;
+}
+
+void addClass(std::array<double, Range::kNumCombos> &weights,
+              const HandClass &hc, double w) {
+  for (unsigned s1 = 0; s1 < 4; ++s1) {
+    for (unsigned s2 = 0; s2 < 4; ++s2) {
+      if (hc.high == hc.low) {
+        if (s2 <= s1)
+          continue;
+      } else if ((hc.suited == Suitedness::Suited && s1 != s2) ||
+                 (hc.suited == Suitedness::Offsuit && s1 == s2)) {
+        continue;
+      }
+      weights[comboFromDense(denseIndex(hc.high, s1),
+                             denseIndex(hc.low, s2))] = w;
+    }
+  }
+}
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+    s.remove_prefix(1);
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+    s.remove_suffix(1);
+  return s;
+}
+
+void parseToken(std::array<double, Range::kNumCombos> &weights,
+                std::string_view token) {
+  std::string_view body = token;
+  double w = 1.0;
+  if (size_t colon = token.find(':'); colon != std::string_view::npos) {
+    body = trim(token.substr(0, colon));
+    std::string_view num = trim(token.substr(colon + 1));
+    auto [end, ec] = std::from_chars(num.data(), num.data() + num.size(), w);
+    if (ec != std::errc() || end != num.data() + num.size() || w < 0.0)
+      fail(token);
+  }
+
+  // Specific combo: "AsKd".
+  auto isSuit = [](char c) {
+    return std::string_view("hdcs").find(c) != std::string_view::npos;
+  };
+  if (body.size() == 4 && isSuit(body[1]) && isSuit(body[3])) {
+    unsigned a = denseIndex(parseRank(body[0], token), parseSuit(body[1], token));
+    unsigned b = denseIndex(parseRank(body[2], token), parseSuit(body[3], token));
+    if (a == b)
+      fail(token);
+    weights[comboFromDense(a, b)] = w;
+    return;
+  }
+
+  if (size_t dash = body.find('-'); dash != std::string_view::npos) {
+    HandClass from = parseClass(trim(body.substr(0, dash)), token);
+    HandClass to = parseClass(trim(body.substr(dash + 1)), token);
+    if (from.suited != to.suited)
+      fail(token);
+    bool pairs = from.high == from.low && to.high == to.low;
+    bool fixedHigh = from.high == to.high && from.high != from.low &&
+                     to.high != to.low;
+    bool sameGap = from.high - from.low == to.high - to.low;
+    if (!pairs && !fixedHigh && !sameGap)
+      fail(token);
+    if (from.high < to.high || (from.high == to.high && from.low < to.low))
+      std::swap(from, to);
+    // Walk from the top class down to the bottom one.
+    HandClass hc = from;
+    while (true) {
+      addClass(weights, hc, w);
+      if (hc.high == to.high && hc.low == to.low)
+        break;
+      if (fixedHigh) {
+        --hc.low;
+      } else {
+        --hc.high;
+        --hc.low;
+      }
+    }
+    return;
+  }
+
+  bool plus = !body.empty() && body.back() == '+';
+  if (plus)
+    body.remove_suffix(1);
+  HandClass hc = parseClass(body, token);
+  if (!plus) {
+    addClass(weights, hc, w);
+  } else if (hc.high == hc.low) {
+    for (int r = hc.high; r <= 14; ++r)
+      addClass(weights, {r, r, hc.suited}, w);
+  } else {
+    for (int r = hc.low; r < hc.high; ++r)
+      addClass(weights, {hc.high, r, hc.suited}, w);
+  }
+}
+
+} // anonymous namespace
+
+Range Range::parse(std::string_view text) {
+  Range range;
+  while (!text.empty()) {
+    size_t comma = text.find(',');
+    std::string_view token = trim(text.substr(0, comma));
+    if (token.empty())
+      fail(text);
+    parseToken(range.weights_, token);
+    if (comma == std::string_view::npos)
+      break;
+    text.remove_prefix(comma + 1);
+  }
+  return range;
+}
+
+Range Range::full() {
+  Range range;
+  range.weights_.fill(1.0);
+  return range;
+}
+
+size_t Range::comboIndex(core::Card a, core::Card b) {
+  unsigned ia = core::CardSet::toIndex(a);
+  unsigned ib = core::CardSet::toIndex(b);
+  if (ia == ib)
+    throw std::invalid_argument("Range: a combo needs two distinct cards");
+  return comboFromDense(ia, ib);
+}
+
+core::CardSet Range::comboCards(size_t index) {
+  static const auto table = [] {
+    std::array<core::CardSet, kNumCombos> t;
+    for (unsigned j = 1; j < 52; ++j) {
+      for (unsigned i = 0; i < j; ++i) {
+        t[comboFromDense(i, j)] = core::CardSet::of(core::CardSet::fromIndex(i)) |
+                                  core::CardSet::of(core::CardSet::fromIndex(j));
+      }
+    }
+    return t;
+  }();
+  return table[index];
+}
+
+size_t Range::size() const noexcept {
+  size_t n = 0;
+  for (double w : weights_)
+    n += w > 0.0;
+  return n;
+}
+
+double Range::totalWeight() const noexcept {
+  double total = 0.0;
+  for (double w : weights_)
+    total += w;
+  return total;
+}
+
+Range Range::without(core::CardSet dead) const {
+  Range out = *this;
+  for (size_t i = 0; i < kNumCombos; ++i) {
+    if (out.weights_[i] != 0.0 && comboCards(i).intersects(dead))
+      out.weights_[i] = 0.0;
+  }
+  return out;
+}
+
+} // namespace poker::utils
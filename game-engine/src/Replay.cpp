@@ -0,0 +1,234 @@
+#include "engine/Replay.h"
+#include "core/LazyDeck.h"
+#include "core/Random.h"
+#include "core/SeatMask.h"
+
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace poker::engine {
+
+Replay::Replay(const HandHistoryReader &reader, std::vector<std::string> names)
+    : reader_(&reader), names_(std::move(names)) {
+  views_.reserve(reader.size());
+  index_.reserve(reader.size());
+  for (const HandView &view : reader)
+    addHand(view, views_.size());
+}
+
+Replay::Replay(std::vector<HandRecord> hands, std::vector<std::string> names)
+    : records_(std::move(hands)), names_(std::move(names)) {
+  index_.reserve(records_.size());
+  for (size_t i = 0; i < records_.size(); ++i)
+    addHand(HandView({}, records_[i].handId), i);
+}
+
+void Replay::addHand(HandView view, size_t position) {
+  if (!index_.emplace(view.handId(), position).second) {
+    throw std::invalid_argument("Replay: duplicate hand id " +
+                                std::to_string(view.handId()));
+  }
+  if (reader_)
+    views_.push_back(view);
+}
+
+const HandRecord &Replay::record(uint64_t handId) {
+  load(handId);
+  return record_;
+}
+
+const core::GameState &Replay::stateAt(uint64_t handId, size_t actionIndex) {
+  load(handId);
+  if (actionIndex > record_.actions.size()) {
+    throw std::out_of_range("Replay: action index past the end of the hand");
+  }
+  if (position_ == kDirty || actionIndex < position_)
+    restore(actionIndex);
+  stepTo(actionIndex);
+  return state_;
+}
+
+std::span<const core::SidePot> Replay::sidePots() {
+  core::SeatMask folded = 0;
+  for (const auto &p : state_.getPlayers()) {
+    if (p.isFolded())
+      folded |= core::seatBit(p.getId());
+  }
+  state_.getPot().calculateSidePots(folded, sidePots_);
+  return sidePots_;
+}
+
+HandRecord Replay::rerun(uint64_t handId, size_t actionIndex,
+                         interfaces::IActionProvider &provider,
+                         uint64_t seed) {
+  if (actionIndex < kBlindActions) {
+    throw std::invalid_argument("Replay::rerun: cannot rerun the blinds");
+  }
+  (void)stateAt(handId, actionIndex);
+  // From here state_ leaves the recorded line.
+  position_ = kDirty;
+
+  core::CardSet dead(std::span<const core::Card>(record_.board));
+  for (core::CardSet hole : record_.holeCards)
+    dead |= hole;
+  core::LazyDeck deck;
+  deck.reset(dead);
+  core::Xoshiro256Generator rng(seed);
+
+  while (!cursor_.isTerminal()) {
+    if (cursor_.getNodeType() == GameTreeCursor::NodeType::Decision) {
+      const size_t seat = cursor_.getCurrentPlayer();
+      cursor_.apply(
+          provider.chooseAction(seat, state_, cursor_.getLegalActions()));
+      continue;
+    }
+    std::array<core::Card, 3> cards;
+    const size_t count = cursor_.cardsNeeded();
+    for (size_t k = 0; k < count; ++k) {
+      const size_t dealt = state_.getCommunityCards().size() + k;
+      cards[k] = dealt < record_.board.size() ? record_.board[dealt]
+                                              : *deck.draw(rng);
+    }
+    cursor_.dealBoard(std::span<const core::Card>(cards.data(), count));
+  }
+
+  HandRecord out = record_;
+  out.board = state_.getCommunityCards();
+  out.actions = state_.getActionHistory();
+  cursor_.getPayoffs(out.finalStacks);
+  for (size_t s = 0; s < out.numSeats(); ++s)
+    out.finalStacks[s] += out.startingStacks[s];
+  return out;
+}
+
+void Replay::load(uint64_t handId) {
+  if (loaded_ && handId_ == handId)
+    return;
+  const auto it = index_.find(handId);
+  if (it == index_.end()) {
+    throw std::out_of_range("Replay: unknown hand id " +
+                            std::to_string(handId));
+  }
+  loaded_ = false;
+  if (reader_)
+    views_[it->second].decode(record_);
+  else
+    record_ = records_[it->second];
+  if (record_.numSeats() < 2 || record_.actions.size() < kBlindActions) {
+    throw std::runtime_error("Replay: hand " + std::to_string(handId) +
+                             " has no blinds or fewer than two seats");
+  }
+
+  // Snapshot 0: the table before the blinds, hole cards dealt.
+  if (snapshots_.empty())
+    snapshots_.emplace_back();
+  Snapshot &root = snapshots_.front();
+  root.actionIndex = 0;
+  std::vector<core::Player> players;
+  players.reserve(record_.numSeats());
+  for (size_t i = 0; i < record_.numSeats(); ++i) {
+    players.emplace_back(i,
+                         i < names_.size() ? names_[i]
+                                           : "Seat " + std::to_string(i),
+                         record_.startingStacks[i]);
+  }
+  root.state.setPlayers(std::move(players));
+  root.state.setSmallBlind(record_.smallBlind);
+  root.state.setBigBlind(record_.bigBlind);
+  root.state.setDealerPosition(record_.dealer);
+  root.state.resetForNewHand();
+  for (size_t i = 0; i < record_.numSeats(); ++i) {
+    for (core::Card c : record_.holeCards[i])
+      root.state.getMutablePlayer(i).dealCard(c);
+  }
+  numSnapshots_ = 1;
+  position_ = kDirty;
+  handId_ = handId;
+  loaded_ = true;
+}
+
+void Replay::restore(size_t actionIndex) {
+  size_t s = numSnapshots_ - 1;
+  while (snapshots_[s].actionIndex > actionIndex)
+    --s;
+  state_ = snapshots_[s].state;
+  position_ = snapshots_[s].actionIndex;
+  if (position_ >= kBlindActions)
+    cursor_.reset(state_);
+}
+
+void Replay::stepTo(size_t actionIndex) {
+  while (position_ < actionIndex) {
+    const core::Action &action = record_.actions[position_];
+    if (position_ < kBlindActions) {
+      postBlind(action);
+      if (++position_ == kBlindActions) {
+        cursor_.reset(state_);
+        if (cursor_.getNodeType() == GameTreeCursor::NodeType::Decision)
+          takeSnapshot();
+        dealRecordedBoard();
+      }
+      continue;
+    }
+    if (cursor_.getNodeType() != GameTreeCursor::NodeType::Decision ||
+        action.playerId != cursor_.getCurrentPlayer()) {
+      throw std::runtime_error("Replay: action " + std::to_string(position_) +
+                               " is out of turn");
+    }
+    try {
+      cursor_.apply(action);
+    } catch (const std::invalid_argument &) {
+      throw std::runtime_error("Replay: action " + std::to_string(position_) +
+                               " is illegal");
+    }
+    ++position_;
+    dealRecordedBoard();
+  }
+  if (position_ == record_.actions.size() && position_ >= kBlindActions &&
+      !cursor_.isTerminal()) {
+    throw std::runtime_error("Replay: hand ends before it is over");
+  }
+}
+
+void Replay::postBlind(const core::Action &blind) {
+  const size_t seat = position_ == 0 ? state_.getSmallBlindPosition()
+                                     : state_.getBigBlindPosition();
+  if (blind.type != core::ActionType::Bet || blind.playerId != seat ||
+      state_.getMutablePlayer(seat).placeBet(blind.amount) != blind.amount) {
+    throw std::runtime_error("Replay: hand does not start with the blinds");
+  }
+  state_.getMutablePot().addContribution(seat, blind.amount);
+  state_.recordAction(blind);
+}
+
+void Replay::dealRecordedBoard() {
+  bool dealt = false;
+  while (cursor_.getNodeType() == GameTreeCursor::NodeType::Chance) {
+    const size_t have = state_.getCommunityCards().size();
+    const size_t count = cursor_.cardsNeeded();
+    if (have + count > record_.board.size()) {
+      throw std::runtime_error("Replay: record is missing board cards");
+    }
+    try {
+      cursor_.dealBoard(std::span(record_.board).subspan(have, count));
+    } catch (const std::invalid_argument &) {
+      throw std::runtime_error("Replay: record deals a card twice");
+    }
+    dealt = true;
+  }
+  if (dealt && cursor_.getNodeType() == GameTreeCursor::NodeType::Decision)
+    takeSnapshot();
+}
+
+void Replay::takeSnapshot() {
+  if (snapshots_[numSnapshots_ - 1].actionIndex >= position_)
+    return;
+  if (numSnapshots_ == snapshots_.size())
+    snapshots_.emplace_back();
+  Snapshot &snap = snapshots_[numSnapshots_++];
+  snap.actionIndex = position_;
+  snap.state = state_;
+}
+
+} // namespace poker::engine
@@ -50,64 +50,185 @@ std::vector<core::Action> RuleEngine::getLegalActions(
     const core::GameState& state, size_t playerId)
 {
     std::vector<core::Action> actions;
-    const auto& player = state.getPlayer(playerId);
+    getLegalActions(state, playerId, actions);
+    return actions;
+}
 
-    if (player.isFolded() || player.isAllIn()) {
-        return actions; // No actions available.
-    }
+namespace {
 
+/// What a player faces, however it was worked out.
+struct Facing {
+    int64_t chips = 0;
+    int64_t toCall = 0;      ///< Capped at chips.
+    int64_t raiseChips = 0;  ///< Chips a minimum raise puts in.
+    int64_t bigBlind = 0;
+    bool canRaise = true;    ///< False after a short all-in raise.
+};
+
+/// Out is a std::vector or a core::ActionList.
+template <typename Out>
+void appendLegalActions(const Facing& f, size_t playerId, Out& actions)
+{
     // Fold is always legal (except if no bet to face, but folding is still allowed).
     actions.emplace_back(core::ActionType::Fold, 0, playerId);
 
-    int64_t callAmount = getCallAmount(state, playerId);
-
-    if (callAmount == 0) {
+    if (f.toCall == 0) {
         // No bet to face: can check.
         actions.emplace_back(core::ActionType::Check, 0, playerId);
 
         // Can bet (min = BB, max = stack).
-        if (player.getChips() > 0) {
-            int64_t minBet = std::min(state.getBigBlind(), player.getChips());
-            if (player.getChips() <= minBet) {
+        if (f.chips > 0) {
+            int64_t minBet = std::min(f.bigBlind, f.chips);
+            if (f.chips <= minBet) {
                 // Only option is all-in.
-                actions.emplace_back(core::ActionType::AllIn, player.getChips(), playerId);
+                actions.emplace_back(core::ActionType::AllIn, f.chips, playerId);
             } else {
                 actions.emplace_back(core::ActionType::Bet, minBet, playerId);
-                if (player.getChips() > minBet) {
-                    actions.emplace_back(core::ActionType::AllIn, player.getChips(), playerId);
-                }
+                actions.emplace_back(core::ActionType::AllIn, f.chips, playerId);
             }
         }
+    } else if (f.toCall >= f.chips) {
+        // Calling would put us all-in.
+        actions.emplace_back(core::ActionType::AllIn, f.chips, playerId);
     } else {
-        // There is a bet to face.
-        if (callAmount >= player.getChips()) {
-            // Calling would put us all-in.
-            actions.emplace_back(core::ActionType::AllIn, player.getChips(), playerId);
+        actions.emplace_back(core::ActionType::Call, f.toCall, playerId);
+        if (!f.canRaise) {
+            return;
+        }
+        if (f.raiseChips >= f.chips) {
+            // Raising would be all-in.
+            actions.emplace_back(core::ActionType::AllIn, f.chips, playerId);
         } else {
-            actions.emplace_back(core::ActionType::Call, callAmount, playerId);
-
-            // Can raise.
-            int64_t minRaise = getMinRaise(state, playerId);
-            int64_t totalForMinRaise = minRaise - player.getCurrentBet();
-            if (totalForMinRaise >= player.getChips()) {
-                // Raising would be all-in.
-                actions.emplace_back(core::ActionType::AllIn, player.getChips(), playerId);
-            } else {
-                actions.emplace_back(core::ActionType::Raise, totalForMinRaise, playerId);
-                // All-in raise.
-                if (player.getChips() > totalForMinRaise) {
-                    actions.emplace_back(core::ActionType::AllIn, player.getChips(), playerId);
-                }
-            }
+            actions.emplace_back(core::ActionType::Raise, f.raiseChips, playerId);
+            actions.emplace_back(core::ActionType::AllIn, f.chips, playerId);
         }
     }
+}
 
-    return actions;
+/// Same answer as searching appendLegalActions' list, without building it.
+bool isLegal(const Facing& f, const core::Action& action) {
+    switch (action.type) {
+    case core::ActionType::Fold:
+        return true;
+    case core::ActionType::Check:
+        return f.toCall == 0;
+    case core::ActionType::Bet:
+        return f.toCall == 0 && f.chips > f.bigBlind &&
+               action.amount >= f.bigBlind && action.amount <= f.chips;
+    case core::ActionType::Call:
+        return f.toCall > 0 && f.toCall < f.chips && action.amount == f.toCall;
+    case core::ActionType::Raise:
+        return f.toCall > 0 && f.toCall < f.chips && f.canRaise &&
+               f.raiseChips < f.chips && action.amount >= f.raiseChips &&
+               action.amount <= f.chips;
+    case core::ActionType::AllIn:
+        // Facing a bet with chips to spare, going all-in is a raise.
+        return f.chips > 0 && action.amount == f.chips &&
+               (f.toCall == 0 || f.toCall >= f.chips || f.canRaise);
+    }
+    return false;
+}
+
+Facing facing(const core::GameState& state, const core::BettingRound& round,
+              const core::Player& player)
+{
+    Facing f;
+    f.chips = player.getChips();
+    f.toCall = std::min(round.getCurrentBet() - player.getCurrentBet(), f.chips);
+    f.bigBlind = state.getBigBlind();
+    const int64_t increment = std::max(round.getLastRaiseSize(), f.bigBlind);
+    f.raiseChips = round.getCurrentBet() + increment - player.getCurrentBet();
+    f.canRaise = round.canRaise(player.getId());
+    return f;
+}
+
+template <typename Out>
+void legalActionsFromState(const core::GameState& state, size_t playerId,
+                           Out& actions)
+{
+    actions.clear();
+    const auto& player = state.getPlayer(playerId);
+
+    if (player.isFolded() || player.isAllIn()) {
+        return; // No actions available.
+    }
+
+    Facing f;
+    f.chips = player.getChips();
+    f.toCall = RuleEngine::getCallAmount(state, playerId);
+    f.bigBlind = state.getBigBlind();
+    if (f.toCall > 0 && f.toCall < f.chips) {
+        f.raiseChips =
+            RuleEngine::getMinRaise(state, playerId) - player.getCurrentBet();
+    }
+    appendLegalActions(f, playerId, actions);
+}
+
+} // anonymous namespace
+
+void RuleEngine::getLegalActions(const core::GameState& state, size_t playerId,
+                                 std::vector<core::Action>& actions)
+{
+    legalActionsFromState(state, playerId, actions);
+}
+
+void RuleEngine::getLegalActions(const core::GameState& state, size_t playerId,
+                                 core::ActionList& actions)
+{
+    legalActionsFromState(state, playerId, actions);
+}
+
+void RuleEngine::getLegalActions(const core::GameState& state,
+                                 const core::BettingRound& round,
+                                 size_t playerId,
+                                 core::ActionList& actions)
+{
+    actions.clear();
+    const auto& player = state.getPlayer(playerId);
+    if (player.isFolded() || player.isAllIn()) {
+        return;
+    }
+    appendLegalActions(facing(state, round, player), playerId, actions);
 }
 
 bool RuleEngine::isActionLegal(const core::GameState& state,
                                const core::Action& action) {
-    auto legal = getLegalActions(state, action.playerId);
+    core::ActionList legal;
+    getLegalActions(state, action.playerId, legal);
+    return isActionLegal(state, action, legal);
+}
+
+bool RuleEngine::isActionLegal(const core::GameState& state,
+                               const core::BettingRound& round,
+                               const core::Action& action) {
+    const auto& player = state.getPlayer(action.playerId);
+    if (player.isFolded() || player.isAllIn()) {
+        return false;
+    }
+    return isLegal(facing(state, round, player), action);
+}
+
+int64_t RuleEngine::getMinRaise(const core::GameState& state,
+                                const core::BettingRound& round,
+                                size_t playerId) {
+    const auto& player = state.getPlayer(playerId);
+    const int64_t increment =
+        std::max(round.getLastRaiseSize(), state.getBigBlind());
+    return std::min(round.getCurrentBet() + increment,
+                    player.getCurrentBet() + player.getChips());
+}
+
+int64_t RuleEngine::getCallAmount(const core::GameState& state,
+                                  const core::BettingRound& round,
+                                  size_t playerId) {
+    const auto& player = state.getPlayer(playerId);
+    return std::min(round.getCurrentBet() - player.getCurrentBet(),
+                    player.getChips());
+}
+
+bool RuleEngine::isActionLegal(const core::GameState& state,
+                               const core::Action& action,
+                               std::span<const core::Action> legal) {
     for (const auto& a : legal) {
         if (a.type == action.type) {
             if (a.type == core::ActionType::Fold || a.type == core::ActionType::Check) {
@@ -127,4 +248,59 @@ bool RuleEngine::isActionLegal(const core::GameState& state,
     return false;
 }
 
+size_t RuleEngine::getFirstToAct(const core::GameState& state) {
+    const auto& players = state.getPlayers();
+    size_t numPlayers = players.size();
+
+    size_t startPos;
+    if (state.getStreet() == core::Street::Preflop) {
+        // First to act is left of BB.
+        startPos = (state.getBigBlindPosition() + 1) % numPlayers;
+    } else {
+        // First to act is left of dealer.
+        startPos = (state.getDealerPosition() + 1) % numPlayers;
+    }
+
+    // Find first active player.
+    for (size_t i = 0; i < numPlayers; ++i) {
+        size_t idx = (startPos + i) % numPlayers;
+        if (!players[idx].isFolded() && !players[idx].isAllIn()) {
+            return idx;
+        }
+    }
+    return startPos;
+}
+
+PotSplit RuleEngine::splitPot(const core::SidePot& pot,
+                              std::span<const core::Player> players,
+                              core::CardSet board) {
+    PotSplit split;
+    for (core::SeatMask m = pot.eligible; m != 0; m &= m - 1) {
+        const auto seat = static_cast<size_t>(std::countr_zero(m));
+        const auto strength = utils::HandEvaluator::evaluateStrength(
+            players[seat].getHoleCardSet() | board);
+        if (split.winners == 0 || strength > split.strength) {
+            split.strength = strength;
+            split.winners = 0;
+        }
+        if (strength == split.strength) {
+            split.winners |= core::seatBit(seat);
+        }
+    }
+    if (split.winners == 0) {
+        return split;
+    }
+
+    const auto numWinners =
+        static_cast<int64_t>(std::popcount(split.winners));
+    split.share = pot.amount / numWinners;
+    int64_t remainder = pot.amount % numWinners;
+    for (core::SeatMask m = split.winners; remainder > 0; m &= m - 1) {
+        split.oddChips |=
+            core::seatBit(static_cast<size_t>(std::countr_zero(m)));
+        --remainder;
+    }
+    return split;
+}
+
 } // namespace poker::engine
@@ -0,0 +1,186 @@
+#include "sim/SelfPlayRunner.h"
+#include "core/Random.h"
+#include "core/SeatMask.h"
+#include "engine/PokerEngine.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace poker::sim {
+
+namespace {
+
+/// Routes each seat's decisions to the strategy sitting there. Held by
+/// value in the engine, so only the strategy call itself is virtual.
+class SeatedStrategies {
+public:
+  explicit SeatedStrategies(
+      std::vector<std::unique_ptr<interfaces::IPlayerStrategy>> seats)
+      : seats_(std::move(seats)) {}
+
+  core::Action getAction(size_t playerId, const core::GameState &state,
+                         const std::vector<core::Action> &legal) {
+    return seats_[playerId]->getAction(state, legal);
+  }
+
+private:
+  std::vector<std::unique_ptr<interfaces::IPlayerStrategy>> seats_;
+};
+
+/// Per-strategy sums for one table.
+struct Tally {
+  uint64_t seatHands = 0;
+  int64_t net = 0;
+  double sumSquares = 0.0; ///< Of per-hand results in big blinds.
+};
+
+} // anonymous namespace
+
+SelfPlayRunner::SelfPlayRunner(SelfPlayConfig config)
+    : config_(std::move(config)) {}
+
+void SelfPlayRunner::addStrategy(std::string name, StrategyFactory factory) {
+  if (!factory)
+    throw std::invalid_argument(
+        "SelfPlayRunner: strategy factory cannot be empty");
+  names_.push_back(std::move(name));
+  factories_.push_back(std::move(factory));
+}
+
+uint64_t SelfPlayRunner::tableSeed(uint64_t seed, size_t table) noexcept {
+  return core::splitMix64(seed ^ core::splitMix64(table + 1));
+}
+
+size_t SelfPlayRunner::seatsPerTable() const noexcept {
+  return config_.seatsPerTable != 0 ? config_.seatsPerTable : names_.size();
+}
+
+SelfPlayResult SelfPlayRunner::run(size_t threads) const {
+  const size_t numStrategies = names_.size();
+  const size_t seats = seatsPerTable();
+  if (numStrategies == 0)
+    throw std::invalid_argument("SelfPlayRunner: no strategies registered");
+  if (seats < 2 || seats > engine::kMaxTableSeats)
+    throw std::invalid_argument("SelfPlayRunner: need 2 to 22 seats per table");
+  if (config_.bigBlind <= 0 || config_.smallBlind < 0 ||
+      config_.startingStack < config_.bigBlind)
+    throw std::invalid_argument("SelfPlayRunner: bad blinds or stack");
+  if (config_.numTables > std::numeric_limits<uint32_t>::max())
+    throw std::invalid_argument("SelfPlayRunner: at most 2^32 tables");
+
+  const double bb = static_cast<double>(config_.bigBlind);
+  std::vector<Tally> tallies(config_.numTables * numStrategies);
+
+  utils::ThreadPool pool(threads);
+  const auto start = std::chrono::steady_clock::now();
+
+  pool.parallelFor(config_.numTables, [&](size_t table, size_t) {
+    const uint64_t seed = tableSeed(config_.seed, table);
+
+    // Seat s holds strategy (s + table) mod numStrategies.
+    std::vector<size_t> strategyAt(seats);
+    std::vector<std::unique_ptr<interfaces::IPlayerStrategy>> instances;
+    core::GameState fresh;
+    std::vector<core::Player> players;
+    for (size_t s = 0; s < seats; ++s) {
+      strategyAt[s] = (s + table) % numStrategies;
+      instances.push_back(factories_[strategyAt[s]](
+          core::splitMix64(seed ^ core::splitMix64(s + 1))));
+      players.emplace_back(s, names_[strategyAt[s]], config_.startingStack);
+    }
+    fresh.setPlayers(std::move(players));
+    fresh.setSmallBlind(config_.smallBlind);
+    fresh.setBigBlind(config_.bigBlind);
+
+    engine::BasicPokerEngine<SeatedStrategies, core::PhiloxGenerator,
+                             engine::NullObserver>
+        engine(SeatedStrategies(std::move(instances)),
+               deckGenerator(config_.seed, table, 0));
+
+    Tally *tally = &tallies[table * numStrategies];
+    core::GameState state = fresh;
+    for (size_t hand = 0; hand < config_.handsPerTable; ++hand) {
+      state = fresh;
+      state.setDealerPosition(hand % seats);
+      engine.playHand(state);
+      for (size_t s = 0; s < seats; ++s) {
+        const int64_t net =
+            state.getPlayer(s).getChips() - config_.startingStack;
+        const double inBb = static_cast<double>(net) / bb;
+        Tally &t = tally[strategyAt[s]];
+        ++t.seatHands;
+        t.net += net;
+        t.sumSquares += inBb * inBb;
+      }
+    }
+  });
+
+  const double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+
+  SelfPlayResult result;
+  result.hands = static_cast<uint64_t>(config_.numTables) *
+                 static_cast<uint64_t>(config_.handsPerTable);
+  result.threads = pool.size();
+  result.elapsedSeconds = elapsed;
+  result.handsPerSecond =
+      elapsed > 0.0 ? static_cast<double>(result.hands) / elapsed : 0.0;
+
+  for (size_t k = 0; k < numStrategies; ++k) {
+    Tally total;
+    for (size_t table = 0; table < config_.numTables; ++table) {
+      const Tally &t = tallies[table * numStrategies + k];
+      total.seatHands += t.seatHands;
+      total.net += t.net;
+      total.sumSquares += t.sumSquares;
+    }
+
+    StrategyResult r;
+    r.name = names_[k];
+    r.seatHands = total.seatHands;
+    r.netChips = total.net;
+    if (total.seatHands > 0) {
+      const double n = static_cast<double>(total.seatHands);
+      const double mean = static_cast<double>(total.net) / bb / n;
+      r.bbPer100 = 100.0 * mean;
+      if (total.seatHands > 1) {
+        const double variance =
+            std::max(0.0, (total.sumSquares - n * mean * mean) / (n - 1.0));
+        r.ci95 = 100.0 * 1.96 * std::sqrt(variance / n);
+      }
+    }
+    result.strategies.push_back(std::move(r));
+  }
+  return result;
+}
+
+std::vector<ScalingPoint>
+SelfPlayRunner::measureScaling(std::span<const size_t> threadCounts) const {
+  std::vector<ScalingPoint> points;
+  for (size_t threads : threadCounts) {
+    const SelfPlayResult r = run(threads);
+    ScalingPoint p;
+    p.threads = r.threads;
+    p.handsPerSecond = r.handsPerSecond;
+    if (points.empty()) {
+      p.speedup = 1.0;
+      p.efficiency = 1.0;
+    } else {
+      const ScalingPoint &base = points.front();
+      p.speedup = base.handsPerSecond > 0.0
+                      ? p.handsPerSecond / base.handsPerSecond
+                      : 0.0;
+      p.efficiency = p.speedup * static_cast<double>(base.threads) /
+                     static_cast<double>(p.threads);
+    }
+    points.push_back(p);
+  }
+  return points;
+}
+
+} // namespace poker::sim
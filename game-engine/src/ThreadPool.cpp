@@ -0,0 +1,150 @@
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+
+namespace poker::utils {
+
+ThreadPool::ThreadPool(size_t numThreads) {
+  if (numThreads == 0) {
+    numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(numThreads - 1);
+  for (size_t i = 1; i < numThreads; ++i) {
+    workers_.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &w : workers_) {
+    w.join();
+  }
+}
+
+void ThreadPool::runOnAll(const std::function<void(size_t)> &fn) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &fn;
+    pending_ = workers_.size();
+    error_ = nullptr;
+    ++generation_;
+  }
+  wake_.notify_all();
+
+  std::exception_ptr callerError;
+  try {
+    fn(0);
+  } catch (...) {
+    callerError = std::current_exception();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return pending_ == 0; });
+  job_ = nullptr;
+  if (callerError)
+    std::rethrow_exception(callerError);
+  if (error_)
+    std::rethrow_exception(error_);
+}
+
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t, size_t)> &fn) {
+  if (count == 0)
+    return;
+
+  // Per-worker slice [next, end). Owners take from the front, thieves from
+  // the back; padded so neighbouring slices do not share a cache line.
+  struct alignas(64) Slice {
+    std::mutex mutex;
+    size_t next = 0;
+    size_t end = 0;
+  };
+  const size_t n = size();
+  std::vector<Slice> slices(n);
+  for (size_t w = 0; w < n; ++w) {
+    slices[w].next = count * w / n;
+    slices[w].end = count * (w + 1) / n;
+  }
+
+  auto steal = [&](size_t thief) {
+    while (true) {
+      size_t victim = n;
+      size_t most = 0;
+      for (size_t w = 0; w < n; ++w) {
+        std::lock_guard<std::mutex> lock(slices[w].mutex);
+        const size_t left = slices[w].end - slices[w].next;
+        if (w != thief && left > most) {
+          most = left;
+          victim = w;
+        }
+      }
+      if (victim == n)
+        return false;
+
+      size_t from, to;
+      {
+        std::lock_guard<std::mutex> lock(slices[victim].mutex);
+        const size_t left = slices[victim].end - slices[victim].next;
+        if (left == 0)
+          continue; // Drained meanwhile; look again.
+        to = slices[victim].end;
+        from = to - (left + 1) / 2;
+        slices[victim].end = from;
+      }
+      std::lock_guard<std::mutex> lock(slices[thief].mutex);
+      slices[thief].next = from;
+      slices[thief].end = to;
+      return true;
+    }
+  };
+
+  runOnAll([&](size_t worker) {
+    Slice &own = slices[worker];
+    while (true) {
+      size_t index;
+      {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        index = own.next < own.end ? own.next++ : count;
+      }
+      if (index < count) {
+        fn(index, worker);
+      } else if (!steal(worker)) {
+        return;
+      }
+    }
+  });
+}
+
+void ThreadPool::workerLoop(size_t index) {
+  uint64_t seen = 0;
+  while (true) {
+    const std::function<void(size_t)> *job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+      if (stopping_)
+        return;
+      seen = generation_;
+      job = job_;
+    }
+
+    std::exception_ptr error;
+    try {
+      (*job)(index);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error && !error_)
+      error_ = error;
+    if (--pending_ == 0)
+      done_.notify_one();
+  }
+}
+
+} // namespace poker::utils
@@ -0,0 +1,216 @@
+#include "core/BettingRound.h"
+#include "core/Deck.h"
+#include "core/Random.h"
+#include "engine/ActionAbstraction.h"
+#include "engine/GameTreeCursor.h"
+#include "engine/RuleEngine.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+using namespace poker::test;
+
+namespace {
+
+/// Heads-up on the flop with 100 each in the pot and no bets yet.
+GameState flopPot(int64_t stack) {
+  GameState state;
+  std::vector<Player> players;
+  players.emplace_back(0, "A", stack);
+  players.emplace_back(1, "B", stack);
+  state.setPlayers(std::move(players));
+  state.setBigBlind(10);
+  state.setStreet(Street::Flop);
+  state.getMutablePot().addContribution(0, 100);
+  state.getMutablePot().addContribution(1, 100);
+  return state;
+}
+
+std::vector<Action> expanded(const ActionAbstraction &abstraction,
+                             const GameState &state,
+                             const BettingRound &round, size_t seat) {
+  ActionList legal;
+  RuleEngine::getLegalActions(state, round, seat, legal);
+  std::vector<Action> out;
+  abstraction.expand(state, legal, round.getNumRaises(), out);
+  return out;
+}
+
+} // namespace
+
+TEST(ActionAbstractionTest, BetsArePotFractionsClampedToTheRules) {
+  const GameState state = flopPot(1000);
+  const BettingRound round(2, 0, seatBit(0) | seatBit(1), 0, 10);
+  ActionAbstraction abstraction;
+  // 0.01 pot is below the big blind; 6 pots is more than the stack.
+  abstraction.setSizes(Street::Flop, 0, {1.5, 0.33, 0.75, 0.01, 6.0});
+
+  const std::vector<Action> want = {
+      Action(ActionType::Fold, 0, 0),   Action(ActionType::Check, 0, 0),
+      Action(ActionType::Bet, 10, 0),   Action(ActionType::Bet, 66, 0),
+      Action(ActionType::Bet, 150, 0),  Action(ActionType::Bet, 300, 0),
+      Action(ActionType::AllIn, 1000, 0)};
+  const auto got = expanded(abstraction, state, round, 0);
+  EXPECT_EQ(got, want);
+  for (const Action &a : got)
+    EXPECT_TRUE(RuleEngine::isActionLegal(state, round, a)) << a;
+}
+
+TEST(ActionAbstractionTest, RaisesAreSizedAfterCalling) {
+  GameState state = flopPot(1000);
+  BettingRound round(2, 1, seatBit(0) | seatBit(1), 0, 10);
+  state.getMutablePot().addContribution(
+      1, state.getMutablePlayer(1).placeBet(100));
+  round.playerActed(100, true);
+
+  ActionAbstraction abstraction;
+  abstraction.setSizes(Street::Flop, 0, {0.5});
+  abstraction.setSizes(Street::Flop, 1, {0.1, 1.0});
+  // Call 100 into 300, then a pot raise of 400 more; 0.1 pot is below the
+  // minimum raise to 200.
+  const std::vector<Action> want = {
+      Action(ActionType::Fold, 0, 0), Action(ActionType::Call, 100, 0),
+      Action(ActionType::Raise, 200, 0), Action(ActionType::Raise, 500, 0),
+      Action(ActionType::AllIn, 1000, 0)};
+  EXPECT_EQ(expanded(abstraction, state, round, 0), want);
+
+  // Facing more than its stack, a player just has fold and all-in.
+  GameState shortStack = flopPot(60);
+  BettingRound shortRound(2, 1, seatBit(0) | seatBit(1), 0, 10);
+  shortStack.getMutablePot().addContribution(
+      1, shortStack.getMutablePlayer(1).placeBet(60));
+  shortRound.playerActed(60, false);
+  EXPECT_EQ(expanded(abstraction, shortStack, shortRound, 0).size(), 2u);
+}
+
+TEST(ActionAbstractionTest, SizesFollowStreetAndRaiseCount) {
+  ActionAbstraction abstraction;
+  EXPECT_TRUE(abstraction.getSizes(Street::Preflop, 0).empty());
+  abstraction.setSizes(Street::Turn, 0, {0.75, 0.5, 0.75});
+  abstraction.setSizes(Street::Turn, 2, {2.0});
+  EXPECT_EQ(std::vector<double>(abstraction.getSizes(Street::Turn, 0).begin(),
+                                abstraction.getSizes(Street::Turn, 0).end()),
+            (std::vector<double>{0.5, 0.75}));
+  EXPECT_TRUE(abstraction.getSizes(Street::Turn, 1).empty());
+  EXPECT_EQ(abstraction.getSizes(Street::Turn, 5).front(), 2.0);
+  EXPECT_TRUE(abstraction.getSizes(Street::River, 0).empty());
+  EXPECT_TRUE(abstraction.getSizes(Street::Showdown, 0).empty());
+
+  EXPECT_THROW(abstraction.setSizes(Street::Showdown, 0, {1.0}),
+               std::invalid_argument);
+  EXPECT_THROW(abstraction.setSizes(Street::Flop, 0, {0.5, -1.0}),
+               std::invalid_argument);
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(abstraction.setSizes(Street::Flop, 0, {inf}),
+               std::invalid_argument);
+}
+
+TEST(ActionAbstractionTest, TranslatesBetsPseudoHarmonically) {
+  EXPECT_DOUBLE_EQ(ActionAbstraction::pseudoHarmonic(0.5, 1.0, 0.5), 1.0);
+  EXPECT_DOUBLE_EQ(ActionAbstraction::pseudoHarmonic(0.5, 1.0, 1.0), 0.0);
+  EXPECT_DOUBLE_EQ(ActionAbstraction::pseudoHarmonic(0.5, 1.0, 0.75),
+                   0.25 * 1.5 / (0.5 * 1.75));
+
+  const GameState state = flopPot(1000);
+  const BettingRound round(2, 0, seatBit(0) | seatBit(1), 0, 10);
+  ActionAbstraction abstraction;
+  abstraction.setSizes(Street::Flop, 0, {0.5, 1.0});
+  // Fold, Check, Bet 100, Bet 200, AllIn 1000.
+  const auto abs = expanded(abstraction, state, round, 0);
+  ASSERT_EQ(abs.size(), 5u);
+
+  const auto check = ActionAbstraction::translate(
+      state, abs, Action(ActionType::Check, 0, 0));
+  EXPECT_EQ(check.lower, 1u);
+  EXPECT_EQ(check.upper, 1u);
+
+  // 150 is 0.75 pot, between the half-pot and pot bets.
+  const auto mid = ActionAbstraction::translate(
+      state, abs, Action(ActionType::Bet, 150, 0));
+  EXPECT_EQ(mid.lower, 2u);
+  EXPECT_EQ(mid.upper, 3u);
+  EXPECT_DOUBLE_EQ(mid.lowerWeight, 0.25 * 1.5 / (0.5 * 1.75));
+
+  const auto exact = ActionAbstraction::translate(
+      state, abs, Action(ActionType::Bet, 200, 0));
+  EXPECT_EQ(exact.lower, 3u);
+  EXPECT_EQ(exact.lowerWeight, 1.0);
+
+  const auto small = ActionAbstraction::translate(
+      state, abs, Action(ActionType::Bet, 20, 0));
+  EXPECT_EQ(small.lower, 2u);
+  EXPECT_EQ(small.upper, 2u);
+
+  // An overbet lands between the pot bet and the all-in.
+  const auto over = ActionAbstraction::translate(
+      state, abs, Action(ActionType::Bet, 600, 0));
+  EXPECT_EQ(over.lower, 3u);
+  EXPECT_EQ(over.upper, 4u);
+  EXPECT_GT(over.lowerWeight, 0.0);
+  EXPECT_LT(over.lowerWeight, 1.0);
+
+  EXPECT_THROW((void)ActionAbstraction::translate(
+                   state, abs, Action(ActionType::Call, 10, 0)),
+               std::invalid_argument);
+}
+
+TEST(ActionAbstractionTest, EveryExpandedActionPlaysThroughTheCursor) {
+  ActionAbstraction abstraction;
+  for (size_t s = 0; s < ActionAbstraction::kNumStreets; ++s) {
+    abstraction.setSizes(static_cast<Street>(s), 0, {0.33, 0.75, 1.5});
+    abstraction.setSizes(static_cast<Street>(s), 1, {0.7, 2.5});
+  }
+  Xoshiro256Generator rng(17);
+  std::vector<Action> actions;
+  size_t decisions = 0;
+  for (size_t hand = 0; hand < 200; ++hand) {
+    GameState state = makeTable({400, 700, 1000}, hand % 3);
+    state.resetForNewHand();
+    Deck deck;
+    for (auto &p : state.getMutablePlayers()) {
+      p.dealCard(*deck.deal());
+      p.dealCard(*deck.deal());
+    }
+    for (size_t seat : {state.getSmallBlindPosition(),
+                        state.getBigBlindPosition()}) {
+      const int64_t blind = seat == state.getBigBlindPosition() ? 10 : 5;
+      state.getMutablePot().addContribution(
+          seat, state.getMutablePlayer(seat).placeBet(blind));
+      state.recordAction(Action(ActionType::Bet, blind, seat));
+    }
+
+    GameTreeCursor cursor(state);
+    while (!cursor.isTerminal()) {
+      if (cursor.getNodeType() == GameTreeCursor::NodeType::Chance) {
+        std::array<Card, 3> cards;
+        const CardSet dealt = state.getDealtCardSet();
+        size_t n = 0;
+        for (unsigned i = 0; n < cursor.cardsNeeded(); ++i) {
+          if (!dealt.contains(CardSet::fromIndex(i)))
+            cards[n++] = CardSet::fromIndex(i);
+        }
+        cursor.dealBoard(std::span<const Card>(cards.data(), n));
+        continue;
+      }
+      abstraction.expand(cursor, actions);
+      ASSERT_FALSE(actions.empty());
+      for (size_t i = 1; i < actions.size(); ++i)
+        EXPECT_NE(actions[i], actions[i - 1]);
+      // Favour the bets, so hands reach re-raises and all-ins.
+      const size_t pick =
+          actions.size() - 1 -
+          rng.below(static_cast<uint32_t>(std::min<size_t>(actions.size(), 4)));
+      ASSERT_NO_THROW(cursor.apply(actions[pick]));
+      ++decisions;
+    }
+  }
+  EXPECT_GT(decisions, 600u);
+}
@@ -0,0 +1,123 @@
+#include "core/ActionList.h"
+#include "core/Random.h"
+#include "engine/PokerEngine.h"
+#include "engine/RuleEngine.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+using namespace poker::test;
+
+namespace {
+
+/// Counts which overload the engine calls; both choose the same way.
+class CountingProvider : public poker::interfaces::IActionProvider {
+public:
+  Action getAction(size_t, const GameState &,
+                   const std::vector<Action> &legal) override {
+    ++vectorCalls;
+    return legal[legal.size() / 2];
+  }
+  Action chooseAction(size_t, const GameState &,
+                      const ActionList &legal) override {
+    ++listCalls;
+    return legal[legal.size() / 2];
+  }
+
+  size_t vectorCalls = 0;
+  size_t listCalls = 0;
+};
+
+/// Implements only the vector overload, like most providers.
+class VectorOnlyProvider : public poker::interfaces::IActionProvider {
+public:
+  Action getAction(size_t, const GameState &,
+                   const std::vector<Action> &legal) override {
+    return legal.back();
+  }
+};
+
+} // namespace
+
+TEST(ActionListTest, StoresActionsInlineWithATypeMask) {
+  ActionList list;
+  EXPECT_TRUE(list.empty());
+  list.emplace_back(ActionType::Fold, 0, 3);
+  list.emplace_back(ActionType::Call, 40, 3);
+  list.push_back(Action(ActionType::AllIn, 900, 3));
+  ASSERT_EQ(list.size(), 3u);
+  EXPECT_EQ(list.types(), actionTypeBit(ActionType::Fold) |
+                              actionTypeBit(ActionType::Call) |
+                              actionTypeBit(ActionType::AllIn));
+  EXPECT_TRUE(list.contains(ActionType::Call));
+  EXPECT_FALSE(list.contains(ActionType::Raise));
+  ASSERT_NE(list.find(ActionType::AllIn), nullptr);
+  EXPECT_EQ(list.find(ActionType::AllIn)->amount, 900);
+  EXPECT_EQ(list.find(ActionType::Check), nullptr);
+
+  const std::span<const Action> view = list;
+  EXPECT_EQ(view.size(), 3u);
+  EXPECT_EQ(view[1], Action(ActionType::Call, 40, 3));
+
+  for (size_t i = list.size(); i < ActionList::kCapacity; ++i)
+    list.emplace_back(ActionType::Check, 0, 3);
+  EXPECT_THROW(list.emplace_back(ActionType::Check, 0, 3), std::length_error);
+  list.clear();
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.types(), 0);
+}
+
+TEST(ActionListTest, RulesFillItLikeAVector) {
+  GameState state;
+  std::vector<Player> players;
+  players.emplace_back(0, "A", 1000);
+  players.emplace_back(1, "B", 60);
+  players.emplace_back(2, "C", 5);
+  state.setPlayers(std::move(players));
+  state.setBigBlind(10);
+  state.setStreet(Street::Flop);
+
+  ActionList list;
+  std::vector<Action> vec;
+  for (int64_t bet : {0, 10, 50, 200}) {
+    Player &bettor = state.getMutablePlayer(0);
+    if (bet > bettor.getCurrentBet())
+      (void)bettor.placeBet(bet - bettor.getCurrentBet());
+    for (size_t seat = 0; seat < 3; ++seat) {
+      RuleEngine::getLegalActions(state, seat, list);
+      RuleEngine::getLegalActions(state, seat, vec);
+      ASSERT_EQ(list.size(), vec.size());
+      for (size_t i = 0; i < vec.size(); ++i)
+        EXPECT_EQ(list[i], vec[i]);
+    }
+  }
+}
+
+TEST(ActionListTest, EngineGivesProvidersTheList) {
+  auto provider = std::make_shared<CountingProvider>();
+  BasicPokerEngine<SharedActionProvider, Xoshiro256Generator, NullObserver>
+      engine(provider, Xoshiro256Generator(3));
+  for (size_t h = 0; h < 20; ++h) {
+    GameState state = makeTable(4, 500, h % 4);
+    engine.playHand(state);
+  }
+  EXPECT_GT(provider->listCalls, 0u);
+  EXPECT_EQ(provider->vectorCalls, 0u);
+}
+
+TEST(ActionListTest, VectorOnlyProvidersTakeTheListToo) {
+  ActionList list;
+  list.emplace_back(ActionType::Fold, 0, 1);
+  list.emplace_back(ActionType::Call, 10, 1);
+  VectorOnlyProvider provider;
+  const GameState state;
+  // Callable on the derived type: chooseAction() is not hidden.
+  EXPECT_EQ(provider.chooseAction(1, state, list), list[1]);
+}
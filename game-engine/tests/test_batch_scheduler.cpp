@@ -0,0 +1,168 @@
+#include "engine/BatchScheduler.h"
+#include "engine/PokerEngine.h"
+#include "interfaces/IActionProvider.h"
+#include "interfaces/IBatchActionProvider.h"
+#include "interfaces/IRandomGenerator.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+
+using namespace poker::core;
+using namespace poker::engine;
+using namespace poker::test;
+using poker::interfaces::BatchDecision;
+
+namespace {
+
+class SeededRNG : public poker::interfaces::IRandomGenerator {
+public:
+  explicit SeededRNG(uint64_t seed) : engine_(seed) {}
+  void shuffle(std::vector<Card> &cards) override {
+    std::shuffle(cards.begin(), cards.end(), engine_);
+  }
+
+private:
+  std::mt19937_64 engine_;
+};
+
+class ChooseBatchProvider : public poker::interfaces::IBatchActionProvider {
+public:
+  void getActions(std::span<const BatchDecision> decisions,
+                  std::span<Action> actions) override {
+    batchSizes.push_back(decisions.size());
+    for (size_t i = 0; i < decisions.size(); ++i) {
+      EXPECT_EQ(decisions[i].playerId,
+                decisions[i].state->getCurrentPlayerIndex());
+      actions[i] =
+          chooseByHistory(*decisions[i].state, decisions[i].legalActions);
+    }
+  }
+
+  std::vector<size_t> batchSizes;
+};
+
+/// Next hand: fresh stacks, button moves on.
+void nextHand(GameState &state) {
+  for (auto &p : state.getMutablePlayers())
+    p.restoreBettingState(1000, 0, false, false);
+  state.setDealerPosition((state.getDealerPosition() + 1) % 4);
+}
+
+} // anonymous namespace
+
+TEST(BatchSchedulerTest, MatchesSequentialPlay) {
+  constexpr size_t kTables = 24;
+  constexpr size_t kHands = 8;
+
+  std::vector<GameState> expected(kTables);
+  std::vector<int64_t> expectedNet(kTables, 0);
+  auto single = std::make_shared<HistoryProvider>();
+  for (size_t t = 0; t < kTables; ++t) {
+    PokerEngine engine(single, std::make_shared<SeededRNG>(t));
+    expected[t] = makeTable(4, 1000);
+    for (size_t h = 0; h < kHands; ++h) {
+      if (h > 0)
+        nextHand(expected[t]);
+      engine.playHand(expected[t]);
+      expectedNet[t] += expected[t].getPlayer(0).getChips() - 1000;
+    }
+  }
+
+  auto batched = std::make_shared<ChooseBatchProvider>();
+  BatchScheduler scheduler(batched, {8, std::chrono::hours(1)});
+  std::vector<GameState> tables(kTables);
+  std::vector<size_t> hands(kTables, 0);
+  std::vector<int64_t> net(kTables, 0);
+  for (size_t t = 0; t < kTables; ++t) {
+    tables[t] = makeTable(4, 1000);
+    EXPECT_EQ(scheduler.addTable(std::make_shared<SeededRNG>(t), tables[t]),
+              t);
+  }
+  scheduler.run([&](size_t t, GameState &state) {
+    net[t] += state.getPlayer(0).getChips() - 1000;
+    if (++hands[t] == kHands)
+      return false;
+    nextHand(state);
+    return true;
+  });
+
+  EXPECT_EQ(net, expectedNet);
+  for (size_t t = 0; t < kTables; ++t) {
+    EXPECT_EQ(tables[t].getActionHistory().size(),
+              expected[t].getActionHistory().size());
+    EXPECT_EQ(tables[t].getCommunityCardSet(),
+              expected[t].getCommunityCardSet());
+  }
+
+  const BatchStats &stats = scheduler.getStats();
+  EXPECT_EQ(stats.hands, kTables * kHands);
+  EXPECT_EQ(stats.batches, batched->batchSizes.size());
+  EXPECT_EQ(stats.largestBatch, 8u);
+  EXPECT_EQ(stats.deadlineFlushes, 0u);
+  uint64_t decisions = 0;
+  for (size_t size : batched->batchSizes) {
+    EXPECT_LE(size, 8u);
+    decisions += size;
+  }
+  EXPECT_EQ(stats.decisions, decisions);
+}
+
+TEST(BatchSchedulerTest, FlushesPartialBatchWhenNoTableCanProceed) {
+  // Three tables can never fill a batch of 100: each round of decisions
+  // goes out as soon as every table is parked.
+  auto provider = std::make_shared<ChooseBatchProvider>();
+  BatchScheduler scheduler(provider, {100, std::chrono::hours(1)});
+  std::vector<GameState> tables(3);
+  for (size_t t = 0; t < tables.size(); ++t) {
+    tables[t] = makeTable(4, 1000);
+    scheduler.addTable(std::make_shared<SeededRNG>(t), tables[t]);
+  }
+  scheduler.run([](size_t, GameState &) { return false; });
+
+  EXPECT_EQ(scheduler.getStats().hands, 3u);
+  ASSERT_FALSE(provider->batchSizes.empty());
+  EXPECT_EQ(provider->batchSizes.front(), 3u);
+  EXPECT_EQ(scheduler.getStats().deadlineFlushes, 0u);
+}
+
+TEST(BatchSchedulerTest, DeadlineSendsPartialBatches) {
+  // With no wait allowed, every decision is sent on its own.
+  auto provider = std::make_shared<ChooseBatchProvider>();
+  BatchScheduler scheduler(provider, {64, std::chrono::microseconds(0)});
+  std::vector<GameState> tables(16);
+  for (size_t t = 0; t < tables.size(); ++t) {
+    tables[t] = makeTable(4, 1000);
+    scheduler.addTable(std::make_shared<SeededRNG>(t), tables[t]);
+  }
+  scheduler.run([](size_t, GameState &) { return false; });
+
+  const BatchStats &stats = scheduler.getStats();
+  EXPECT_EQ(stats.largestBatch, 1u);
+  EXPECT_EQ(stats.batches, stats.decisions);
+  EXPECT_GT(stats.deadlineFlushes, 0u);
+}
+
+TEST(BatchSchedulerTest, RejectsBadConfigurationAndIllegalActions) {
+  EXPECT_THROW(BatchScheduler(nullptr), std::invalid_argument);
+  EXPECT_THROW(BatchScheduler(std::make_shared<ChooseBatchProvider>(),
+                              {0, std::chrono::microseconds(0)}),
+               std::invalid_argument);
+
+  class CheckingProvider : public poker::interfaces::IBatchActionProvider {
+  public:
+    void getActions(std::span<const BatchDecision>,
+                    std::span<Action> actions) override {
+      std::fill(actions.begin(), actions.end(),
+                Action(ActionType::Check, 0, 0));
+    }
+  };
+  BatchScheduler scheduler(std::make_shared<CheckingProvider>());
+  GameState state = makeTable(4, 1000);
+  scheduler.addTable(std::make_shared<SeededRNG>(1), state);
+  // Checking into the big blind preflop is illegal.
+  EXPECT_THROW(scheduler.run([](size_t, GameState &) { return false; }),
+               std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+#include "core/BettingRound.h"
+#include <gtest/gtest.h>
+
+
+using namespace poker::core;
+
+namespace {
+
+SeatMask seats(std::initializer_list<size_t> list) {
+  SeatMask m = 0;
+  for (size_t s : list)
+    m |= seatBit(s);
+  return m;
+}
+
+} // namespace
+
+TEST(BettingRoundTest, EveryoneChecksOnce) {
+  BettingRound round(3, 1, seats({0, 1, 2}));
+  EXPECT_EQ(round.getCurrentPlayerIndex(), 1u);
+  round.playerActed(0, true);
+  EXPECT_EQ(round.getCurrentPlayerIndex(), 2u);
+  round.playerActed(0, true);
+  EXPECT_EQ(round.getCurrentPlayerIndex(), 0u); // wraps
+  EXPECT_FALSE(round.isComplete());
+  round.playerActed(0, true);
+  EXPECT_TRUE(round.isComplete());
+  EXPECT_EQ(round.getActionsThisRound(), 3u);
+}
+
+TEST(BettingRoundTest, SkipsSeatsThatCannotAct) {
+  // Seat 1 is folded or all-in; action starts there but moves to seat 2.
+  BettingRound round(4, 1, seats({0, 2, 3}));
+  EXPECT_EQ(round.getCurrentPlayerIndex(), 2u);
+  EXPECT_FALSE(round.needsToAct(1));
+}
+
+TEST(BettingRoundTest, RaiseReopensAction) {
+  BettingRound round(3, 0, seats({0, 1, 2}));
+  round.playerActed(0, true);   // seat 0 checks
+  round.playerActed(50, true);  // seat 1 bets
+  EXPECT_EQ(round.getNumRaises(), 1u);
+  EXPECT_EQ(round.getLastAggressor(), 1u);
+  EXPECT_EQ(round.getPendingSeats(), seats({0, 2}));
+  round.playerActed(50, true);  // seat 2 calls
+  EXPECT_EQ(round.getCurrentPlayerIndex(), 0u);
+  round.playerActed(50, true);  // seat 0 calls
+  EXPECT_TRUE(round.isComplete());
+}
+
+TEST(BettingRoundTest, FoldAndAllInLeaveTheRound) {
+  BettingRound round(3, 0, seats({0, 1, 2}), 10);
+  round.playerActed(0, false);   // seat 0 folds
+  round.playerActed(200, false); // seat 1 shoves
+  EXPECT_EQ(round.getActiveSeats(), seats({2}));
+  EXPECT_EQ(round.getPendingSeats(), seats({2}));
+  round.playerActed(200, true); // seat 2 calls
+  EXPECT_TRUE(round.isComplete());
+}
+
+TEST(BettingRoundTest, AllInCallDoesNotReopen) {
+  BettingRound round(3, 0, seats({0, 1, 2}));
+  round.playerActed(100, true); // seat 0 bets
+  round.playerActed(100, false); // seat 1 calls all-in for exactly 100
+  EXPECT_EQ(round.getPendingSeats(), seats({2}));
+}
+
+TEST(BettingRoundTest, SkipCurrentDoesNotCountAsAction) {
+  BettingRound round(2, 0, seats({0, 1}));
+  round.skipCurrent();
+  EXPECT_EQ(round.getActionsThisRound(), 0u);
+  EXPECT_EQ(round.getCurrentPlayerIndex(), 1u);
+  round.playerActed(0, true);
+  EXPECT_TRUE(round.isComplete());
+}
+
+TEST(BettingRoundTest, HandlesTheLastSeatOfAFullMask) {
+  BettingRound round(kMaxSeats, kMaxSeats - 1, ~SeatMask{0});
+  EXPECT_EQ(round.getCurrentPlayerIndex(), kMaxSeats - 1);
+  round.playerActed(0, true);
+  EXPECT_EQ(round.getCurrentPlayerIndex(), 0u);
+}
+
+TEST(BettingRoundTest, FullRaisesSetTheMinimumIncrement) {
+  BettingRound round(3, 0, seats({0, 1, 2}), 0, 10);
+  EXPECT_EQ(round.getLastRaiseSize(), 10);
+  round.playerActed(30, true); // seat 0 bets 30
+  EXPECT_EQ(round.getLastRaiseSize(), 30);
+  round.playerActed(100, true); // seat 1 raises by 70
+  EXPECT_EQ(round.getCurrentBet(), 100);
+  EXPECT_EQ(round.getLastRaiseSize(), 70);
+  EXPECT_TRUE(round.canRaise(0));
+  EXPECT_TRUE(round.canRaise(2));
+}
+
+TEST(BettingRoundTest, ShortAllInDoesNotReopenRaising) {
+  BettingRound round(3, 0, seats({0, 1, 2}), 0, 10);
+  round.playerActed(100, true); // seat 0 bets 100
+  round.playerActed(100, true); // seat 1 calls
+  round.playerActed(150, false); // seat 2 all-in, 50 short of a full raise
+  // Both must answer it, but may only call or fold.
+  EXPECT_EQ(round.getPendingSeats(), seats({0, 1}));
+  EXPECT_EQ(round.getLastRaiseSize(), 100);
+  EXPECT_FALSE(round.canRaise(0));
+  EXPECT_FALSE(round.canRaise(1));
+}
+
+TEST(BettingRoundTest, ShortAllInKeepsRaisingOpenForSeatsYetToAct) {
+  BettingRound round(4, 0, seats({0, 1, 2, 3}), 0, 10);
+  round.playerActed(100, true);  // seat 0 bets 100
+  round.playerActed(150, false); // seat 1 all-in short
+  EXPECT_FALSE(round.canRaise(0));
+  EXPECT_TRUE(round.canRaise(2));
+  round.playerActed(250, true); // seat 2 raises a full 100 on top
+  // A full raise reopens raising for everyone still able to act.
+  EXPECT_TRUE(round.canRaise(0));
+  EXPECT_TRUE(round.canRaise(3));
+  EXPECT_EQ(round.getLastRaiseSize(), 100);
+}
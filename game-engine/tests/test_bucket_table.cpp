@@ -0,0 +1,152 @@
+#include "core/Random.h"
+#include "utils/BucketTable.h"
+#include "utils/EquityCalculator.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::utils;
+using namespace poker::test;
+
+namespace {
+
+CardSet cards(const std::string &text) {
+  CardSet set;
+  for (size_t i = 0; i + 1 < text.size(); i += 2) {
+    unsigned rank = std::string("23456789TJQKA").find(text[i]) + 2;
+    unsigned suit = std::string("hdcs").find(text[i + 1]);
+    set.insert(Card(static_cast<Rank>(rank), static_cast<Suit>(suit)));
+  }
+  return set;
+}
+
+/// Preflop buckets index % 7, flop index % 300 (two bytes), turn and river
+/// lossless.
+BucketTable::Buckets syntheticBuckets() {
+  BucketTable::Buckets buckets;
+  for (uint64_t i = 0; i < 169; ++i)
+    buckets[0].push_back(static_cast<uint16_t>(i % 7));
+  const uint64_t flop = HandIndexer::forStreet(Street::Flop).size();
+  for (uint64_t i = 0; i < flop; ++i)
+    buckets[1].push_back(static_cast<uint16_t>(i % 300));
+  return buckets;
+}
+
+} // namespace
+
+TEST(BucketTableTest, RiverEquitiesMatchRangeEquity) {
+  const CardSet board = cards("Kh9s6d2c2h");
+  std::array<float, Range::kNumCombos> equity;
+  BucketTable::riverEquities(board, equity);
+
+  EquityCalculator calc(1);
+  RangeEquityQuery query;
+  query.hero = Range::full();
+  query.villain = Range::full();
+  query.board = board;
+  const auto expected = calc.rangeEquity(query);
+  for (size_t c = 0; c < Range::kNumCombos; ++c)
+    EXPECT_NEAR(equity[c], expected.comboEquity[c], 1e-6) << c;
+}
+
+TEST(BucketTableTest, RiverEquitiesWhenTheBoardPlays) {
+  std::array<float, Range::kNumCombos> equity;
+  BucketTable::riverEquities(cards("AsKsQsJsTs"), equity);
+  for (size_t c = 0; c < Range::kNumCombos; ++c) {
+    if (!Range::comboCards(c).intersects(cards("AsKsQsJsTs"))) {
+      EXPECT_FLOAT_EQ(equity[c], 0.5f);
+    }
+  }
+  BucketTable::riverEquities(cards("AsKsQsJs2h"), equity);
+  const size_t royal = Range::comboIndex(Card(Rank::Ten, Suit::Spades),
+                                         Card(Rank::Three, Suit::Clubs));
+  EXPECT_FLOAT_EQ(equity[royal], 1.0f);
+  EXPECT_THROW(BucketTable::riverEquities(cards("AsKsQsJs"), equity),
+               std::invalid_argument);
+}
+
+TEST(BucketTableTest, WriteOpenRoundTrip) {
+  const auto path = tempPath("poker_buckets_roundtrip.bin");
+  BucketTable::write(path, syntheticBuckets());
+  const BucketTable table = BucketTable::open(path);
+  EXPECT_EQ(table.numBuckets(Street::Preflop), 7u);
+  EXPECT_EQ(table.numBuckets(Street::Flop), 300u);
+  EXPECT_EQ(table.numBuckets(Street::Turn),
+            HandIndexer::forStreet(Street::Turn).size());
+
+  const auto lookup = table.bucketFn();
+  const HandIndexer &preflop = HandIndexer::forStreet(Street::Preflop);
+  const HandIndexer &flopIndexer = HandIndexer::forStreet(Street::Flop);
+  const HandIndexer &turnIndexer = HandIndexer::forStreet(Street::Turn);
+  PhiloxGenerator rng(5);
+  for (int trial = 0; trial < 2000; ++trial) {
+    std::vector<Card> deck(CardSet::fullDeck().begin(),
+                           CardSet::fullDeck().end());
+    rng.shuffle(deck);
+    const CardSet hole(std::span<const Card>(deck.data(), 2));
+    const CardSet flop(std::span<const Card>(deck.data() + 2, 3));
+    const CardSet turn = flop | CardSet::of(deck[5]);
+    EXPECT_EQ(table.bucket(Street::Preflop, hole, CardSet()),
+              preflop.index(hole, CardSet()) % 7);
+    EXPECT_EQ(table.bucket(Street::Flop, hole, flop),
+              flopIndexer.index(hole, flop) % 300);
+    EXPECT_EQ(table.bucket(Street::Turn, hole, turn),
+              turnIndexer.index(hole, turn));
+    EXPECT_EQ(lookup(Street::Flop, hole, flop),
+              table.bucket(Street::Flop, hole, flop));
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(BucketTableTest, RejectsBadTables) {
+  const auto path = tempPath("poker_buckets_bad.bin");
+  BucketTable::Buckets wrong;
+  wrong[1].assign(1000, 0);
+  EXPECT_THROW(BucketTable::write(path, wrong), std::invalid_argument);
+
+  EXPECT_THROW((void)BucketTable::open(path + ".missing"), std::runtime_error);
+  BucketTable::write(path, syntheticBuckets());
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  EXPECT_THROW((void)BucketTable::open(path), std::runtime_error);
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << std::string(512, 'x');
+  }
+  EXPECT_THROW((void)BucketTable::open(path), std::runtime_error);
+
+  // An aligned preflop offset whose section end wraps past 2^64.
+  BucketTable::write(path, syntheticBuckets());
+  {
+    const uint64_t offset = 0 - uint64_t{128};
+    std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(24); // sections[0].offset
+    out.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+  }
+  EXPECT_THROW((void)BucketTable::open(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(BucketTableTest, FeatureStagesCheckTheirInputs) {
+  ThreadPool pool(1);
+  const std::vector<uint16_t> tooSmall(10);
+  EXPECT_THROW(
+      (void)BucketTable::equityHistograms(Street::Flop, tooSmall, 8, pool),
+      std::invalid_argument);
+  EXPECT_THROW(
+      (void)BucketTable::equityHistograms(Street::River, tooSmall, 8, pool),
+      std::invalid_argument);
+  const std::vector<float> means(10);
+  EXPECT_THROW((void)BucketTable::preflopHistograms(means, 8, pool),
+               std::invalid_argument);
+  BucketBuildOptions options;
+  options.buckets[1] = 0;
+  EXPECT_THROW((void)BucketTable::build(options), std::invalid_argument);
+}
@@ -0,0 +1,87 @@
+#include "core/CardSet.h"
+#include <gtest/gtest.h>
+
+
+#include <vector>
+
+using namespace poker::core;
+
+TEST(CardSetTest, EmptyByDefault) {
+  CardSet s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.size(), 0u);
+}
+
+TEST(CardSetTest, InsertContainsErase) {
+  CardSet s;
+  Card as(Rank::Ace, Suit::Spades);
+  s.insert(as);
+  EXPECT_TRUE(s.contains(as));
+  EXPECT_FALSE(s.contains(Card(Rank::Ace, Suit::Hearts)));
+  EXPECT_EQ(s.size(), 1u);
+  s.erase(as);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(CardSetTest, IndexRoundTrip) {
+  for (unsigned i = 0; i < 52; ++i) {
+    Card c = CardSet::fromIndex(i);
+    EXPECT_EQ(CardSet::toIndex(c), i);
+    EXPECT_EQ(CardSet::fromBitIndex(CardSet::bitIndex(c)), c);
+  }
+  static_assert(CardSet::toIndex(Card(Rank::Two, Suit::Hearts)) == 0);
+  static_assert(CardSet::toIndex(Card(Rank::Ace, Suit::Spades)) == 51);
+}
+
+TEST(CardSetTest, FullDeckHas52Cards) {
+  EXPECT_EQ(CardSet::fullDeck().size(), 52u);
+  EXPECT_TRUE((~CardSet::fullDeck()).empty());
+}
+
+TEST(CardSetTest, SetAlgebra) {
+  std::vector<Card> a = {{Rank::Ace, Suit::Spades}, {Rank::King, Suit::Spades}};
+  std::vector<Card> b = {{Rank::King, Suit::Spades}, {Rank::Two, Suit::Clubs}};
+  CardSet sa(a), sb(b);
+
+  EXPECT_EQ((sa | sb).size(), 3u);
+  EXPECT_EQ((sa & sb).size(), 1u);
+  EXPECT_TRUE((sa & sb).contains(Card(Rank::King, Suit::Spades)));
+  EXPECT_EQ((sa - sb).size(), 1u);
+  EXPECT_TRUE(sa.intersects(sb));
+  EXPECT_EQ((~sa).size(), 50u);
+}
+
+TEST(CardSetTest, SuitMask) {
+  std::vector<Card> cards = {{Rank::Two, Suit::Clubs},
+                             {Rank::Ace, Suit::Clubs},
+                             {Rank::Ace, Suit::Hearts}};
+  CardSet s(cards);
+  EXPECT_EQ(s.suitMask(Suit::Clubs), 0x1001u);
+  EXPECT_EQ(s.suitMask(Suit::Hearts), 0x1000u);
+  EXPECT_EQ(s.suitMask(Suit::Spades), 0u);
+}
+
+TEST(CardSetTest, IterationVisitsEachCard) {
+  std::vector<Card> cards = {{Rank::Ten, Suit::Diamonds},
+                             {Rank::Three, Suit::Hearts},
+                             {Rank::Queen, Suit::Spades}};
+  CardSet s(cards);
+  size_t count = 0;
+  for (Card c : s) {
+    EXPECT_TRUE(s.contains(c));
+    ++count;
+  }
+  EXPECT_EQ(count, 3u);
+  EXPECT_EQ(s.toString(), "3h Td Qs");
+}
+
+TEST(CardSetTest, PermuteSuitsRelabelsLanes) {
+  CardSet s;
+  s.insert(Card(Rank::Ace, Suit::Hearts));
+  s.insert(Card(Rank::Two, Suit::Spades));
+  CardSet p = s.permuteSuits({3, 1, 2, 0}); // swap hearts and spades
+  EXPECT_TRUE(p.contains(Card(Rank::Ace, Suit::Spades)));
+  EXPECT_TRUE(p.contains(Card(Rank::Two, Suit::Hearts)));
+  EXPECT_EQ(p.size(), 2u);
+  EXPECT_EQ(s.permuteSuits({0, 1, 2, 3}), s);
+}
@@ -0,0 +1,162 @@
+#include "core/CompactGameState.h"
+#include "engine/PokerEngine.h"
+#include "interfaces/IActionProvider.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+using namespace poker::test;
+
+namespace {
+
+/// Checks that `state` survives a round trip through CompactGameState.
+void expectRoundTrip(const GameState &state) {
+  std::vector<std::string> names;
+  for (const auto &p : state.getPlayers())
+    names.push_back(p.getName());
+
+  const auto compact = CompactGameState::fromGameState(state);
+  CompactGameState copy;
+  std::memcpy(&copy, &compact, sizeof(copy));
+  const GameState restored = copy.toGameState(names);
+
+  EXPECT_EQ(restored.serialize(), state.serialize());
+  EXPECT_EQ(restored.getPot().getTotal(), state.getPot().getTotal());
+  EXPECT_EQ(copy.getPotTotal(), state.getPot().getTotal());
+  EXPECT_EQ(restored.getCommunityCardSet(), state.getCommunityCardSet());
+  EXPECT_EQ(restored.getCurrentPlayerIndex(), state.getCurrentPlayerIndex());
+  for (size_t i = 0; i < state.getPlayers().size(); ++i) {
+    const auto &a = state.getPlayer(i);
+    const auto &b = restored.getPlayer(i);
+    EXPECT_EQ(b.getCurrentBet(), a.getCurrentBet());
+    EXPECT_EQ(b.getHoleCardSet(), a.getHoleCardSet());
+    EXPECT_EQ(copy.getHoleCardSet(i), a.getHoleCardSet());
+    EXPECT_EQ(b.isAllIn(), a.isAllIn());
+    EXPECT_EQ(restored.getPot().getPlayerContribution(i),
+              state.getPot().getPlayerContribution(i));
+  }
+}
+
+/// Calls, with an occasional raise, and checks at every decision that the
+/// state survives a round trip through CompactGameState.
+class RoundTripProvider : public poker::interfaces::IActionProvider {
+public:
+  Action getAction(size_t, const GameState &state,
+                   const std::vector<Action> &legal) override {
+    expectRoundTrip(state);
+    ++checks;
+
+    // At most one raise per hand keeps the hands short and varied.
+    bool raised = false;
+    for (const auto &a : state.getActionHistory())
+      raised |= a.type == ActionType::Raise;
+    for (const auto &a : legal) {
+      if (a.type == ActionType::Raise && !raised && checks % 3 == 0)
+        return a;
+    }
+    for (const auto &a : legal) {
+      if (a.type == ActionType::Check || a.type == ActionType::Call)
+        return a;
+    }
+    return legal.front();
+  }
+
+  size_t checks = 0;
+};
+
+/// Bets or raises whenever it could check and calls otherwise: ten-handed,
+/// everyone limps, the big blind raises, everyone calls, and every later
+/// street is bet and called, for 51 actions a hand. Checks the round trip
+/// at every decision.
+class BetWhenCheckedToProvider : public poker::interfaces::IActionProvider {
+public:
+  Action getAction(size_t, const GameState &state,
+                   const std::vector<Action> &legal) override {
+    expectRoundTrip(state);
+    longest = std::max(longest, state.getActionHistory().size());
+
+    const bool canCheck =
+        std::any_of(legal.begin(), legal.end(), [](const Action &a) {
+          return a.type == ActionType::Check;
+        });
+    for (const auto &a : legal) {
+      if (canCheck ? a.type == ActionType::Bet || a.type == ActionType::Raise
+                   : a.type == ActionType::Call)
+        return a;
+    }
+    return legal.front();
+  }
+
+  size_t longest = 0;
+};
+
+} // namespace
+
+TEST(CompactGameStateTest, RoundTripsLiveHands) {
+  auto provider = std::make_shared<RoundTripProvider>();
+  PokerEngine engine(provider, std::make_shared<Mt19937Generator>(7));
+  GameState state = makeTable(6, 2000);
+  state.setSmallBlind(10);
+  state.setBigBlind(20);
+  for (size_t hand = 0; hand < 20; ++hand) {
+    state.setDealerPosition(hand % 6);
+    engine.playHand(state);
+  }
+  EXPECT_GT(provider->checks, 100u);
+}
+
+TEST(CompactGameStateTest, RoundTripsLongTenHandedHands) {
+  auto provider = std::make_shared<BetWhenCheckedToProvider>();
+  PokerEngine engine(provider, std::make_shared<Mt19937Generator>(11));
+  for (size_t hand = 0; hand < 10; ++hand) {
+    GameState state = makeTable(10, 5000, hand);
+    engine.playHand(state);
+    EXPECT_EQ(state.getActionHistory().size(), 51u);
+    expectRoundTrip(state);
+  }
+  EXPECT_EQ(provider->longest, 50u);
+}
+
+TEST(CompactGameStateTest, UnnamedSeatsGetDefaultNames) {
+  GameState state;
+  std::vector<Player> players;
+  players.emplace_back(0, "Alice", 100);
+  players.emplace_back(1, "Bob", 100);
+  state.setPlayers(std::move(players));
+  auto restored = CompactGameState::fromGameState(state).toGameState();
+  EXPECT_EQ(restored.getPlayer(0).getName(), "Seat 0");
+  EXPECT_EQ(restored.getPlayer(1).getChips(), 100);
+  EXPECT_TRUE(restored.getCommunityCards().empty());
+}
+
+TEST(CompactGameStateTest, RejectsStatesThatDoNotFit) {
+  GameState tooMany;
+  std::vector<Player> players;
+  for (size_t i = 0; i < 11; ++i)
+    players.emplace_back(i, "P", 100);
+  tooMany.setPlayers(players);
+  EXPECT_THROW((void)CompactGameState::fromGameState(tooMany),
+               std::length_error);
+
+  players.erase(players.begin() + 2, players.end());
+  GameState longHistory;
+  longHistory.setPlayers(players);
+  for (size_t i = 0; i <= CompactGameState::kActionCapacity; ++i)
+    longHistory.recordAction(Action(ActionType::Check, 0, i % 2));
+  EXPECT_THROW((void)CompactGameState::fromGameState(longHistory),
+               std::length_error);
+
+  GameState rich;
+  players.pop_back();
+  players.emplace_back(1, "Rich", int64_t{1} << 40);
+  rich.setPlayers(players);
+  EXPECT_THROW((void)CompactGameState::fromGameState(rich), std::out_of_range);
+}
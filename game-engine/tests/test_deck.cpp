@@ -1,8 +1,12 @@
 #include "core/Deck.h"
+#include "core/LazyDeck.h"
+#include "core/Random.h"
 #include "interfaces/IRandomGenerator.h"
 #include <gtest/gtest.h>
 
 
+#include <array>
+#include <random>
 #include <string>
 #include <unordered_set>
 
@@ -62,6 +66,22 @@ TEST(DeckTest, ResetRestoresDeck) {
   EXPECT_EQ(deck.remaining(), 52u);
 }
 
+TEST(DeckTest, ResetExcludesDeadCards) {
+  Deck deck;
+  CardSet dead;
+  dead.insert(Card(Rank::Ace, Suit::Spades));
+  dead.insert(Card(Rank::Two, Suit::Hearts));
+  deck.reset(dead);
+  EXPECT_EQ(deck.remaining(), 50u);
+  EXPECT_FALSE(deck.remainingCards().intersects(dead));
+
+  while (auto card = deck.deal()) {
+    EXPECT_FALSE(dead.contains(*card));
+    EXPECT_FALSE(deck.remainingCards().contains(*card));
+  }
+  EXPECT_TRUE(deck.remainingCards().empty());
+}
+
 TEST(DeckTest, DeterministicShuffle) {
   Deck deck1, deck2;
   Mt19937Generator rng1(42), rng2(42);
@@ -90,3 +110,85 @@ TEST(DeckTest, NoShuffleRNG) {
   EXPECT_EQ(first->rank, Rank::Two);
   EXPECT_EQ(first->suit, Suit::Hearts);
 }
+
+TEST(DeckTest, XoshiroShuffleIsDeterministicPermutation) {
+  Deck deck1, deck2;
+  Xoshiro256Generator rng1(9), rng2(9);
+  deck1.shuffle(rng1);
+  deck2.shuffle(rng2);
+
+  CardSet seen;
+  bool moved = false;
+  for (unsigned i = 0; i < 52; ++i) {
+    auto c1 = deck1.deal();
+    auto c2 = deck2.deal();
+    ASSERT_TRUE(c1.has_value());
+    EXPECT_EQ(*c1, *c2);
+    EXPECT_FALSE(seen.contains(*c1));
+    seen.insert(*c1);
+    moved |= !(*c1 == CardSet::fromIndex(i));
+  }
+  EXPECT_TRUE(moved);
+}
+
+TEST(LazyDeckTest, DrawsEveryCardOnce) {
+  LazyDeck deck;
+  Xoshiro256Generator rng(1);
+  CardSet seen;
+  for (int i = 0; i < 52; ++i) {
+    EXPECT_EQ(deck.remainingCards().size(), 52u - i);
+    auto card = deck.draw(rng);
+    ASSERT_TRUE(card.has_value());
+    EXPECT_FALSE(seen.contains(*card));
+    seen.insert(*card);
+  }
+  EXPECT_FALSE(deck.draw(rng).has_value());
+  EXPECT_EQ(seen, CardSet::fullDeck());
+}
+
+TEST(LazyDeckTest, RestoreReplaysTheSameCardsFromTheSameStream) {
+  LazyDeck deck;
+  Xoshiro256Generator rng(5);
+  std::vector<Card> first;
+  for (int i = 0; i < 20; ++i)
+    first.push_back(*deck.draw(rng));
+  deck.restore();
+  EXPECT_EQ(deck.remaining(), 52u);
+  EXPECT_EQ(deck.dealt(), 0u);
+
+  // Restored order is the starting order, so the same stream deals the
+  // same cards.
+  Xoshiro256Generator replay(5);
+  for (int i = 0; i < 20; ++i)
+    EXPECT_EQ(*deck.draw(replay), first[i]);
+}
+
+TEST(LazyDeckTest, ResetExcludesDeadCards) {
+  const CardSet dead(std::vector<Card>{Card(Rank::Ace, Suit::Spades),
+                                       Card(Rank::King, Suit::Hearts)});
+  LazyDeck deck;
+  deck.reset(dead);
+  EXPECT_EQ(deck.remaining(), 50u);
+  std::mt19937_64 rng(3); // Any 64-bit bit generator works.
+  while (auto card = deck.draw(rng)) {
+    EXPECT_FALSE(dead.contains(*card));
+  }
+  deck.restore();
+  EXPECT_EQ(deck.remainingCards(), ~dead);
+}
+
+TEST(LazyDeckTest, FirstCardIsUniform) {
+  LazyDeck deck;
+  Xoshiro256Generator rng(11);
+  constexpr int kTrials = 52000;
+  std::array<int, 52> counts{};
+  for (int t = 0; t < kTrials; ++t) {
+    ++counts[CardSet::toIndex(*deck.draw(rng))];
+    (void)deck.draw(rng);
+    deck.restore();
+  }
+  // Expected 1000 each; a 5-sigma band is about +-160.
+  for (int c : counts) {
+    EXPECT_NEAR(c, 1000, 160);
+  }
+}
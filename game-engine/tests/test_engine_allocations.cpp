@@ -0,0 +1,89 @@
+#include "core/Deck.h"
+#include "engine/PokerEngine.h"
+#include "interfaces/IActionProvider.h"
+#include <gtest/gtest.h>
+
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace poker::core;
+using namespace poker::engine;
+
+// Counting global allocator: only allocations made by the test thread while
+// counting is switched on are recorded. The replacement applies to the whole
+// poker_tests binary, not just this file.
+namespace {
+
+std::atomic<size_t> gAllocations{0};
+thread_local bool tCounting = false;
+
+/// Cycles through fold / raise / call / all-in choices without allocating.
+class CyclingProvider : public poker::interfaces::IActionProvider {
+public:
+  Action getAction(size_t, const GameState &,
+                   const std::vector<Action> &legal) override {
+    static constexpr ActionType kPreference[][2] = {
+        {ActionType::Check, ActionType::Call},
+        {ActionType::Raise, ActionType::Bet},
+        {ActionType::Call, ActionType::Check},
+        {ActionType::Fold, ActionType::Fold},
+        {ActionType::Call, ActionType::Check},
+        {ActionType::Bet, ActionType::Raise},
+        {ActionType::Check, ActionType::Call},
+        {ActionType::AllIn, ActionType::AllIn},
+    };
+    const auto &pref = kPreference[turn_++ % 8];
+    for (ActionType t : pref) {
+      for (const auto &a : legal)
+        if (a.type == t)
+          return a;
+    }
+    return legal.front();
+  }
+
+private:
+  size_t turn_ = 0;
+};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  if (tCounting)
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+TEST(EngineAllocationTest, SteadyStateHandDoesNotAllocate) {
+  PokerEngine engine(std::make_shared<CyclingProvider>(),
+                     std::make_shared<Mt19937Generator>(7));
+  GameState fresh;
+  std::vector<Player> players;
+  for (size_t i = 0; i < 6; ++i)
+    players.emplace_back(i, "Player" + std::to_string(i), 1000);
+  fresh.setPlayers(std::move(players));
+  fresh.setSmallBlind(5);
+  fresh.setBigBlind(10);
+
+  GameState state = fresh;
+  auto play = [&](size_t hand) {
+    state = fresh;
+    state.setDealerPosition(hand % 6);
+    engine.playHand(state);
+  };
+  for (size_t h = 0; h < 200; ++h)
+    play(h);
+
+  gAllocations = 0;
+  tCounting = true;
+  for (size_t h = 0; h < 500; ++h)
+    play(h);
+  tCounting = false;
+
+  EXPECT_EQ(gAllocations.load(), 0u);
+}
@@ -0,0 +1,280 @@
+#include "utils/EquityCalculator.h"
+#include "utils/HandEvaluator.h"
+#include <gtest/gtest.h>
+
+
+#include <string>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::utils;
+
+namespace {
+
+/// Parse a compact card list such as "AsKd" or "Th 9h 2c".
+CardSet cards(const std::string &text) {
+  CardSet set;
+  for (size_t i = 0; i + 1 < text.size();) {
+    if (text[i] == ' ') {
+      ++i;
+      continue;
+    }
+    unsigned rank = std::string("23456789TJQKA").find(text[i]) + 2;
+    unsigned suit = std::string("hdcs").find(text[i + 1]);
+    set.insert(Card(static_cast<Rank>(rank), static_cast<Suit>(suit)));
+    i += 2;
+  }
+  return set;
+}
+
+} // namespace
+
+class EquityCalculatorTest : public ::testing::Test {
+protected:
+  EquityCalculator calc{2};
+  EquityOptions options;
+
+  void SetUp() override {
+    options.maxSamples = 200000;
+    options.seed = 42;
+  }
+};
+
+TEST_F(EquityCalculatorTest, PairOverPairPreflop) {
+  // AA vs KK all-in preflop: roughly 82% / 18%.
+  EquityQuery q;
+  q.holeCards = {cards("AsAh"), cards("KsKh")};
+  auto r = calc.calculate(q, options);
+
+  ASSERT_EQ(r.players.size(), 2u);
+  EXPECT_EQ(r.samples, options.maxSamples);
+  EXPECT_NEAR(r.players[0].equity, 0.82, 0.01);
+  EXPECT_NEAR(r.players[0].equity + r.players[1].equity, 1.0, 1e-9);
+  EXPECT_GT(r.players[0].margin, 0.0);
+}
+
+TEST_F(EquityCalculatorTest, CompleteBoardIsDeterministic) {
+  EquityQuery q;
+  q.holeCards = {cards("AsAh"), cards("KsKh")};
+  q.board = cards("Kd 7c 2h 3s 9d");
+  auto r = calc.calculate(q, options);
+
+  EXPECT_DOUBLE_EQ(r.players[0].equity, 0.0);
+  EXPECT_DOUBLE_EQ(r.players[1].win, 1.0);
+  EXPECT_DOUBLE_EQ(r.players[1].stdError, 0.0);
+}
+
+TEST_F(EquityCalculatorTest, SplitPotCountsAsTie) {
+  // Board plays for both players.
+  EquityQuery q;
+  q.holeCards = {cards("2h3d"), cards("2c3s")};
+  q.board = cards("As Ks Qs Js Ts");
+  auto r = calc.calculate(q, options);
+
+  EXPECT_DOUBLE_EQ(r.players[0].tie, 1.0);
+  EXPECT_DOUBLE_EQ(r.players[0].equity, 0.5);
+}
+
+TEST_F(EquityCalculatorTest, UnknownOpponent) {
+  // AA vs a random hand: roughly 85%.
+  EquityQuery q;
+  q.holeCards = {cards("AsAh"), CardSet()};
+  auto r = calc.calculate(q, options);
+  EXPECT_NEAR(r.players[0].equity, 0.852, 0.01);
+}
+
+TEST_F(EquityCalculatorTest, TargetStdErrorStopsEarly) {
+  EquityQuery q;
+  q.holeCards = {cards("AsKs"), cards("QdQc")};
+  options.maxSamples = 0;
+  options.targetStdError = 0.005;
+  auto r = calc.calculate(q, options);
+
+  EXPECT_LE(r.players[0].stdError, 0.005);
+  EXPECT_LT(r.samples, 200000u);
+}
+
+TEST_F(EquityCalculatorTest, RejectsOverlappingCards) {
+  EquityQuery q;
+  q.holeCards = {cards("AsAh"), cards("AsKh")};
+  EXPECT_THROW((void)calc.calculate(q, options), std::invalid_argument);
+
+  q.holeCards = {cards("AsAh"), cards("KsKh")};
+  q.dead = cards("Ah");
+  EXPECT_THROW((void)calc.calculate(q, options), std::invalid_argument);
+}
+
+TEST_F(EquityCalculatorTest, RequiresStoppingRule) {
+  EquityQuery q;
+  q.holeCards = {cards("AsAh"), cards("KsKh")};
+  options.maxSamples = 0;
+  EXPECT_THROW((void)calc.calculate(q, options), std::invalid_argument);
+}
+
+namespace {
+
+/// Straightforward enumeration over every unordered pair of remaining cards.
+double bruteForceFlopEquity(CardSet hero, CardSet villain, CardSet board) {
+  CardSet rest = ~(hero | villain | board);
+  std::vector<Card> deck(rest.begin(), rest.end());
+  double share = 0.0;
+  size_t runouts = 0;
+  for (size_t i = 0; i < deck.size(); ++i) {
+    for (size_t j = i + 1; j < deck.size(); ++j) {
+      CardSet full = board | CardSet::of(deck[i]) | CardSet::of(deck[j]);
+      auto a = HandEvaluator::evaluateStrength(hero | full);
+      auto b = HandEvaluator::evaluateStrength(villain | full);
+      share += a > b ? 1.0 : (a == b ? 0.5 : 0.0);
+      ++runouts;
+    }
+  }
+  return share / static_cast<double>(runouts);
+}
+
+} // namespace
+
+TEST_F(EquityCalculatorTest, EnumerateMatchesBruteForce) {
+  EquityQuery q;
+  q.holeCards = {cards("AsKd"), cards("QhQc")};
+  q.board = cards("Ks 7c 2h");
+  auto r = calc.enumerate(q);
+
+  EXPECT_TRUE(r.exact);
+  EXPECT_EQ(r.samples, 990u); // C(45, 2)
+  EXPECT_NEAR(r.players[0].equity,
+              bruteForceFlopEquity(q.holeCards[0], q.holeCards[1], q.board),
+              1e-12);
+  EXPECT_NEAR(r.players[0].equity + r.players[1].equity, 1.0, 1e-12);
+  EXPECT_DOUBLE_EQ(r.players[0].stdError, 0.0);
+}
+
+TEST_F(EquityCalculatorTest, EnumerateCollapsesIsomorphicRunouts) {
+  // Everything known is a heart, so diamonds, clubs and spades are
+  // interchangeable and most runouts share a class with others.
+  EquityQuery q;
+  q.holeCards = {cards("AhKh"), cards("QhJh")};
+  q.board = cards("2h 3h 9h");
+  auto r = calc.enumerate(q);
+
+  EXPECT_EQ(r.samples, 990u);
+  EXPECT_LT(r.evaluated * 3, r.samples);
+  EXPECT_NEAR(r.players[0].equity,
+              bruteForceFlopEquity(q.holeCards[0], q.holeCards[1], q.board),
+              1e-12);
+}
+
+TEST_F(EquityCalculatorTest, EnumerateIsBitIdenticalAcrossThreadCounts) {
+  EquityQuery q;
+  q.holeCards = {cards("AsKs"), cards("QdQc"), cards("7h6h")};
+  q.board = cards("Kd 7c 2s");
+  EquityCalculator single(1);
+  auto a = calc.enumerate(q);
+  auto b = calc.enumerate(q);
+  auto c = single.enumerate(q);
+
+  for (size_t p = 0; p < 3; ++p) {
+    EXPECT_EQ(a.players[p].equity, b.players[p].equity);
+    EXPECT_EQ(a.players[p].equity, c.players[p].equity);
+    EXPECT_EQ(a.players[p].tie, c.players[p].tie);
+  }
+}
+
+TEST_F(EquityCalculatorTest, EnumerateRequiresKnownHoleCards) {
+  EquityQuery q;
+  q.holeCards = {cards("AsAh"), cards("Kd")};
+  EXPECT_THROW((void)calc.enumerate(q), std::invalid_argument);
+}
+
+namespace {
+
+/// Pairwise reference: every hero combo against every villain combo on
+/// every river, skipping overlapping cards.
+double bruteForceRangeEquity(const Range &hero, const Range &villain,
+                             CardSet board) {
+  CardSet rest = ~board;
+  std::vector<Card> deck(rest.begin(), rest.end());
+  double share = 0.0, weight = 0.0;
+  for (size_t h = 0; h < Range::kNumCombos; ++h) {
+    CardSet hc = Range::comboCards(h);
+    if (hero.weight(h) == 0.0 || hc.intersects(board))
+      continue;
+    for (size_t v = 0; v < Range::kNumCombos; ++v) {
+      CardSet vc = Range::comboCards(v);
+      if (villain.weight(v) == 0.0 || vc.intersects(board | hc))
+        continue;
+      double w = hero.weight(h) * villain.weight(v);
+      for (Card river : deck) {
+        CardSet full = board | CardSet::of(river);
+        if (full.intersects(hc | vc) || full == board)
+          continue;
+        auto a = HandEvaluator::evaluateStrength(hc | full);
+        auto b = HandEvaluator::evaluateStrength(vc | full);
+        share += w * (a > b ? 1.0 : (a == b ? 0.5 : 0.0));
+        weight += w;
+      }
+    }
+  }
+  return share / weight;
+}
+
+} // namespace
+
+TEST_F(EquityCalculatorTest, RangeEquityMatchesPairwiseReference) {
+  RangeEquityQuery q;
+  q.hero = Range::parse("QQ+,AK,T9s:0.5");
+  q.villain = Range::parse("TT+,AQs+,KQ,98s-65s:0.25");
+  q.board = cards("Kh 9s 6d 2c");
+  auto r = calc.rangeEquity(q);
+
+  EXPECT_TRUE(r.exact);
+  EXPECT_EQ(r.boards, 48u); // 52 - 4 rivers
+  EXPECT_NEAR(r.equity, bruteForceRangeEquity(q.hero, q.villain, q.board),
+              1e-9);
+}
+
+TEST_F(EquityCalculatorTest, RangeEquityWithSingleCombosMatchesEnumerate) {
+  EquityQuery eq;
+  eq.holeCards = {cards("AsKd"), cards("QhQc")};
+  eq.board = cards("Ks 7c 2h");
+  auto exact = calc.enumerate(eq);
+
+  RangeEquityQuery q;
+  q.hero = Range::parse("AsKd");
+  q.villain = Range::parse("QhQc");
+  q.board = eq.board;
+  auto r = calc.rangeEquity(q);
+
+  EXPECT_NEAR(r.equity, exact.players[0].equity, 1e-12);
+  EXPECT_NEAR(r.comboEquity[Range::comboIndex(Card(Rank::Ace, Suit::Spades),
+                                              Card(Rank::King, Suit::Diamonds))],
+              r.equity, 1e-12);
+}
+
+TEST_F(EquityCalculatorTest, RangeEquityAppliesCardRemoval) {
+  // Villain holds KK or AA; hero's As blocks half of villain's aces, and a
+  // King on the river board removes three of the six KK combos.
+  RangeEquityQuery q;
+  q.hero = Range::parse("AsAh");
+  q.villain = Range::parse("AA,KK");
+  q.board = cards("Kd 7c 2h 3s 9d");
+  auto r = calc.rangeEquity(q);
+
+  // Only AdAc (tie) and the three KK combos without Kd (sets, hero loses).
+  EXPECT_NEAR(r.tie, 0.25, 1e-12);
+  EXPECT_NEAR(r.win, 0.0, 1e-12);
+  EXPECT_NEAR(r.equity, 0.125, 1e-12);
+}
+
+TEST_F(EquityCalculatorTest, RangeEquitySamplesBoardsWhenAsked) {
+  RangeEquityQuery q;
+  q.hero = Range::parse("AA");
+  q.villain = Range::parse("KK");
+  RangeEquityOptions ro;
+  ro.maxBoards = 20000;
+  ro.seed = 3;
+  auto r = calc.rangeEquity(q, ro);
+
+  EXPECT_FALSE(r.exact);
+  EXPECT_EQ(r.boards, 20000u);
+  EXPECT_NEAR(r.equity, 0.82, 0.01);
+}
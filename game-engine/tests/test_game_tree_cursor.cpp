@@ -0,0 +1,164 @@
+#include "engine/GameTreeCursor.h"
+#include "engine/PokerEngine.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <array>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+using namespace poker::test;
+
+namespace {
+
+/// Heads-up hand with hole cards dealt and blinds posted.
+GameState headsUpRoot(int64_t stack) {
+  GameState state = makeTable(2, stack);
+  state.resetForNewHand();
+  Deck deck;
+  for (auto &p : state.getMutablePlayers()) {
+    p.dealCard(*deck.deal());
+    p.dealCard(*deck.deal());
+  }
+  const size_t sb = state.getSmallBlindPosition();
+  const size_t bb = state.getBigBlindPosition();
+  state.getMutablePot().addContribution(
+      sb, state.getMutablePlayer(sb).placeBet(5));
+  state.recordAction(Action(ActionType::Bet, 5, sb));
+  state.getMutablePot().addContribution(
+      bb, state.getMutablePlayer(bb).placeBet(10));
+  state.recordAction(Action(ActionType::Bet, 10, bb));
+  return state;
+}
+
+/// Walk every line of betting over a fixed runout, checking that undo
+/// restores each node exactly and chips are conserved at every leaf.
+size_t walk(GameTreeCursor &cursor, const std::vector<Card> &runout) {
+  const std::string before = fingerprint(cursor.getState());
+  size_t leaves = 0;
+  switch (cursor.getNodeType()) {
+  case GameTreeCursor::NodeType::Terminal: {
+    std::array<int64_t, 2> payoffs{};
+    cursor.getPayoffs(payoffs);
+    EXPECT_EQ(payoffs[0] + payoffs[1], 0);
+    return 1;
+  }
+  case GameTreeCursor::NodeType::Chance: {
+    const size_t dealt = cursor.getState().getCommunityCards().size();
+    cursor.dealBoard(std::span(runout).subspan(dealt, cursor.cardsNeeded()));
+    leaves += walk(cursor, runout);
+    cursor.undo();
+    break;
+  }
+  case GameTreeCursor::NodeType::Decision: {
+    const ActionList legal = cursor.getLegalActions();
+    for (const auto &a : legal) {
+      cursor.apply(a);
+      leaves += walk(cursor, runout);
+      cursor.undo();
+      EXPECT_EQ(fingerprint(cursor.getState()), before);
+    }
+    break;
+  }
+  }
+  EXPECT_EQ(fingerprint(cursor.getState()), before);
+  return leaves;
+}
+
+} // namespace
+
+TEST(GameTreeCursorTest, FullTreeWalkRestoresTheRoot) {
+  GameState state = headsUpRoot(40);
+  const std::string root = fingerprint(state);
+  const std::vector<Card> runout = {
+      Card(Rank::Ace, Suit::Spades), Card(Rank::King, Suit::Spades),
+      Card(Rank::Two, Suit::Diamonds), Card(Rank::Nine, Suit::Clubs),
+      Card(Rank::Nine, Suit::Spades)};
+
+  GameTreeCursor cursor(state);
+  EXPECT_EQ(cursor.getNodeType(), GameTreeCursor::NodeType::Decision);
+  const size_t leaves = walk(cursor, runout);
+  EXPECT_GT(leaves, 100u);
+  EXPECT_EQ(cursor.getDepth(), 0u);
+  EXPECT_EQ(fingerprint(state), root);
+}
+
+TEST(GameTreeCursorTest, MatchesPokerEngine) {
+  // Three uneven stacks so all-ins and side pots come up.
+  for (uint64_t seed = 1; seed <= 40; ++seed) {
+    GameState state = makeTable({300, 150, 600}, seed % 3);
+
+    std::optional<GameState> root;
+    PokerEngine engine(std::make_shared<HistoryProvider>(),
+                       std::make_shared<Mt19937Generator>(seed));
+    engine.setEventCallback([&](const HandEvent &e, const GameState &s) {
+      if (std::holds_alternative<HoleCardsDealt>(e))
+        root = s;
+    });
+    engine.playHand(state);
+    ASSERT_TRUE(root.has_value());
+
+    const std::vector<Card> &board = state.getCommunityCards();
+    GameState replay = *root;
+    GameTreeCursor cursor(replay);
+    const std::string start = fingerprint(replay);
+    while (!cursor.isTerminal()) {
+      if (cursor.getNodeType() == GameTreeCursor::NodeType::Chance) {
+        const size_t dealt = replay.getCommunityCards().size();
+        cursor.dealBoard(std::span(board).subspan(dealt, cursor.cardsNeeded()));
+      } else {
+        cursor.apply(chooseByHistory(replay, cursor.getLegalActions()));
+      }
+    }
+
+    std::array<int64_t, 3> payoffs{};
+    cursor.getPayoffs(payoffs);
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(root->getPlayer(i).getChips() +
+                    root->getPot().getPlayerContribution(i) + payoffs[i],
+                state.getPlayer(i).getChips())
+          << "seed " << seed << " seat " << i;
+    }
+    EXPECT_EQ(replay.getActionHistory().size(),
+              state.getActionHistory().size());
+    EXPECT_EQ(replay.getStreet(), Street::Showdown);
+
+    while (cursor.getDepth() > 0)
+      cursor.undo();
+    EXPECT_EQ(fingerprint(replay), start);
+  }
+}
+
+TEST(GameTreeCursorTest, RejectsMovesThatDoNotFitTheNode) {
+  GameState state = headsUpRoot(100);
+  GameTreeCursor cursor(state);
+  EXPECT_THROW(cursor.undo(), std::logic_error);
+  const Card flop[] = {Card(Rank::Ace, Suit::Spades),
+                       Card(Rank::King, Suit::Spades),
+                       Card(Rank::Two, Suit::Diamonds)};
+  EXPECT_THROW(cursor.dealBoard(flop), std::logic_error);
+  EXPECT_THROW(cursor.apply(Action(ActionType::Check, 0, 0)),
+               std::invalid_argument); // Small blind faces a bet.
+  std::array<int64_t, 2> payoffs{};
+  EXPECT_THROW(cursor.getPayoffs(payoffs), std::logic_error);
+
+  cursor.apply(Action(ActionType::Call, 5, 0));
+  cursor.apply(Action(ActionType::Check, 0, 1));
+  ASSERT_EQ(cursor.getNodeType(), GameTreeCursor::NodeType::Chance);
+  EXPECT_EQ(cursor.cardsNeeded(), 3u);
+  EXPECT_THROW(cursor.dealBoard(std::span(flop).first(2)),
+               std::invalid_argument);
+  const Card dealtAlready[] = {state.getPlayer(0).getHoleCards()[0],
+                               Card(Rank::King, Suit::Spades),
+                               Card(Rank::Two, Suit::Diamonds)};
+  EXPECT_THROW(cursor.dealBoard(dealtAlready), std::invalid_argument);
+  cursor.dealBoard(flop);
+  EXPECT_EQ(state.getStreet(), Street::Flop);
+  EXPECT_EQ(state.getCommunityCards().size(), 3u);
+}
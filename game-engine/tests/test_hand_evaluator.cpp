@@ -1,6 +1,9 @@
 #include "utils/HandEvaluator.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 
 using namespace poker::core;
 using namespace poker::utils;
@@ -159,3 +162,137 @@ TEST(HandEvaluatorTest, TieBreaking) {
 
   EXPECT_GT(HandEvaluator::compare(hand1, hand2), 0);
 }
+
+namespace {
+
+std::vector<Card> fullDeck() {
+  std::vector<Card> deck;
+  for (uint8_t s = 0; s < 4; ++s) {
+    for (uint8_t r = 2; r <= 14; ++r) {
+      deck.emplace_back(static_cast<Rank>(r), static_cast<Suit>(s));
+    }
+  }
+  return deck;
+}
+
+} // namespace
+
+TEST(HandEvaluatorTest, TableMatchesReferenceAllFiveCardHands) {
+  // Exhaustive over C(52,5); also checks there are exactly 7462 classes.
+  auto deck = fullDeck();
+  std::vector<bool> seen(1 << 16, false);
+  size_t classes = 0, mismatches = 0;
+  std::array<Card, 5> hand;
+  for (size_t a = 0; a < 52; ++a)
+    for (size_t b = a + 1; b < 52; ++b)
+      for (size_t c = b + 1; c < 52; ++c)
+        for (size_t d = c + 1; d < 52; ++d)
+          for (size_t e = d + 1; e < 52; ++e) {
+            hand = {deck[a], deck[b], deck[c], deck[d], deck[e]};
+            auto strength = HandEvaluator::evaluateStrength(hand);
+            if (HandEvaluator::toResult(strength) !=
+                HandEvaluator::evaluateReference(hand)) {
+              ++mismatches;
+            }
+            if (!seen[strength]) {
+              seen[strength] = true;
+              ++classes;
+            }
+          }
+  EXPECT_EQ(mismatches, 0u);
+  EXPECT_EQ(classes, 7462u);
+}
+
+TEST(HandEvaluatorTest, TableMatchesReferenceRandomSevenCardHands) {
+  auto deck = fullDeck();
+  std::mt19937_64 rng(7);
+  for (int i = 0; i < 200000; ++i) {
+    std::shuffle(deck.begin(), deck.end(), rng);
+    std::span<const Card> hand(deck.data(), 5 + i % 3);
+    ASSERT_EQ(HandEvaluator::evaluate(hand),
+              HandEvaluator::evaluateReference(hand))
+        << "Hand " << i;
+  }
+}
+
+TEST(HandEvaluatorTest, StrengthOrderMatchesResultOrder) {
+  auto deck = fullDeck();
+  std::mt19937_64 rng(11);
+  for (int i = 0; i < 20000; ++i) {
+    std::shuffle(deck.begin(), deck.end(), rng);
+    std::span<const Card> h1(deck.data(), 7);
+    std::span<const Card> h2(deck.data() + 7, 7);
+    auto s1 = HandEvaluator::evaluateStrength(h1);
+    auto s2 = HandEvaluator::evaluateStrength(h2);
+    auto r1 = HandEvaluator::evaluateReference(h1);
+    auto r2 = HandEvaluator::evaluateReference(h2);
+    ASSERT_EQ(s1 < s2, r1 < r2);
+    ASSERT_EQ(s1 == s2, r1 == r2);
+    EXPECT_EQ(HandEvaluator::categoryOf(s1), r1.rank);
+    EXPECT_EQ(HandEvaluator::toStrength(r1), s1);
+  }
+}
+
+TEST(HandEvaluatorTest, CardSetOverloadMatchesSpan) {
+  auto deck = fullDeck();
+  std::mt19937_64 rng(3);
+  for (int i = 0; i < 10000; ++i) {
+    std::shuffle(deck.begin(), deck.end(), rng);
+    std::span<const Card> hand(deck.data(), 5 + i % 3);
+    EXPECT_EQ(HandEvaluator::evaluateStrength(CardSet(hand)),
+              HandEvaluator::evaluateStrength(hand));
+  }
+  EXPECT_THROW((void)HandEvaluator::evaluateStrength(CardSet()),
+               std::invalid_argument);
+}
+
+TEST(HandEvaluatorTest, BatchMatchesScalarForEveryKernel) {
+  auto deck = fullDeck();
+  std::mt19937_64 rng(5);
+  std::vector<CardSet> hands;
+  for (int i = 0; i < 4099; ++i) { // Odd size exercises the kernel tails.
+    std::shuffle(deck.begin(), deck.end(), rng);
+    hands.emplace_back(std::span<const Card>(deck.data(), 5 + i % 3));
+  }
+
+  for (auto kernel : {EvalKernel::Scalar, EvalKernel::SSE42, EvalKernel::AVX2}) {
+    if (!HandEvaluator::isKernelSupported(kernel))
+      continue;
+    std::vector<HandStrength> out(hands.size());
+    HandEvaluator::evaluateBatch(hands, out, kernel);
+    for (size_t i = 0; i < hands.size(); ++i) {
+      ASSERT_EQ(out[i], HandEvaluator::evaluateStrength(hands[i]))
+          << HandEvaluator::kernelName(kernel) << " hand " << i;
+    }
+  }
+}
+
+TEST(HandEvaluatorTest, BatchWithSharedBoard) {
+  auto deck = fullDeck();
+  std::mt19937_64 rng(9);
+  std::shuffle(deck.begin(), deck.end(), rng);
+  CardSet board(std::span<const Card>(deck.data(), 5));
+
+  std::vector<CardSet> holes;
+  for (size_t i = 5; i + 1 < deck.size(); i += 2) {
+    holes.emplace_back(std::span<const Card>(deck.data() + i, 2));
+  }
+  std::vector<HandStrength> out(holes.size());
+  HandEvaluator::evaluateBatch(board, holes, out);
+  for (size_t i = 0; i < holes.size(); ++i) {
+    EXPECT_EQ(out[i], HandEvaluator::evaluateStrength(holes[i] | board));
+  }
+
+  std::vector<HandStrength> tooSmall(1);
+  EXPECT_THROW(HandEvaluator::evaluateBatch(board, holes, tooSmall),
+               std::invalid_argument);
+}
+
+TEST(HandEvaluatorTest, RejectsDuplicateCards) {
+  std::vector<Card> cards = {
+      {Rank::Ace, Suit::Spades}, {Rank::Ace, Suit::Spades},
+      {Rank::King, Suit::Hearts}, {Rank::Queen, Suit::Clubs},
+      {Rank::Jack, Suit::Spades},
+  };
+  EXPECT_THROW((void)HandEvaluator::evaluate(cards), std::invalid_argument);
+}
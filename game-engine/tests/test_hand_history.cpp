@@ -0,0 +1,213 @@
+#include "core/Random.h"
+#include "engine/HandHistory.h"
+#include "engine/PokerEngine.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+using namespace poker::test;
+
+namespace {
+
+/// Mostly calls and checks, with some raises, all-ins and folds, so the
+/// recorded hands cover every action type and side pots.
+class VariedProvider : public poker::interfaces::IActionProvider {
+public:
+  Action getAction(size_t, const GameState &,
+                   const std::vector<Action> &legal) override {
+    const ActionType order[] = {ActionType::Call,  ActionType::Raise,
+                                ActionType::Check, ActionType::Fold,
+                                ActionType::Bet,   ActionType::AllIn};
+    const ActionType want = order[next_++ % 6];
+    for (const auto &a : legal)
+      if (a.type == want)
+        return a;
+    return legal.front();
+  }
+
+private:
+  size_t next_ = 0;
+};
+
+/// Play `hands` 6-handed hands, recording them to `path`, and return what
+/// the engine saw of each.
+std::vector<GameState> playRecorded(const std::string &path, size_t hands,
+                                    uint64_t firstHandId = 0) {
+  HandHistoryWriter writer(path, firstHandId);
+  BasicPokerEngine<SharedActionProvider, Xoshiro256Generator,
+                   HandHistoryObserver>
+      engine(std::make_shared<VariedProvider>(), Xoshiro256Generator(7),
+             HandHistoryObserver{&writer});
+  std::vector<GameState> played;
+  for (size_t h = 0; h < hands; ++h) {
+    GameState state = makeTable({400, 550, 700, 850, 1000, 1150}, h % 6);
+    engine.playHand(state);
+    played.push_back(state);
+  }
+  EXPECT_EQ(writer.handsWritten(), hands);
+  return played;
+}
+
+} // namespace
+
+TEST(HandHistoryTest, EngineHandsRoundTrip) {
+  const std::string path = tempPath("poker_hand_history_roundtrip.phh");
+  const auto played = playRecorded(path, 200);
+
+  HandHistoryReader reader = HandHistoryReader::open(path);
+  ASSERT_EQ(reader.size(), played.size());
+  size_t h = 0;
+  HandRecord record;
+  for (const HandView &view : reader) {
+    view.decode(record);
+    const GameState &state = played[h];
+    EXPECT_EQ(view.handId(), h);
+    EXPECT_EQ(record.handId, h);
+    EXPECT_EQ(record.dealer, h % 6);
+    EXPECT_EQ(record.bigBlind, 10);
+    ASSERT_EQ(record.numSeats(), 6u);
+    for (size_t i = 0; i < 6; ++i) {
+      EXPECT_EQ(record.startingStacks[i], static_cast<int64_t>(400 + 150 * i));
+      EXPECT_EQ(record.holeCards[i], state.getPlayer(i).getHoleCardSet());
+      EXPECT_EQ(record.finalStacks[i], state.getPlayer(i).getChips());
+    }
+    EXPECT_EQ(record.board, state.getCommunityCards());
+    EXPECT_EQ(record.actions, state.getActionHistory());
+    ++h;
+  }
+  EXPECT_EQ(h, played.size());
+
+  // The format's point: a 6-handed hand in about 100 bytes.
+  const double perHand =
+      static_cast<double>(reader.fileSize() - hand_history::kHeaderSize) /
+      static_cast<double>(reader.size());
+  EXPECT_LT(perHand, 110.0);
+  std::filesystem::remove(path);
+}
+
+TEST(HandHistoryTest, ReopeningAppends) {
+  const std::string path = tempPath("poker_hand_history_append.phh");
+  (void)playRecorded(path, 10);
+  (void)playRecorded(path, 5, 10);
+  HandHistoryReader reader = HandHistoryReader::open(path);
+  ASSERT_EQ(reader.size(), 15u);
+  uint64_t expected = 0;
+  for (const HandView &view : reader)
+    EXPECT_EQ(view.handId(), expected++);
+  std::filesystem::remove(path);
+}
+
+TEST(HandHistoryTest, RejectedRecordsLeaveNothingBehind) {
+  const std::string path = tempPath("poker_hand_history_rejected.phh");
+  HandRecord good;
+  good.startingStacks = {100, 100};
+  good.holeCards = {CardSet(), CardSet()};
+  good.actions = {Action(ActionType::Bet, 5, 0),
+                  Action(ActionType::Fold, 0, 1)};
+  good.finalStacks = {105, 95};
+  HandRecord bad = good;
+  bad.handId = 1;
+  // Fails only after most of the record has been encoded.
+  bad.actions.push_back(Action(ActionType::Call, 10, 7));
+  {
+    HandHistoryWriter writer(path);
+    writer.append(good);
+    EXPECT_THROW(writer.append(bad), std::invalid_argument);
+    good.handId = 2;
+    writer.append(good);
+    EXPECT_EQ(writer.handsWritten(), 2u);
+  }
+  HandHistoryReader reader = HandHistoryReader::open(path);
+  ASSERT_EQ(reader.size(), 2u);
+  EXPECT_EQ(reader.begin()->handId(), 0u);
+  EXPECT_EQ(std::next(reader.begin())->decode(), good);
+  std::filesystem::remove(path);
+}
+
+TEST(HandHistoryTest, ReopeningCutsOffATornRecord) {
+  const std::string path = tempPath("poker_hand_history_torn.phh");
+  (void)playRecorded(path, 4);
+  // A crash in the middle of writing the last hand.
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+  EXPECT_THROW((void)HandHistoryReader::open(path), std::runtime_error);
+
+  (void)playRecorded(path, 2, 3);
+  HandHistoryReader reader = HandHistoryReader::open(path);
+  ASSERT_EQ(reader.size(), 5u);
+  uint64_t expected = 0;
+  for (const HandView &view : reader) {
+    EXPECT_EQ(view.handId(), expected++);
+    EXPECT_NO_THROW((void)view.decode());
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(HandHistoryTest, RecordsRoundTripExactly) {
+  HandRecord record;
+  record.handId = uint64_t{1} << 40;
+  record.dealer = 2;
+  record.smallBlind = 50;
+  record.bigBlind = 100;
+  record.startingStacks = {1000, 0, 1'000'000'000'000};
+  record.holeCards = {CardSet::of(Card(Rank::Ace, Suit::Spades)) |
+                          CardSet::of(Card(Rank::King, Suit::Spades)),
+                      CardSet(),
+                      CardSet::of(Card(Rank::Two, Suit::Hearts)) |
+                          CardSet::of(Card(Rank::Two, Suit::Clubs))};
+  record.board = {Card(Rank::Ten, Suit::Diamonds),
+                  Card(Rank::Three, Suit::Spades),
+                  Card(Rank::Nine, Suit::Hearts)};
+  record.actions = {Action(ActionType::Bet, 50, 0),
+                    Action(ActionType::Bet, 100, 2),
+                    Action(ActionType::AllIn, 1000, 0),
+                    Action(ActionType::Call, 900, 2)};
+  record.finalStacks = {0, 0, 1'000'000'001'000};
+
+  std::vector<uint8_t> bytes;
+  hand_history::encode(record, bytes);
+  // Skip the one-byte length prefix.
+  ASSERT_EQ(bytes[0], bytes.size() - 1);
+  HandRecord decoded;
+  hand_history::decode(std::span(bytes).subspan(1), decoded);
+  EXPECT_EQ(decoded, record);
+
+  record.finalStacks.pop_back();
+  EXPECT_THROW(hand_history::encode(record, bytes), std::invalid_argument);
+}
+
+TEST(HandHistoryTest, RejectsForeignTruncatedAndCorruptFiles) {
+  const std::string path = tempPath("poker_hand_history_bad.phh");
+  EXPECT_THROW((void)HandHistoryReader::open(path), std::runtime_error);
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "not a hand history file";
+  }
+  EXPECT_THROW((void)HandHistoryReader::open(path), std::runtime_error);
+  EXPECT_THROW(HandHistoryWriter writer(path), std::runtime_error);
+
+  std::filesystem::remove(path);
+  (void)playRecorded(path, 3);
+  const auto size = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, size - 1);
+  EXPECT_THROW((void)HandHistoryReader::open(path), std::runtime_error);
+
+  // A record whose length fits but whose body does not decode.
+  std::filesystem::resize_file(path, hand_history::kHeaderSize);
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    const char garbage[] = {3, 0, 65, 0};
+    out.write(garbage, sizeof(garbage));
+  }
+  HandHistoryReader reader = HandHistoryReader::open(path);
+  ASSERT_EQ(reader.size(), 1u);
+  EXPECT_THROW((void)reader.begin()->decode(), std::runtime_error);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,102 @@
+#include "core/Random.h"
+#include "utils/HandIndexer.h"
+#include <gtest/gtest.h>
+
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::utils;
+
+namespace {
+
+/// A random hand: two hole cards and `boardCards` board cards.
+void randomHand(PhiloxGenerator &rng, size_t boardCards, CardSet &hole,
+                CardSet &board) {
+  std::vector<Card> deck;
+  for (Card c : CardSet::fullDeck())
+    deck.push_back(c);
+  rng.shuffle(deck);
+  hole = CardSet(std::span<const Card>(deck.data(), 2));
+  board = CardSet(std::span<const Card>(deck.data() + 2, boardCards));
+}
+
+} // namespace
+
+TEST(HandIndexerTest, ClassCountsPerStreet) {
+  EXPECT_EQ(HandIndexer::forStreet(Street::Preflop).size(), 169u);
+  EXPECT_EQ(HandIndexer::forStreet(Street::Flop).size(), 1286792u);
+  EXPECT_EQ(HandIndexer::forStreet(Street::Turn).size(), 13960050u);
+  EXPECT_EQ(HandIndexer::forStreet(Street::River).size(), 123156254u);
+  EXPECT_THROW(HandIndexer(2), std::invalid_argument);
+  EXPECT_THROW((void)HandIndexer::forStreet(Street::Showdown),
+               std::invalid_argument);
+}
+
+TEST(HandIndexerTest, EveryFlopClassRoundTrips) {
+  // index(unindex(i)) == i for every i makes the classes distinct, so with
+  // isomorphic hands sharing an index the index is perfect and minimal.
+  const HandIndexer &indexer = HandIndexer::forStreet(Street::Flop);
+  size_t mismatches = 0;
+  for (uint64_t i = 0; i < indexer.size(); ++i) {
+    CardSet hole, board;
+    indexer.unindex(i, hole, board);
+    mismatches += indexer.index(hole, board) != i || hole.size() != 2 ||
+                  board.size() != 3 || hole.intersects(board);
+  }
+  EXPECT_EQ(mismatches, 0u);
+}
+
+TEST(HandIndexerTest, IsomorphicHandsShareAnIndex) {
+  PhiloxGenerator rng(7);
+  std::array<uint8_t, 4> perm = {0, 1, 2, 3};
+  for (size_t boardCards : {0, 3, 4, 5}) {
+    const HandIndexer indexer(boardCards);
+    for (int trial = 0; trial < 2000; ++trial) {
+      CardSet hole, board;
+      randomHand(rng, boardCards, hole, board);
+      std::next_permutation(perm.begin(), perm.end());
+      EXPECT_EQ(indexer.index(hole, board),
+                indexer.index(hole.permuteSuits(perm),
+                              board.permuteSuits(perm)));
+    }
+  }
+}
+
+TEST(HandIndexerTest, UnindexRoundTrips) {
+  PhiloxGenerator rng(11);
+  for (size_t boardCards : {0, 3, 4, 5}) {
+    const HandIndexer indexer(boardCards);
+    for (int trial = 0; trial < 5000; ++trial) {
+      const uint64_t i =
+          boardCards == 0 ? trial % indexer.size() : rng() % indexer.size();
+      CardSet hole, board;
+      indexer.unindex(i, hole, board);
+      EXPECT_EQ(hole.size(), 2u);
+      EXPECT_EQ(board.size(), boardCards);
+      EXPECT_FALSE(hole.intersects(board));
+      EXPECT_EQ(indexer.index(hole, board), i);
+    }
+    CardSet hole, board;
+    EXPECT_THROW(indexer.unindex(indexer.size(), hole, board),
+                 std::out_of_range);
+  }
+}
+
+TEST(HandIndexerTest, PreflopClassesMatchTheGrid) {
+  // Pairs, suited and offsuit hands are the 13 + 78 + 78 classes.
+  const HandIndexer &indexer = HandIndexer::forStreet(Street::Preflop);
+  const auto ak = [](Suit a, Suit b) {
+    return CardSet::of(Card(Rank::Ace, a)) | CardSet::of(Card(Rank::King, b));
+  };
+  EXPECT_EQ(indexer.index(ak(Suit::Hearts, Suit::Hearts), CardSet()),
+            indexer.index(ak(Suit::Spades, Suit::Spades), CardSet()));
+  EXPECT_EQ(indexer.index(ak(Suit::Hearts, Suit::Clubs), CardSet()),
+            indexer.index(ak(Suit::Spades, Suit::Diamonds), CardSet()));
+  EXPECT_NE(indexer.index(ak(Suit::Hearts, Suit::Hearts), CardSet()),
+            indexer.index(ak(Suit::Hearts, Suit::Clubs), CardSet()));
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "core/GameState.h"
+#include "interfaces/IActionProvider.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/// Fixtures shared by the engine, search and file-format tests.
+namespace poker::test {
+
+/// A scratch file path in the system temp directory, with anything an
+/// earlier run left there removed.
+inline std::string tempPath(const std::string &name) {
+  const auto path = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove(path);
+  return path.string();
+}
+
+/// Picks a legal action from the history length alone, so play mixes
+/// folds, calls and raises while every driver of the same hand (engine,
+/// cursor, scheduler, replay) makes the same choices.
+inline core::Action chooseByHistory(const core::GameState &state,
+                                    std::span<const core::Action> legal) {
+  return legal[(state.getActionHistory().size() * 7 + 3) % legal.size()];
+}
+
+/// An IActionProvider that asks `choose(state, legal)`.
+template <typename Choose>
+class ChoosingProvider : public interfaces::IActionProvider {
+public:
+  explicit ChoosingProvider(Choose choose) : choose_(std::move(choose)) {}
+
+  core::Action getAction(size_t, const core::GameState &state,
+                         const std::vector<core::Action> &legal) override {
+    return choose_(state, std::span<const core::Action>(legal));
+  }
+
+private:
+  Choose choose_;
+};
+
+/// ChoosingProvider for any callable `choose`, e.g. a lambda.
+template <typename Choose>
+std::shared_ptr<ChoosingProvider<Choose>> makeProvider(Choose choose) {
+  return std::make_shared<ChoosingProvider<Choose>>(std::move(choose));
+}
+
+/// The provider choosing with chooseByHistory().
+class HistoryProvider final
+    : public ChoosingProvider<decltype(&chooseByHistory)> {
+public:
+  HistoryProvider() : ChoosingProvider(&chooseByHistory) {}
+};
+
+/// A table with one seat per stack, named "P0", "P1", ..., blinds 5/10 and
+/// the button at `dealer`.
+inline core::GameState makeTable(const std::vector<int64_t> &stacks,
+                                 size_t dealer = 0) {
+  core::GameState state;
+  std::vector<core::Player> players;
+  for (size_t i = 0; i < stacks.size(); ++i)
+    players.emplace_back(i, "P" + std::to_string(i), stacks[i]);
+  state.setPlayers(std::move(players));
+  state.setSmallBlind(5);
+  state.setBigBlind(10);
+  state.setDealerPosition(dealer);
+  return state;
+}
+
+/// `seats` seats of `stack` chips each.
+inline core::GameState makeTable(size_t seats, int64_t stack,
+                                 size_t dealer = 0) {
+  return makeTable(std::vector<int64_t>(seats, stack), dealer);
+}
+
+/// Everything a hand's progress changes, as a comparable string: street,
+/// player to act, pot, board, actions, and per seat chips, bet,
+/// contribution, status and hole cards (as a set, ignoring deal order).
+inline std::string fingerprint(const core::GameState &state) {
+  std::string s = std::to_string(static_cast<int>(state.getStreet())) + "|" +
+                  std::to_string(state.getCurrentPlayerIndex()) + "|" +
+                  std::to_string(state.getPot().getTotal()) + "|" +
+                  std::to_string(state.getCommunityCardSet().bits()) + "|" +
+                  std::to_string(state.getCommunityCards().size()) + "|";
+  for (const auto &a : state.getActionHistory()) {
+    s += std::to_string(static_cast<int>(a.type)) + ":" +
+         std::to_string(a.amount) + ":" + std::to_string(a.playerId) + ",";
+  }
+  for (const auto &p : state.getPlayers()) {
+    s += "|" + std::to_string(p.getChips()) + "," +
+         std::to_string(p.getCurrentBet()) + "," +
+         std::to_string(state.getPot().getPlayerContribution(p.getId())) +
+         (p.isFolded() ? "f" : "") + (p.isAllIn() ? "a" : "") + "," +
+         std::to_string(p.getHoleCardSet().bits());
+  }
+  return s;
+}
+
+} // namespace poker::test
@@ -0,0 +1,88 @@
+#include "core/Random.h"
+#include "utils/KMeans.h"
+#include <gtest/gtest.h>
+
+
+#include <array>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace poker::utils;
+
+namespace {
+
+/// `n` points in three tight 2-D blobs, interleaved.
+std::vector<float> blobs(size_t n = 3000) {
+  constexpr std::array<std::array<float, 2>, 3> kCentres = {
+      {{0.0f, 0.0f}, {10.0f, 0.0f}, {0.0f, 10.0f}}};
+  poker::core::PhiloxGenerator rng(3);
+  std::vector<float> points;
+  for (size_t i = 0; i < n; ++i) {
+    for (float c : kCentres[i % 3]) {
+      const auto jitter = static_cast<float>(rng() % 1000) / 1000.0f - 0.5f;
+      points.push_back(c + jitter);
+    }
+  }
+  return points;
+}
+
+} // namespace
+
+TEST(KMeansTest, SeparatesBlobs) {
+  const auto points = blobs();
+  KMeans kmeans(2);
+  KMeansOptions options;
+  options.clusters = 3;
+  const auto result = kmeans.fit(points, 2, {}, options);
+  ASSERT_EQ(result.assignment.size(), 3000u);
+  ASSERT_EQ(result.centers.size(), 6u);
+  std::set<uint32_t> labels;
+  for (size_t i = 0; i < 3000; ++i) {
+    EXPECT_EQ(result.assignment[i], result.assignment[i % 3]);
+    labels.insert(result.assignment[i]);
+  }
+  EXPECT_EQ(labels.size(), 3u);
+  EXPECT_LT(result.inertia / 3000.0, 0.2);
+}
+
+TEST(KMeansTest, ResultDoesNotDependOnThreads) {
+  // Several blocks, so both passes really split across the threads.
+  const auto points = blobs(20000);
+  KMeansOptions options;
+  options.clusters = 7;
+  options.seedSample = 500;
+  KMeans one(1);
+  KMeans four(4);
+  const auto a = one.fit(points, 2, {}, options);
+  const auto b = four.fit(points, 2, {}, options);
+  EXPECT_EQ(a.assignment, b.assignment);
+  EXPECT_EQ(a.centers, b.centers);
+  EXPECT_EQ(a.iterations, b.iterations);
+}
+
+TEST(KMeansTest, WeightsPullTheCentre) {
+  const std::vector<float> points = {0.0f, 10.0f};
+  const std::vector<float> weights = {1.0f, 3.0f};
+  KMeansOptions options;
+  options.clusters = 1;
+  const auto result = KMeans(1).fit(points, 1, weights, options);
+  EXPECT_FLOAT_EQ(result.centers[0], 7.5f);
+}
+
+TEST(KMeansTest, RejectsBadInput) {
+  const std::vector<float> points = {0.0f, 1.0f, 2.0f};
+  KMeans kmeans(1);
+  KMeansOptions options;
+  options.clusters = 2;
+  EXPECT_THROW((void)kmeans.fit(points, 2, {}, options),
+               std::invalid_argument);
+  EXPECT_THROW((void)kmeans.fit(points, 0, {}, options),
+               std::invalid_argument);
+  const std::vector<float> weights = {1.0f};
+  EXPECT_THROW((void)kmeans.fit(points, 1, weights, options),
+               std::invalid_argument);
+  options.clusters = 4;
+  EXPECT_THROW((void)kmeans.fit(points, 1, {}, options),
+               std::invalid_argument);
+}
@@ -0,0 +1,58 @@
+#include "test_helpers.h"
+#include "utils/MappedFile.h"
+#include <gtest/gtest.h>
+
+
+#include <filesystem>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+using namespace poker::test;
+using namespace poker::utils;
+
+TEST(MappedFileTest, MapsWhatWasWrittenAtomically) {
+  const auto path = tempPath("poker_mapped_file.bin");
+  writeFileAtomically(path, "Test",
+                      [](std::ostream &out) { out << "first version"; });
+  MappedFile first = MappedFile::open(path, "Test", MapAccess::Random);
+
+  // Replacing the file leaves an existing mapping on the old contents.
+  writeFileAtomically(path, "Test", [](std::ostream &out) { out << "v2"; });
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+  const MappedFile second = MappedFile::open(path, "Test");
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(first.data()),
+                        first.size()),
+            "first version");
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(second.data()),
+                        second.size()),
+            "v2");
+
+  MappedFile moved = std::move(first);
+  EXPECT_EQ(moved.size(), 13u);
+  EXPECT_EQ(first.size(), 0u);
+  EXPECT_EQ(first.data(), nullptr);
+
+  writeFileAtomically(path, "Test", [](std::ostream &) {});
+  EXPECT_TRUE(MappedFile::open(path, "Test").bytes().empty());
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, ReportsFailuresUnderItsOwner) {
+  const auto missing = tempPath("poker_no_such_file.bin");
+  try {
+    (void)MappedFile::open(missing, "Owner");
+    FAIL() << "expected an error";
+  } catch (const std::runtime_error &e) {
+    EXPECT_EQ(std::string(e.what()), "Owner: cannot open " + missing);
+  }
+
+  const auto path = tempPath("poker_mapped_bad.bin");
+  EXPECT_THROW(writeFileAtomically(path, "Owner",
+                                   [](std::ostream &out) {
+                                     out.setstate(std::ios::badbit);
+                                   }),
+               std::runtime_error);
+  EXPECT_FALSE(std::filesystem::exists(path));
+  std::filesystem::remove(path + ".tmp");
+}
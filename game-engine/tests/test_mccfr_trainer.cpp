@@ -0,0 +1,186 @@
+#include "solver/MccfrTrainer.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace poker::core;
+using namespace poker::solver;
+using namespace poker::test;
+
+namespace {
+
+/// Highest hole-card rank (2..14), whatever the street.
+uint64_t highCard(Street, CardSet hole, CardSet) {
+  uint32_t ranks = 0;
+  for (unsigned s = 0; s < 4; ++s)
+    ranks |= hole.suitMask(static_cast<Suit>(s));
+  return static_cast<uint64_t>(std::bit_width(ranks)) + 1;
+}
+
+/// Two-big-blind stacks with no bet sizes: the small blind folds, calls or
+/// shoves, so the game is tiny and trains in a blink.
+MccfrConfig pushFold() {
+  MccfrConfig config;
+  config.startingStack = 200;
+  config.smallBlind = 50;
+  config.bigBlind = 100;
+  config.tableBits = 12;
+  config.cardBuckets = highCard;
+  return config;
+}
+
+/// The small blind's average strategy at the root with an ace high:
+/// fold, call, all-in.
+std::array<float, 3> aceHighOpening(const MccfrTrainer &trainer) {
+  const CardSet hole(std::array<Card, 2>{Card(Rank::Ace, Suit::Spades),
+                                         Card(Rank::Two, Suit::Hearts)});
+  const uint64_t key = MccfrTrainer::infoSetKey(
+      MccfrTrainer::kRootHistory, 0,
+      trainer.cardBucket(Street::Preflop, hole, CardSet()));
+  std::array<float, 3> sigma{};
+  EXPECT_TRUE(trainer.averageStrategy(key, sigma));
+  return sigma;
+}
+
+} // namespace
+
+TEST(MccfrTrainerTest, RejectsBadConfigurations) {
+  MccfrConfig config = pushFold();
+  config.bigBlind = 0;
+  EXPECT_THROW(MccfrTrainer{config}, std::invalid_argument);
+
+  config = pushFold();
+  config.tableBits = 40;
+  EXPECT_THROW(MccfrTrainer{config}, std::invalid_argument);
+
+  config = pushFold();
+  config.actions.setSizes(Street::Flop, 0, {0.25, 0.5, 1.0, 2.0});
+  EXPECT_THROW(MccfrTrainer{config}, std::invalid_argument);
+
+  config = pushFold();
+  config.checkpointEvery = 10;
+  EXPECT_THROW(MccfrTrainer{config}, std::invalid_argument);
+}
+
+TEST(MccfrTrainerTest, SingleThreadedRunsAreReproducible) {
+  MccfrTrainer a(pushFold());
+  MccfrTrainer b(pushFold());
+  a.train(2000, 1);
+  b.train(2000, 1);
+  EXPECT_EQ(a.getIterations(), 2000u);
+  EXPECT_GT(a.numInfoSets(), 0u);
+  EXPECT_EQ(a.numInfoSets(), b.numInfoSets());
+  EXPECT_EQ(aceHighOpening(a), aceHighOpening(b));
+}
+
+TEST(MccfrTrainerTest, LearnsNotToFoldAceHighForTwoBigBlinds) {
+  MccfrTrainer trainer(pushFold());
+  trainer.train(20000, 1);
+  const auto sigma = aceHighOpening(trainer);
+  EXPECT_LT(sigma[0], 0.1f);
+  EXPECT_NEAR(sigma[0] + sigma[1] + sigma[2], 1.0f, 1e-5f);
+}
+
+TEST(MccfrTrainerTest, TrainsOnSeveralThreads) {
+  MccfrConfig config = pushFold();
+  config.startingStack = 1000;
+  config.tableBits = 16;
+  config.actions.setSizes(Street::Preflop, 0, {1.0});
+  config.actions.setSizes(Street::Flop, 0, {0.5, 1.0});
+  config.maxRaisesPerStreet = 2;
+  MccfrTrainer trainer(config);
+  trainer.train(4000, 4);
+  EXPECT_EQ(trainer.getIterations(), 4000u);
+  EXPECT_GT(trainer.numInfoSets(), 100u);
+  EXPECT_LE(trainer.numInfoSets(), trainer.tableCapacity());
+}
+
+TEST(MccfrTrainerTest, CheckpointRoundTripsAndTrainingContinues) {
+  const auto path = tempPath("poker_mccfr_roundtrip.bin");
+  MccfrTrainer original(pushFold());
+  original.train(1000, 1);
+  original.saveCheckpoint(path);
+  original.train(1000, 1);
+
+  MccfrTrainer resumed(pushFold());
+  resumed.loadCheckpoint(path);
+  EXPECT_EQ(resumed.getIterations(), 1000u);
+  resumed.train(1000, 1);
+  EXPECT_EQ(resumed.getIterations(), 2000u);
+  EXPECT_EQ(resumed.numInfoSets(), original.numInfoSets());
+  EXPECT_EQ(aceHighOpening(resumed), aceHighOpening(original));
+  std::filesystem::remove(path);
+}
+
+TEST(MccfrTrainerTest, CheckpointsPeriodically) {
+  const auto path = tempPath("poker_mccfr_periodic.bin");
+  MccfrConfig config = pushFold();
+  config.checkpointEvery = 300;
+  config.checkpointPath = path;
+  MccfrTrainer trainer(config);
+  trainer.train(1000, 1);
+  ASSERT_TRUE(std::filesystem::exists(path));
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+  MccfrTrainer loaded(pushFold());
+  loaded.loadCheckpoint(path);
+  EXPECT_EQ(loaded.getIterations(), 900u);
+  std::filesystem::remove(path);
+}
+
+TEST(MccfrTrainerTest, RejectsForeignOrCorruptCheckpoints) {
+  const auto path = tempPath("poker_mccfr_bad.bin");
+  MccfrTrainer trainer(pushFold());
+  EXPECT_THROW(trainer.loadCheckpoint(path + ".missing"), std::runtime_error);
+
+  trainer.train(200, 1);
+  trainer.saveCheckpoint(path);
+  MccfrConfig deeper = pushFold();
+  deeper.startingStack = 400;
+  MccfrTrainer other(deeper);
+  EXPECT_THROW(other.loadCheckpoint(path), std::runtime_error);
+
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+  EXPECT_THROW(trainer.loadCheckpoint(path), std::runtime_error);
+
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "not a checkpoint at all, just some text";
+  }
+  EXPECT_THROW(trainer.loadCheckpoint(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(MccfrTrainerTest, FailedLoadsNeverLeaveAHalfLoadedTable) {
+  const auto path = tempPath("poker_mccfr_fit.bin");
+  MccfrTrainer big(pushFold());
+  big.train(500, 1);
+  big.saveCheckpoint(path);
+
+  // Too many information sets: rejected before anything is touched.
+  MccfrConfig tiny = pushFold();
+  tiny.tableBits = 6;
+  MccfrTrainer small(tiny);
+  small.train(1, 1);
+  const size_t before = small.numInfoSets();
+  ASSERT_GT(big.numInfoSets(), small.tableCapacity());
+  EXPECT_THROW(small.loadCheckpoint(path), std::runtime_error);
+  EXPECT_EQ(small.getIterations(), 1u);
+  EXPECT_EQ(small.numInfoSets(), before);
+
+  // Corrupt past the header: the trainer is left empty.
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+  MccfrTrainer resumed(pushFold());
+  resumed.train(100, 1);
+  EXPECT_THROW(resumed.loadCheckpoint(path), std::runtime_error);
+  EXPECT_EQ(resumed.getIterations(), 0u);
+  EXPECT_EQ(resumed.numInfoSets(), 0u);
+  std::filesystem::remove(path);
+}
@@ -1,11 +1,17 @@
+#include "core/Random.h"
+#include "engine/HandCoroutine.h"
 #include "engine/PokerEngine.h"
 #include "interfaces/IActionProvider.h"
 #include "interfaces/IRandomGenerator.h"
+#include "test_helpers.h"
 #include <gtest/gtest.h>
 
+#include <set>
+
 
 using namespace poker::core;
 using namespace poker::engine;
+using namespace poker::test;
 
 /// Deterministic RNG for testing.
 class TestRNG : public poker::interfaces::IRandomGenerator {
@@ -37,6 +43,18 @@ public:
   }
 };
 
+void expectSameHand(const GameState &a, const GameState &b) {
+  ASSERT_EQ(a.getActionHistory().size(), b.getActionHistory().size());
+  for (size_t i = 0; i < a.getActionHistory().size(); ++i) {
+    EXPECT_EQ(a.getActionHistory()[i].type, b.getActionHistory()[i].type);
+    EXPECT_EQ(a.getActionHistory()[i].amount, b.getActionHistory()[i].amount);
+  }
+  EXPECT_EQ(a.getCommunityCardSet(), b.getCommunityCardSet());
+  for (size_t i = 0; i < a.getPlayers().size(); ++i) {
+    EXPECT_EQ(a.getPlayer(i).getChips(), b.getPlayer(i).getChips());
+  }
+}
+
 class PokerEngineTest : public ::testing::Test {
 protected:
   std::shared_ptr<TestRNG> rng;
@@ -124,8 +142,290 @@ TEST_F(PokerEngineTest, MultipleHandsDeterministic) {
 TEST_F(PokerEngineTest, EventCallbackFires) {
   int eventCount = 0;
   engine->setEventCallback(
-      [&](const std::string &, const GameState &) { ++eventCount; });
+      [&](const HandEvent &, const GameState &) { ++eventCount; });
 
   engine->playHand(state);
   EXPECT_GT(eventCount, 0) << "Events should fire during hand";
 }
+
+TEST_F(PokerEngineTest, EventsCarryStructuredPayloads) {
+  std::vector<HandEvent> events;
+  engine->setEventCallback(
+      [&](const HandEvent &e, const GameState &) { events.push_back(e); });
+  engine->playHand(state);
+
+  // Passive play always reaches showdown: blinds, four streets, one pot.
+  ASSERT_FALSE(events.empty());
+  EXPECT_TRUE(std::holds_alternative<HandStarted>(events.front()));
+  size_t blinds = 0, streets = 0, actions = 0, pots = 0;
+  int64_t blindTotal = 0, awarded = 0;
+  for (const auto &event : events) {
+    std::visit(Overloaded{
+                   [&](const BlindPosted &e) {
+                     ++blinds;
+                     blindTotal += e.amount;
+                   },
+                   [&](const StreetStarted &e) {
+                     EXPECT_EQ(static_cast<size_t>(e.street), streets);
+                     EXPECT_EQ(e.board.size(), streets == 0 ? 0u : streets + 2);
+                     ++streets;
+                   },
+                   [&](const ActionTaken &e) {
+                     EXPECT_TRUE(e.action.type == ActionType::Check ||
+                                 e.action.type == ActionType::Call);
+                     ++actions;
+                   },
+                   [&](const PotAwarded &e) {
+                     EXPECT_FALSE(e.uncontested);
+                     EXPECT_NE(e.winners, 0u);
+                     EXPECT_GT(e.strength, 0);
+                     awarded += e.amount;
+                     ++pots;
+                   },
+                   [](const auto &) {},
+               },
+               event);
+  }
+  EXPECT_EQ(blinds, 2u);
+  EXPECT_EQ(blindTotal, 15);
+  EXPECT_EQ(streets, 4u);
+  EXPECT_GE(actions, 8u);
+  EXPECT_EQ(pots, 1u);
+  EXPECT_EQ(awarded, 20);
+  ASSERT_GE(events.size(), 2u);
+  EXPECT_TRUE(std::holds_alternative<PotAwarded>(events[events.size() - 2]));
+  EXPECT_TRUE(std::holds_alternative<HandEnded>(events.back()));
+}
+
+TEST_F(PokerEngineTest, CompileTimeObserversMatchCallbackEngine) {
+  // A custom observer type sees the same stream as the callback engine;
+  // the headless engine plays the identical hand with no observer at all.
+  struct CountingObserver {
+    size_t *count;
+    void operator()(const HandEvent &, const GameState &) const { ++*count; }
+  };
+  size_t callbackEvents = 0, observed = 0;
+  engine->setEventCallback(
+      [&](const HandEvent &, const GameState &) { ++callbackEvents; });
+  BasicPokerEngine<SharedActionProvider, SharedRandomGenerator,
+                   CountingObserver>
+      counting(actionProvider, std::make_shared<TestRNG>(42),
+               CountingObserver{&observed});
+  HeadlessPokerEngine headless(actionProvider, std::make_shared<TestRNG>(42));
+
+  GameState state2 = state, state3 = state;
+  engine->playHand(state);
+  counting.playHand(state2);
+  headless.playHand(state3);
+  EXPECT_EQ(observed, callbackEvents);
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(state2.getPlayer(i).getChips(), state.getPlayer(i).getChips());
+    EXPECT_EQ(state3.getPlayer(i).getChips(), state.getPlayer(i).getChips());
+  }
+}
+
+TEST(PokerEngineStepTest, StepApiMatchesPlayHand) {
+  auto provider = std::make_shared<HistoryProvider>();
+  PokerEngine blocking(provider, std::make_shared<TestRNG>(7));
+  HeadlessPokerEngine stepped(std::make_shared<TestRNG>(7));
+
+  GameState expected, actual;
+  for (size_t hand = 0; hand < 50; ++hand) {
+    expected = makeTable(3, 1000, hand % 3);
+    actual = makeTable(3, 1000, hand % 3);
+    blocking.playHand(expected);
+
+    EXPECT_FALSE(stepped.pendingDecision().has_value());
+    stepped.startHand(actual);
+    EXPECT_TRUE(stepped.isHandInProgress());
+    while (stepped.advance() == StepStatus::AwaitingAction) {
+      // advance() is idempotent while a decision is pending.
+      ASSERT_EQ(stepped.advance(), StepStatus::AwaitingAction);
+      const auto decision = stepped.pendingDecision();
+      ASSERT_TRUE(decision.has_value());
+      EXPECT_EQ(decision->playerId, actual.getCurrentPlayerIndex());
+      stepped.submit(chooseByHistory(actual, decision->legalActions));
+    }
+    EXPECT_FALSE(stepped.isHandInProgress());
+    EXPECT_EQ(actual.getStreet(), Street::Showdown);
+    expectSameHand(expected, actual);
+  }
+}
+
+TEST(PokerEngineStepTest, RejectsOutOfTurnCalls) {
+  HeadlessPokerEngine engine(std::make_shared<TestRNG>(1));
+  GameState state = makeTable(3, 1000);
+  EXPECT_THROW(engine.advance(), std::logic_error);
+  EXPECT_THROW(engine.playHand(state), std::logic_error); // no provider
+
+  engine.startHand(state);
+  EXPECT_THROW(engine.submit(Action(ActionType::Check, 0, 0)),
+               std::logic_error); // advance() first
+  ASSERT_EQ(engine.advance(), StepStatus::AwaitingAction);
+
+  // Facing the big blind, checking is illegal; the state is left as is.
+  const size_t history = state.getActionHistory().size();
+  EXPECT_THROW(engine.submit(Action(ActionType::Check, 0, 0)),
+               std::invalid_argument);
+  EXPECT_EQ(state.getActionHistory().size(), history);
+  ASSERT_TRUE(engine.pendingDecision().has_value());
+  engine.submit(Action(ActionType::Fold, 0, 0));
+}
+
+TEST(PokerEngineStepTest, RejectsTablesTheDeckCannotDeal) {
+  // Everyone calls down, so a full table needs 2 * 22 + 5 + 3 = 52 cards.
+  using LazyEngine = BasicPokerEngine<PassiveActionProvider,
+                                      Xoshiro256Generator, NullObserver>;
+  LazyEngine engine(PassiveActionProvider{}, Xoshiro256Generator(23));
+  GameState full = makeTable(kMaxTableSeats, 1000);
+  engine.playHand(full);
+  CardSet dealt = full.getCommunityCardSet();
+  EXPECT_EQ(full.getCommunityCards().size(), 5u);
+  for (const auto &p : full.getPlayers()) {
+    ASSERT_EQ(p.getHoleCards().size(), 2u);
+    dealt |= p.getHoleCardSet();
+  }
+  EXPECT_EQ(dealt.size(), 2 * kMaxTableSeats + 5);
+
+  GameState crowded = makeTable(kMaxTableSeats + 1, 1000);
+  EXPECT_THROW(engine.playHand(crowded), std::invalid_argument);
+  EXPECT_THROW(engine.startHand(crowded), std::invalid_argument);
+  EXPECT_FALSE(engine.isHandInProgress());
+}
+
+TEST(PokerEngineStepTest, CoroutineMatchesPlayHand) {
+  auto provider = std::make_shared<HistoryProvider>();
+  PokerEngine blocking(provider, std::make_shared<TestRNG>(11));
+  HeadlessPokerEngine stepped(std::make_shared<TestRNG>(11));
+
+  GameState expected, actual;
+  for (size_t hand = 0; hand < 20; ++hand) {
+    expected = makeTable(3, 1000, hand % 3);
+    actual = makeTable(3, 1000, hand % 3);
+    blocking.playHand(expected);
+
+    auto coroutine = playHandCoroutine(stepped, actual);
+    while (!coroutine.done()) {
+      ASSERT_TRUE(coroutine.decision().has_value());
+      coroutine.submit(
+          chooseByHistory(actual, coroutine.decision()->legalActions));
+    }
+    EXPECT_FALSE(coroutine.decision().has_value());
+    EXPECT_THROW(coroutine.submit(Action()), std::logic_error);
+    expectSameHand(expected, actual);
+  }
+
+  actual = makeTable(3, 1000);
+  auto coroutine = playHandCoroutine(stepped, actual);
+  ASSERT_FALSE(coroutine.done());
+  EXPECT_THROW(coroutine.submit(Action(ActionType::Check, 0, 0)),
+               std::invalid_argument);
+  EXPECT_TRUE(coroutine.done());
+}
+
+TEST(PokerEngineStepTest, OneThreadDrivesManyTables) {
+  // Interleave decisions across tables round-robin; every table must play
+  // exactly the hands it would have played on its own.
+  constexpr size_t kTables = 16;
+  constexpr size_t kHands = 10;
+  auto provider = std::make_shared<HistoryProvider>();
+
+  std::vector<GameState> expected(kTables);
+  for (size_t t = 0; t < kTables; ++t) {
+    PokerEngine engine(provider, std::make_shared<TestRNG>(100 + t));
+    for (size_t hand = 0; hand < kHands; ++hand) {
+      expected[t] = makeTable(3, 1000, hand % 3);
+      engine.playHand(expected[t]);
+    }
+  }
+
+  std::vector<HeadlessPokerEngine> engines;
+  engines.reserve(kTables);
+  std::vector<GameState> tables(kTables);
+  std::vector<size_t> handsPlayed(kTables, 0);
+  for (size_t t = 0; t < kTables; ++t) {
+    engines.emplace_back(std::make_shared<TestRNG>(100 + t));
+    tables[t] = makeTable(3, 1000);
+    engines[t].startHand(tables[t]);
+  }
+
+  size_t running = kTables;
+  while (running > 0) {
+    for (size_t t = 0; t < kTables; ++t) {
+      if (handsPlayed[t] == kHands)
+        continue;
+      if (engines[t].advance() == StepStatus::AwaitingAction) {
+        const auto decision = engines[t].pendingDecision();
+        engines[t].submit(chooseByHistory(tables[t], decision->legalActions));
+      } else if (++handsPlayed[t] == kHands) {
+        --running;
+      } else {
+        tables[t] = makeTable(3, 1000, handsPlayed[t] % 3);
+        engines[t].startHand(tables[t]);
+      }
+    }
+  }
+  for (size_t t = 0; t < kTables; ++t) {
+    expectSameHand(expected[t], tables[t]);
+  }
+}
+
+TEST(PokerEngineLazyDeckTest, ConcreteGeneratorDealsLazilyAndReproducibly) {
+  // Xoshiro256Generator is a bit generator, so this engine draws cards one
+  // at a time from a LazyDeck instead of shuffling.
+  using LazyEngine =
+      BasicPokerEngine<HistoryProvider, Xoshiro256Generator, NullObserver>;
+  LazyEngine a(HistoryProvider{}, Xoshiro256Generator(3));
+  LazyEngine b(HistoryProvider{}, Xoshiro256Generator(3));
+
+  GameState sa, sb;
+  std::set<std::string> holes;
+  for (size_t hand = 0; hand < 30; ++hand) {
+    sa = makeTable(3, 1000, hand % 3);
+    sb = makeTable(3, 1000, hand % 3);
+    a.playHand(sa);
+    b.playHand(sb);
+    expectSameHand(sa, sb);
+
+    CardSet dealt = sa.getCommunityCardSet();
+    size_t cards = sa.getCommunityCards().size();
+    int64_t chips = 0;
+    for (const auto &p : sa.getPlayers()) {
+      dealt |= p.getHoleCardSet();
+      cards += p.getHoleCards().size();
+      chips += p.getChips();
+    }
+    EXPECT_EQ(dealt.size(), cards) << "a card was dealt twice";
+    EXPECT_EQ(chips, 3000);
+    holes.insert(sa.getPlayer(0).getHoleCards()[0].toString() +
+                  sa.getPlayer(0).getHoleCards()[1].toString());
+  }
+  EXPECT_GT(holes.size(), 20u) << "hands should differ";
+}
+
+TEST(PokerEngineLazyDeckTest, AnyHandReplaysFromSeedTableAndHand) {
+  // Play a table through the type-erased engine (full shuffles), then
+  // regenerate single hands with a value-held generator (lazy deals).
+  auto rng = std::make_shared<PhiloxGenerator>(9, 4);
+  PokerEngine engine(std::make_shared<HistoryProvider>(), rng);
+  std::vector<GameState> played;
+  GameState state;
+  for (size_t hand = 0; hand < 12; ++hand) {
+    state = makeTable(3, 1000, hand % 3);
+    engine.playHand(state);
+    played.push_back(state);
+  }
+  EXPECT_EQ(rng->getHand(), 11u);
+
+  for (size_t hand : {0u, 5u, 11u}) {
+    BasicPokerEngine<HistoryProvider, PhiloxGenerator, NullObserver>
+        replay(HistoryProvider{}, PhiloxGenerator(9, 4, hand));
+    GameState again = makeTable(3, 1000, hand % 3);
+    replay.playHand(again);
+    expectSameHand(played[hand], again);
+    for (size_t s = 0; s < 3; ++s) {
+      EXPECT_EQ(again.getPlayer(s).getHoleCardSet(),
+                played[hand].getPlayer(s).getHoleCardSet());
+    }
+  }
+}
@@ -94,6 +94,26 @@ TEST(PotTest, MultipleAllIns) {
   EXPECT_EQ(pots[2].amount, 40);
 }
 
+TEST(PotTest, SeatMaskSidePotsMatch) {
+  // Player 0: all-in 30, Player 1: 60 (folded), Player 2: 100, Player 3: 100
+  Pot pot;
+  pot.addContribution(0, 30);
+  pot.addContribution(1, 60);
+  pot.addContribution(2, 100);
+  pot.addContribution(3, 100);
+
+  std::vector<SidePot> pots;
+  pot.calculateSidePots(seatBit(1), pots);
+
+  ASSERT_EQ(pots.size(), 3u);
+  EXPECT_EQ(pots[0].amount, 120);
+  EXPECT_EQ(pots[0].eligible, seatBit(0) | seatBit(2) | seatBit(3));
+  EXPECT_EQ(pots[1].amount, 90);
+  EXPECT_EQ(pots[1].eligible, seatBit(2) | seatBit(3));
+  EXPECT_EQ(pots[2].amount, 80);
+  EXPECT_EQ(pots[2].eligible, seatBit(2) | seatBit(3));
+}
+
 TEST(PotTest, Reset) {
   Pot pot;
   pot.addContribution(0, 100);
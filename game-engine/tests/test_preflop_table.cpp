@@ -0,0 +1,101 @@
+#include "utils/EquityCalculator.h"
+#include "utils/PreflopTable.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::utils;
+using namespace poker::test;
+
+TEST(PreflopTableTest, HandClassesCoverTheGrid) {
+  std::set<size_t> seen;
+  size_t combos = 0;
+  for (size_t cls = 0; cls < PreflopTable::kNumClasses; ++cls) {
+    EXPECT_EQ(PreflopTable::handClass(PreflopTable::className(cls)), cls);
+    for (CardSet hand : PreflopTable::combos(cls)) {
+      EXPECT_EQ(PreflopTable::handClass(hand), cls);
+      ++combos;
+    }
+    seen.insert(cls);
+  }
+  EXPECT_EQ(combos, 1326u);
+  EXPECT_EQ(PreflopTable::className(0), "AA");
+  EXPECT_EQ(PreflopTable::className(1), "AKs");
+  EXPECT_EQ(PreflopTable::className(13), "AKo");
+  EXPECT_THROW((void)PreflopTable::handClass("AAs"), std::invalid_argument);
+}
+
+TEST(PreflopTableTest, WriteThenMapRoundTrips) {
+  constexpr size_t n = PreflopTable::kNumClasses;
+  std::vector<float> headsUp(n * n);
+  for (size_t i = 0; i < headsUp.size(); ++i)
+    headsUp[i] = static_cast<float>(i) / static_cast<float>(headsUp.size());
+  const size_t aa = PreflopTable::handClass("AA");
+  const size_t kk = PreflopTable::handClass("KK");
+  const size_t qq = PreflopTable::handClass("QQ");
+  std::vector<PreflopTable::ThreeWaySpot> spots = {
+      {{static_cast<uint8_t>(kk), static_cast<uint8_t>(aa),
+        static_cast<uint8_t>(qq)},
+       {0.2f, 0.7f, 0.1f}}};
+
+  const std::string path = tempPath("poker_preflop_roundtrip.bin");
+  PreflopTable::write(path, headsUp, spots);
+  PreflopTable table = PreflopTable::open(path);
+
+  EXPECT_EQ(table.headsUp(3, 7), headsUp[3 * n + 7]);
+  EXPECT_EQ(table.headsUp(n - 1, n - 1), headsUp.back());
+  EXPECT_EQ(table.numThreeWay(), 1u);
+  auto eq = table.threeWay(aa, qq, kk);
+  ASSERT_TRUE(eq.has_value());
+  EXPECT_FLOAT_EQ((*eq)[0], 0.7f);
+  EXPECT_FLOAT_EQ((*eq)[1], 0.1f);
+  EXPECT_FLOAT_EQ((*eq)[2], 0.2f);
+  EXPECT_FALSE(table.threeWay(aa, kk, kk).has_value());
+
+  // Moving keeps the mapping alive.
+  PreflopTable moved = std::move(table);
+  EXPECT_EQ(moved.headsUp(3, 7), headsUp[3 * n + 7]);
+  std::filesystem::remove(path);
+}
+
+TEST(PreflopTableTest, RejectsForeignFiles) {
+  const std::string path = tempPath("poker_preflop_garbage.bin");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "definitely not a preflop table, but long enough to hold a header";
+  }
+  EXPECT_THROW((void)PreflopTable::open(path), std::runtime_error);
+  std::filesystem::remove(path);
+  EXPECT_THROW((void)PreflopTable::open(path), std::runtime_error);
+}
+
+TEST(PreflopTableTest, RejectsOffsetsThatWrapAround) {
+  constexpr size_t n = PreflopTable::kNumClasses;
+  const std::string path = tempPath("poker_preflop_wrap.bin");
+  PreflopTable::write(path, std::vector<float>(n * n, 0.5f), {});
+  {
+    // An aligned heads-up offset whose end wraps past 2^64 to byte 4.
+    const uint64_t offset = 4 - uint64_t{n * n * sizeof(float)};
+    std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(32); // Header::headsUpOffset
+    out.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+  }
+  EXPECT_THROW((void)PreflopTable::open(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(PreflopTableTest, ComputesKnownMatchup) {
+  // AA vs KK preflop is 81.95% for the aces.
+  EquityCalculator calc(2);
+  double eq = PreflopTable::computeHeadsUp(calc, PreflopTable::handClass("AA"),
+                                           PreflopTable::handClass("KK"));
+  EXPECT_NEAR(eq, 0.8195, 0.0005);
+  EXPECT_EQ(PreflopTable::computeHeadsUp(calc, 5, 5), 0.5);
+}
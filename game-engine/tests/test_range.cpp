@@ -0,0 +1,68 @@
+#include "utils/Range.h"
+#include <gtest/gtest.h>
+
+
+#include <set>
+
+using namespace poker::core;
+using namespace poker::utils;
+
+TEST(RangeTest, ComboIndexRoundTrip) {
+  std::set<size_t> seen;
+  for (unsigned i = 0; i < 52; ++i) {
+    for (unsigned j = i + 1; j < 52; ++j) {
+      Card a = CardSet::fromIndex(i);
+      Card b = CardSet::fromIndex(j);
+      size_t idx = Range::comboIndex(a, b);
+      ASSERT_LT(idx, Range::kNumCombos);
+      EXPECT_EQ(Range::comboIndex(b, a), idx);
+      EXPECT_EQ(Range::comboCards(idx), CardSet::of(a) | CardSet::of(b));
+      seen.insert(idx);
+    }
+  }
+  EXPECT_EQ(seen.size(), Range::kNumCombos);
+}
+
+TEST(RangeTest, ParsesHandClasses) {
+  EXPECT_EQ(Range::parse("AA").size(), 6u);
+  EXPECT_EQ(Range::parse("AKs").size(), 4u);
+  EXPECT_EQ(Range::parse("AKo").size(), 12u);
+  EXPECT_EQ(Range::parse("AK").size(), 16u);
+  EXPECT_EQ(Range::parse("KA").size(), 16u);
+  EXPECT_EQ(Range::parse("AsKd").size(), 1u);
+}
+
+TEST(RangeTest, ParsesPlusAndDashRanges) {
+  EXPECT_EQ(Range::parse("QQ+").size(), 18u);
+  EXPECT_EQ(Range::parse("A2s+").size(), 48u);
+  EXPECT_EQ(Range::parse("T9s-65s").size(), 20u);
+  EXPECT_EQ(Range::parse("65s-T9s").size(), 20u);
+  EXPECT_EQ(Range::parse("A5o-A2o").size(), 48u);
+  EXPECT_EQ(Range::parse("22-44").size(), 18u);
+  EXPECT_EQ(Range::parse("QQ+, AKs, T9s-65s").size(), 42u);
+}
+
+TEST(RangeTest, ParsesWeights) {
+  Range r = Range::parse("AA:0.5,KK");
+  Card as(Rank::Ace, Suit::Spades), ah(Rank::Ace, Suit::Hearts);
+  Card ks(Rank::King, Suit::Spades), kh(Rank::King, Suit::Hearts);
+  EXPECT_DOUBLE_EQ(r.weight(Range::comboIndex(as, ah)), 0.5);
+  EXPECT_DOUBLE_EQ(r.weight(Range::comboIndex(ks, kh)), 1.0);
+  EXPECT_DOUBLE_EQ(r.totalWeight(), 9.0);
+}
+
+TEST(RangeTest, RejectsMalformedInput) {
+  EXPECT_THROW((void)Range::parse("AX"), std::invalid_argument);
+  EXPECT_THROW((void)Range::parse("AAs"), std::invalid_argument);
+  EXPECT_THROW((void)Range::parse("AKs-QJo"), std::invalid_argument);
+  EXPECT_THROW((void)Range::parse("AKs-T8s"), std::invalid_argument);
+  EXPECT_THROW((void)Range::parse("AA,,KK"), std::invalid_argument);
+  EXPECT_THROW((void)Range::parse("AA:x"), std::invalid_argument);
+  EXPECT_THROW((void)Range::parse("AsAs"), std::invalid_argument);
+}
+
+TEST(RangeTest, WithoutRemovesBlockedCombos) {
+  Range r = Range::parse("AA").without(CardSet::of(Card(Rank::Ace, Suit::Spades)));
+  EXPECT_EQ(r.size(), 3u);
+  EXPECT_EQ(Range::full().size(), Range::kNumCombos);
+}
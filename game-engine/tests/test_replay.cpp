@@ -0,0 +1,207 @@
+#include "core/Random.h"
+#include "engine/HandHistory.h"
+#include "engine/PokerEngine.h"
+#include "engine/Replay.h"
+#include "test_helpers.h"
+#include <gtest/gtest.h>
+
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace poker::core;
+using namespace poker::engine;
+using namespace poker::test;
+
+namespace {
+
+/// Cycles through action types, so hands include raises, all-ins with side
+/// pots and folds; `next` is the position in the cycle.
+Action cycle(size_t &next, std::span<const Action> legal) {
+  const ActionType order[] = {ActionType::Call,  ActionType::Raise,
+                              ActionType::Check, ActionType::AllIn,
+                              ActionType::Fold,  ActionType::Bet,
+                              ActionType::Call};
+  const ActionType want = order[next++ % 7];
+  for (const auto &a : legal)
+    if (a.type == want)
+      return a;
+  return legal.front();
+}
+
+/// Plays `hands` hands into a history file; `decisions[h]` gets the state
+/// the engine offered the provider at each decision of hand h.
+void record(const std::string &path, size_t hands,
+            std::vector<std::vector<GameState>> &decisions,
+            std::vector<GameState> &finals) {
+  HandHistoryWriter writer(path);
+  // Remembers the state at every decision of the current hand.
+  std::vector<GameState> *seen = nullptr;
+  size_t next = 0;
+  auto provider =
+      makeProvider([&](const GameState &state, std::span<const Action> legal) {
+        seen->push_back(state);
+        return cycle(next, legal);
+      });
+  BasicPokerEngine<SharedActionProvider, Xoshiro256Generator,
+                   HandHistoryObserver>
+      engine(provider, Xoshiro256Generator(11), HandHistoryObserver{&writer});
+  decisions.resize(hands);
+  for (size_t h = 0; h < hands; ++h) {
+    GameState state = makeTable({300, 500, 700, 900}, h % 4);
+    seen = &decisions[h];
+    engine.playHand(state);
+    finals.push_back(state);
+  }
+}
+
+class ReplayTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = tempPath("poker_replay.phh");
+    record(path_, kHands, decisions_, finals_);
+  }
+  void TearDown() override { std::filesystem::remove(path_); }
+
+  static constexpr size_t kHands = 60;
+  std::string path_;
+  std::vector<std::vector<GameState>> decisions_;
+  std::vector<GameState> finals_;
+};
+
+} // namespace
+
+TEST_F(ReplayTest, EveryDecisionPointMatchesTheEngine) {
+  HandHistoryReader reader = HandHistoryReader::open(path_);
+  Replay replay(reader);
+  ASSERT_EQ(replay.size(), kHands);
+  size_t checked = 0;
+  for (uint64_t h = 0; h < kHands; ++h) {
+    for (const GameState &want : decisions_[h]) {
+      const size_t index = want.getActionHistory().size();
+      EXPECT_EQ(fingerprint(replay.stateAt(h, index)), fingerprint(want))
+          << "hand " << h << " action " << index;
+      ++checked;
+    }
+    // The end of the hand has the board run out and nothing left to bet.
+    const auto &last = replay.stateAt(h, replay.record(h).actions.size());
+    EXPECT_EQ(last.getCommunityCards(), finals_[h].getCommunityCards());
+    EXPECT_EQ(last.getActionHistory(), finals_[h].getActionHistory());
+  }
+  EXPECT_GT(checked, kHands * 4);
+}
+
+TEST_F(ReplayTest, RandomSeeksAgreeWithSequentialOnes) {
+  HandHistoryReader reader = HandHistoryReader::open(path_);
+  Replay sequential(reader);
+  Replay seeking(reader);
+  std::vector<std::pair<uint64_t, size_t>> points;
+  for (uint64_t h = 0; h < kHands; ++h) {
+    for (size_t i = 0; i <= sequential.record(h).actions.size(); ++i)
+      points.emplace_back(h, i);
+  }
+  std::vector<std::string> expected;
+  for (const auto &[h, i] : points)
+    expected.push_back(fingerprint(sequential.stateAt(h, i)));
+
+  Xoshiro256Generator rng(5);
+  for (size_t n = 0; n < 2000; ++n) {
+    const size_t k = rng.below(static_cast<uint32_t>(points.size()));
+    EXPECT_EQ(fingerprint(seeking.stateAt(points[k].first, points[k].second)),
+              expected[k]);
+  }
+  EXPECT_THROW((void)seeking.stateAt(kHands, 0), std::out_of_range);
+  EXPECT_THROW((void)seeking.stateAt(0, 1000), std::out_of_range);
+}
+
+TEST_F(ReplayTest, SidePotsFollowTheContributions) {
+  HandHistoryReader reader = HandHistoryReader::open(path_);
+  Replay replay(reader);
+  bool sawSidePot = false;
+  for (uint64_t h = 0; h < kHands; ++h) {
+    const size_t end = replay.record(h).actions.size();
+    for (size_t i = 0; i <= end; ++i) {
+      const GameState &state = replay.stateAt(h, i);
+      int64_t total = 0;
+      for (const SidePot &pot : replay.sidePots())
+        total += pot.amount;
+      EXPECT_EQ(total, state.getPot().getTotal());
+      sawSidePot |= replay.sidePots().size() > 1;
+    }
+  }
+  EXPECT_TRUE(sawSidePot);
+}
+
+TEST_F(ReplayTest, RerunFromAnyPointIsALegalHand) {
+  HandHistoryReader reader = HandHistoryReader::open(path_);
+  Replay replay(reader);
+  for (uint64_t h = 0; h < kHands; ++h) {
+    const HandRecord original = replay.record(h);
+    const size_t end = original.actions.size();
+
+    // Rerunning the end of the hand changes nothing.
+    HistoryProvider unused;
+    EXPECT_EQ(replay.rerun(h, end, unused), original);
+
+    // A different player from the first voluntary action on: the prefix
+    // is kept, chips are conserved, and the result replays cleanly.
+    ChoosingProvider other(
+        [next = size_t{3}](const GameState &,
+                           std::span<const Action> legal) mutable {
+          return cycle(next, legal);
+        });
+    const HandRecord alt = replay.rerun(h, Replay::kBlindActions, other, h);
+    ASSERT_GE(alt.actions.size(), Replay::kBlindActions);
+    EXPECT_EQ(alt.actions[0], original.actions[0]);
+    EXPECT_EQ(alt.holeCards, original.holeCards);
+    int64_t before = 0, after = 0;
+    for (size_t s = 0; s < alt.numSeats(); ++s) {
+      before += alt.startingStacks[s];
+      after += alt.finalStacks[s];
+    }
+    EXPECT_EQ(before, after);
+    for (size_t i = 0; i < std::min(original.board.size(), alt.board.size());
+         ++i)
+      EXPECT_EQ(alt.board[i], original.board[i]);
+
+    Replay check(std::vector<HandRecord>{alt});
+    EXPECT_NO_THROW((void)check.stateAt(h, alt.actions.size()));
+
+    // The recorded line is still there afterwards.
+    EXPECT_EQ(replay.stateAt(h, end).getActionHistory(), original.actions);
+  }
+}
+
+TEST(ReplayRecordTest, RejectsRecordsThatBreakTheRules) {
+  HandRecord r;
+  r.handId = 7;
+  r.dealer = 0;
+  r.smallBlind = 5;
+  r.bigBlind = 10;
+  r.startingStacks = {100, 100};
+  r.finalStacks = {100, 100};
+  r.holeCards = {CardSet::of(Card(Rank::Ace, Suit::Spades)) |
+                     CardSet::of(Card(Rank::Ace, Suit::Hearts)),
+                 CardSet::of(Card(Rank::King, Suit::Spades)) |
+                     CardSet::of(Card(Rank::King, Suit::Hearts))};
+  // Heads-up the dealer posts the small blind and acts first preflop.
+  r.actions = {Action(ActionType::Bet, 5, 0), Action(ActionType::Bet, 10, 1),
+               Action(ActionType::Fold, 0, 0)};
+  r.finalStacks = {95, 105};
+
+  HandRecord outOfTurn = r;
+  outOfTurn.handId = 8;
+  outOfTurn.actions[2].playerId = 1;
+  HandRecord noBlinds = r;
+  noBlinds.handId = 9;
+  noBlinds.actions = {Action(ActionType::Fold, 0, 0)};
+
+  Replay replay(std::vector<HandRecord>{r, outOfTurn, noBlinds});
+  EXPECT_EQ(replay.stateAt(7, 3).getPlayer(0).isFolded(), true);
+  EXPECT_EQ(replay.stateAt(7, 2).getCurrentPlayerIndex(), 0u);
+  EXPECT_THROW((void)replay.stateAt(8, 3), std::runtime_error);
+  EXPECT_THROW((void)replay.stateAt(9, 0), std::runtime_error);
+  EXPECT_THROW(Replay(std::vector<HandRecord>{r, r}), std::invalid_argument);
+}
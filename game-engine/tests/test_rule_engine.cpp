@@ -112,3 +112,113 @@ TEST_F(RuleEngineTest, AllInWhenNotEnoughChips) {
   }
   EXPECT_FALSE(hasCall);
 }
+
+TEST_F(RuleEngineTest, RoundMinRaiseIsLevelPlusLastFullRaise) {
+  state.setStreet(Street::Flop);
+  BettingRound round(2, 1, seatBit(0) | seatBit(1), 0, 10);
+  state.getMutablePlayer(1).placeBet(40);
+  round.playerActed(40, true); // seat 1 bets 40
+  EXPECT_EQ(RuleEngine::getCallAmount(state, round, 0), 40);
+  EXPECT_EQ(RuleEngine::getMinRaise(state, round, 0), 80);
+
+  state.getMutablePlayer(0).placeBet(100);
+  round.playerActed(100, true); // seat 0 raises by 60
+  EXPECT_EQ(RuleEngine::getCallAmount(state, round, 1), 60);
+  EXPECT_EQ(RuleEngine::getMinRaise(state, round, 1), 160);
+  // Raises put in chips: 120 more takes seat 1 from 40 to 160.
+  EXPECT_TRUE(RuleEngine::isActionLegal(state, round,
+                                        Action(ActionType::Raise, 120, 1)));
+  EXPECT_FALSE(RuleEngine::isActionLegal(state, round,
+                                         Action(ActionType::Raise, 119, 1)));
+}
+
+TEST_F(RuleEngineTest, RoundForbidsRaisingAfterAShortAllIn) {
+  std::vector<Player> players;
+  for (size_t i = 0; i < 3; ++i)
+    players.emplace_back(i, "P" + std::to_string(i), i == 2 ? 150 : 1000);
+  state.setPlayers(std::move(players));
+  state.setStreet(Street::Flop);
+  BettingRound round(3, 0, seatBit(0) | seatBit(1) | seatBit(2), 0, 10);
+  for (size_t seat = 0; seat < 2; ++seat) {
+    state.getMutablePlayer(seat).placeBet(100);
+    round.playerActed(100, true);
+  }
+  state.getMutablePlayer(2).placeBet(150);
+  round.playerActed(150, false);
+
+  ActionList legal;
+  RuleEngine::getLegalActions(state, round, 0, legal);
+  ASSERT_EQ(legal.size(), 2u);
+  EXPECT_EQ(legal[0].type, ActionType::Fold);
+  EXPECT_EQ(legal[1], Action(ActionType::Call, 50, 0));
+  EXPECT_FALSE(RuleEngine::isActionLegal(state, round,
+                                         Action(ActionType::AllIn, 900, 0)));
+}
+
+TEST_F(RuleEngineTest, RoundLegalityAgreesWithTheLegalList) {
+  std::vector<Player> players;
+  for (size_t i = 0; i < 3; ++i)
+    players.emplace_back(i, "P" + std::to_string(i), 60 + 70 * i);
+  state.setPlayers(std::move(players));
+  state.setStreet(Street::Flop);
+  BettingRound round(3, 0, seatBit(0) | seatBit(1) | seatBit(2), 0, 10);
+
+  // A few bet levels, checking every action type and amount each time.
+  const int64_t levels[] = {0, 10, 25, 45, 70, 200};
+  ActionList legal;
+  for (int64_t level : levels) {
+    for (size_t seat = 0; seat < 3; ++seat) {
+      RuleEngine::getLegalActions(state, round, seat, legal);
+      for (int t = 0; t <= static_cast<int>(ActionType::AllIn); ++t) {
+        for (int64_t amount = 0; amount <= 200; ++amount) {
+          const Action a(static_cast<ActionType>(t), amount, seat);
+          EXPECT_EQ(RuleEngine::isActionLegal(state, round, a),
+                    RuleEngine::isActionLegal(state, a, legal))
+              << "level " << level << " seat " << seat << " type " << t
+              << " amount " << amount;
+        }
+      }
+    }
+    const size_t seat = round.getCurrentPlayerIndex();
+    auto &p = state.getMutablePlayer(seat);
+    if (level > p.getCurrentBet()) {
+      (void)p.placeBet(std::min(level - p.getCurrentBet(), p.getChips()));
+      round.playerActed(p.getCurrentBet(), !p.isAllIn());
+    }
+    if (round.isComplete())
+      break;
+  }
+}
+
+TEST(RuleEngineShowdownTest, SplitPotGivesOddChipsToTheLowestWinners) {
+  std::vector<Player> players;
+  for (size_t i = 0; i < 4; ++i)
+    players.emplace_back(i, "P" + std::to_string(i), 0);
+  players[0].dealCard(Card(Rank::Two, Suit::Hearts));
+  players[0].dealCard(Card(Rank::Three, Suit::Hearts));
+  players[1].dealCard(Card(Rank::Nine, Suit::Spades)); // straight flush
+  players[1].dealCard(Card(Rank::Four, Suit::Hearts));
+  players[2].dealCard(Card(Rank::Two, Suit::Clubs));
+  players[2].dealCard(Card(Rank::Three, Suit::Clubs));
+  players[3].dealCard(Card(Rank::Two, Suit::Diamonds));
+  players[3].dealCard(Card(Rank::Three, Suit::Diamonds));
+  CardSet board;
+  for (Rank r : {Rank::King, Rank::Queen, Rank::Jack, Rank::Ten})
+    board.insert(Card(r, Suit::Spades));
+  board.insert(Card(Rank::Five, Suit::Clubs));
+
+  // Seat 1 wins outright.
+  const auto outright = RuleEngine::splitPot({101, 0b1111}, players, board);
+  EXPECT_EQ(outright.winners, 0b0010u);
+  EXPECT_EQ(outright.award(1), 101);
+  EXPECT_EQ(outright.award(0), 0);
+
+  // Without it, three seats play the board: 33 each, odd chips to 0 and 2.
+  const auto tied = RuleEngine::splitPot({101, 0b1101}, players, board);
+  EXPECT_EQ(tied.winners, 0b1101u);
+  EXPECT_EQ(tied.award(0), 34);
+  EXPECT_EQ(tied.award(2), 34);
+  EXPECT_EQ(tied.award(3), 33);
+
+  EXPECT_EQ(RuleEngine::splitPot({50, 0}, players, board).winners, 0u);
+}
@@ -0,0 +1,94 @@
+#include "sim/BasicStrategies.h"
+#include "sim/SelfPlayRunner.h"
+#include <gtest/gtest.h>
+
+
+#include <memory>
+
+using namespace poker::core;
+using namespace poker::sim;
+
+namespace {
+
+SelfPlayRunner makeRunner(SelfPlayConfig config) {
+  SelfPlayRunner runner(config);
+  runner.addStrategy("calling", [](uint64_t) {
+    return std::make_unique<CallingStrategy>();
+  });
+  runner.addStrategy("aggressive", [](uint64_t) {
+    return std::make_unique<AggressiveStrategy>();
+  });
+  runner.addStrategy("random", [](uint64_t seed) {
+    return std::make_unique<RandomStrategy>(seed);
+  });
+  return runner;
+}
+
+} // namespace
+
+TEST(SelfPlayRunnerTest, ChipsAreConservedAndEverySeatCounted) {
+  SelfPlayConfig config;
+  config.numTables = 12;
+  config.handsPerTable = 50;
+  auto result = makeRunner(config).run(2);
+
+  EXPECT_EQ(result.hands, 600u);
+  ASSERT_EQ(result.strategies.size(), 3u);
+  uint64_t seatHands = 0;
+  int64_t net = 0;
+  for (const auto &s : result.strategies) {
+    EXPECT_EQ(s.seatHands, 600u); // 3 seats, one strategy each.
+    EXPECT_GT(s.ci95, 0.0);
+    seatHands += s.seatHands;
+    net += s.netChips;
+  }
+  EXPECT_EQ(seatHands, 1800u);
+  EXPECT_EQ(net, 0);
+  EXPECT_GT(result.handsPerSecond, 0.0);
+}
+
+TEST(SelfPlayRunnerTest, ResultsDoNotDependOnThreadCount) {
+  SelfPlayConfig config;
+  config.numTables = 16;
+  config.handsPerTable = 40;
+  config.seatsPerTable = 6;
+  auto runner = makeRunner(config);
+  auto one = runner.run(1);
+  auto four = runner.run(4);
+  ASSERT_EQ(one.strategies.size(), four.strategies.size());
+  for (size_t i = 0; i < one.strategies.size(); ++i) {
+    EXPECT_EQ(one.strategies[i].seatHands, four.strategies[i].seatHands);
+    EXPECT_EQ(one.strategies[i].netChips, four.strategies[i].netChips);
+    EXPECT_EQ(one.strategies[i].bbPer100, four.strategies[i].bbPer100);
+    EXPECT_EQ(one.strategies[i].ci95, four.strategies[i].ci95);
+  }
+
+  config.seed = 2;
+  auto reseeded = makeRunner(config).run(4);
+  EXPECT_NE(reseeded.strategies[0].netChips, one.strategies[0].netChips);
+}
+
+TEST(SelfPlayRunnerTest, ScalingReportsEveryThreadCount) {
+  SelfPlayConfig config;
+  config.numTables = 8;
+  config.handsPerTable = 20;
+  const size_t counts[] = {1, 2};
+  auto points = makeRunner(config).measureScaling(counts);
+  ASSERT_EQ(points.size(), 2u);
+  EXPECT_EQ(points[0].threads, 1u);
+  EXPECT_EQ(points[0].efficiency, 1.0);
+  EXPECT_EQ(points[1].threads, 2u);
+  EXPECT_GT(points[1].speedup, 0.0);
+}
+
+TEST(SelfPlayRunnerTest, RejectsUnusableConfigurations) {
+  SelfPlayRunner empty;
+  EXPECT_THROW((void)empty.run(1), std::invalid_argument);
+
+  SelfPlayConfig config;
+  config.seatsPerTable = 1;
+  EXPECT_THROW((void)makeRunner(config).run(1), std::invalid_argument);
+  config.seatsPerTable = 23; // more than one deck can deal
+  EXPECT_THROW((void)makeRunner(config).run(1), std::invalid_argument);
+  EXPECT_THROW(empty.addStrategy("none", nullptr), std::invalid_argument);
+}
@@ -0,0 +1,50 @@
+#include "utils/ThreadPool.h"
+#include <gtest/gtest.h>
+
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace poker::utils;
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  ThreadPool pool(4);
+  for (size_t count : {0u, 1u, 3u, 1000u}) {
+    std::vector<std::atomic<int>> hits(count);
+    pool.parallelFor(count, [&](size_t i, size_t worker) {
+      EXPECT_LT(worker, pool.size());
+      hits[i].fetch_add(1);
+    });
+    for (size_t i = 0; i < count; ++i)
+      EXPECT_EQ(hits[i].load(), 1) << "index " << i;
+  }
+}
+
+TEST(ThreadPoolTest, ParallelForStealsFromSlowWorkers) {
+  // All the slow items sit in worker 0's initial slice; the others must
+  // take over the rest of it for the run to finish quickly.
+  ThreadPool pool(4);
+  std::vector<size_t> ranBy(64);
+  pool.parallelFor(ranBy.size(), [&](size_t i, size_t worker) {
+    if (i < 16)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ranBy[i] = worker;
+  });
+  size_t stolen = 0;
+  for (size_t i = 0; i < 16; ++i)
+    stolen += ranBy[i] != 0;
+  EXPECT_GT(stolen, 0u);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrows) {
+  ThreadPool pool(3);
+  EXPECT_THROW(pool.parallelFor(100,
+                                [](size_t i, size_t) {
+                                  if (i == 42)
+                                    throw std::runtime_error("boom");
+                                }),
+               std::runtime_error);
+}
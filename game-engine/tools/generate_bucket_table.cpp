@@ -0,0 +1,82 @@
+#include "utils/BucketTable.h"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace poker::utils;
+
+// ────────────────────────────────────────────────────────
+// Builds the card abstraction: equities of every river class, equity
+// histograms of every flop and turn class, k-means per street, and writes
+// the buckets as a BucketTable file.
+//
+//   generate_bucket_table <output.bin> [--threads N] [--buckets P,F,T,R]
+//                         [--bins N] [--iterations N] [--seed N]
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+int usage() {
+  std::fprintf(stderr,
+               "usage: generate_bucket_table <output.bin> [--threads N] "
+               "[--buckets P,F,T,R] [--bins N] [--iterations N] [--seed N]\n");
+  return 2;
+}
+
+bool parseBuckets(const char *text, std::array<size_t, 4> &out) {
+  char *end = nullptr;
+  for (size_t s = 0; s < out.size(); ++s) {
+    out[s] = std::strtoul(text, &end, 10);
+    if (end == text || (s + 1 < out.size() ? *end != ',' : *end != '\0'))
+      return false;
+    text = end + 1;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2)
+    return usage();
+  const std::string output = argv[1];
+  BucketBuildOptions options;
+  for (int i = 2; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      return usage();
+    if (arg == "--threads") {
+      options.threads = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--buckets") {
+      if (!parseBuckets(argv[++i], options.buckets))
+        return usage();
+    } else if (arg == "--bins") {
+      options.histogramBins = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--iterations") {
+      options.iterations = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--seed") {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else {
+      return usage();
+    }
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+  };
+  options.progress = [&](const std::string &stage) {
+    std::printf("%-16s %8.1f s\n", stage.c_str(), elapsed());
+    std::fflush(stdout);
+  };
+
+  const auto buckets = BucketTable::build(options);
+  BucketTable::write(output, buckets);
+  std::printf("wrote %s in %.1f s\n", output.c_str(), elapsed());
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include "utils/EquityCalculator.h"
+#include "utils/PreflopTable.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace poker::utils;
+
+// ────────────────────────────────────────────────────────
+// Computes exact preflop all-in equities for every heads-up class matchup
+// and a set of common 3-way spots, and writes them as a PreflopTable file.
+//
+//   generate_preflop_table <output.bin> [--threads N] [--no-three-way]
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+/// Classes whose 3-way confrontations come up often enough to tabulate.
+constexpr const char *kThreeWayClasses[] = {"AA", "KK",  "QQ",  "JJ",
+                                            "TT", "AKs", "AKo", "AQs"};
+
+int usage() {
+  std::fprintf(stderr, "usage: generate_preflop_table <output.bin> "
+                       "[--threads N] [--no-three-way]\n");
+  return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2)
+    return usage();
+  const std::string output = argv[1];
+  size_t threads = 0;
+  bool threeWay = true;
+  for (int i = 2; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--threads" && i + 1 < argc) {
+      threads = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--no-three-way") {
+      threeWay = false;
+    } else {
+      return usage();
+    }
+  }
+
+  EquityCalculator calc(threads);
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+  };
+
+  constexpr size_t n = PreflopTable::kNumClasses;
+  std::vector<float> headsUp(n * n);
+  for (size_t hero = 0; hero < n; ++hero) {
+    for (size_t villain = hero; villain < n; ++villain) {
+      const double eq = PreflopTable::computeHeadsUp(calc, hero, villain);
+      headsUp[hero * n + villain] = static_cast<float>(eq);
+      headsUp[villain * n + hero] = static_cast<float>(1.0 - eq);
+    }
+    std::printf("heads-up %3zu/%zu  %-3s  %8.1f s\n", hero + 1, n,
+                PreflopTable::className(hero).c_str(), elapsed());
+    std::fflush(stdout);
+  }
+
+  std::vector<PreflopTable::ThreeWaySpot> spots;
+  if (threeWay) {
+    std::vector<size_t> classes;
+    for (const char *name : kThreeWayClasses)
+      classes.push_back(PreflopTable::handClass(name));
+    for (size_t a = 0; a < classes.size(); ++a) {
+      for (size_t b = a + 1; b < classes.size(); ++b) {
+        for (size_t c = b + 1; c < classes.size(); ++c) {
+          std::array<size_t, 3> spot = {classes[a], classes[b], classes[c]};
+          auto eq = PreflopTable::computeThreeWay(calc, spot);
+          PreflopTable::ThreeWaySpot entry;
+          for (size_t i = 0; i < 3; ++i) {
+            entry.classes[i] = static_cast<uint8_t>(spot[i]);
+            entry.equity[i] = static_cast<float>(eq[i]);
+          }
+          spots.push_back(entry);
+          std::printf("3-way %s/%s/%s  %.4f %.4f %.4f  %8.1f s\n",
+                      kThreeWayClasses[a], kThreeWayClasses[b],
+                      kThreeWayClasses[c], eq[0], eq[1], eq[2], elapsed());
+          std::fflush(stdout);
+        }
+      }
+    }
+  }
+
+  PreflopTable::write(output, headsUp, spots);
+  std::printf("wrote %s (%zu 3-way spots) in %.1f s\n", output.c_str(),
+              spots.size(), elapsed());
+  return 0;
+}
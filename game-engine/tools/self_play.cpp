@@ -0,0 +1,152 @@
+#include "sim/BasicStrategies.h"
+#include "sim/SelfPlayRunner.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace poker::sim;
+
+// ────────────────────────────────────────────────────────
+// Plays the built-in strategies against each other on many parallel tables
+// and reports bb/100 per strategy with 95% confidence intervals.
+//
+//   self_play [--tables N] [--hands N] [--seats N] [--threads N]
+//             [--seed S] [--scaling 1,2,4,...] [strategy ...]
+//
+// Strategies: calling, aggressive, random (default: all three).
+// ────────────────────────────────────────────────────────
+
+namespace {
+
+int usage() {
+  std::fprintf(stderr,
+               "usage: self_play [--tables N] [--hands N] [--seats N] "
+               "[--threads N] [--seed S] [--scaling 1,2,4,...] "
+               "[calling|aggressive|random ...]\n");
+  return 2;
+}
+
+bool addBuiltin(SelfPlayRunner &runner, const std::string &name) {
+  if (name == "calling") {
+    runner.addStrategy(name, [](uint64_t) {
+      return std::make_unique<CallingStrategy>();
+    });
+  } else if (name == "aggressive") {
+    runner.addStrategy(name, [](uint64_t) {
+      return std::make_unique<AggressiveStrategy>();
+    });
+  } else if (name == "random") {
+    runner.addStrategy(name, [](uint64_t seed) {
+      return std::make_unique<RandomStrategy>(seed);
+    });
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// Parse `text` as a whole non-negative decimal number that fits `out`.
+template <typename T> bool parseNumber(const std::string &text, T &out) {
+  if (text.empty() || text[0] < '0' || text[0] > '9')
+    return false;
+  char *end = nullptr;
+  errno = 0;
+  const unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+  if (errno != 0 || *end != '\0' || value > std::numeric_limits<T>::max())
+    return false;
+  out = static_cast<T>(value);
+  return true;
+}
+
+bool parseList(const std::string &text, std::vector<size_t> &values) {
+  size_t pos = 0;
+  while (pos <= text.size()) {
+    size_t comma = text.find(',', pos);
+    if (comma == std::string::npos)
+      comma = text.size();
+    size_t value = 0;
+    if (!parseNumber(text.substr(pos, comma - pos), value))
+      return false;
+    values.push_back(value);
+    pos = comma + 1;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  SelfPlayConfig config;
+  size_t threads = 0;
+  std::vector<size_t> scaling;
+  std::vector<std::string> strategies;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    bool ok = true;
+    if (arg == "--tables" && hasValue) {
+      ok = parseNumber(argv[++i], config.numTables);
+    } else if (arg == "--hands" && hasValue) {
+      ok = parseNumber(argv[++i], config.handsPerTable);
+    } else if (arg == "--seats" && hasValue) {
+      ok = parseNumber(argv[++i], config.seatsPerTable);
+    } else if (arg == "--threads" && hasValue) {
+      ok = parseNumber(argv[++i], threads);
+    } else if (arg == "--seed" && hasValue) {
+      ok = parseNumber(argv[++i], config.seed);
+    } else if (arg == "--scaling" && hasValue) {
+      ok = parseList(argv[++i], scaling);
+    } else if (!arg.starts_with("--")) {
+      strategies.push_back(arg);
+    } else {
+      return usage();
+    }
+    if (!ok) {
+      std::fprintf(stderr, "bad value '%s' for %s\n", argv[i], arg.c_str());
+      return usage();
+    }
+  }
+  if (strategies.empty())
+    strategies = {"calling", "aggressive", "random"};
+
+  SelfPlayRunner runner(config);
+  for (const auto &name : strategies) {
+    if (!addBuiltin(runner, name)) {
+      std::fprintf(stderr, "unknown strategy '%s'\n", name.c_str());
+      return usage();
+    }
+  }
+
+  try {
+    const SelfPlayResult result = runner.run(threads);
+    std::printf("%llu hands on %zu tables, %zu threads: %.2f s, %.0f hands/s\n",
+                static_cast<unsigned long long>(result.hands), config.numTables,
+                result.threads, result.elapsedSeconds, result.handsPerSecond);
+    std::printf("  %-12s %12s %14s %10s %10s\n", "strategy", "seat-hands",
+                "net chips", "bb/100", "±95%");
+    for (const auto &s : result.strategies) {
+      std::printf("  %-12s %12llu %14lld %10.2f %10.2f\n", s.name.c_str(),
+                  static_cast<unsigned long long>(s.seatHands),
+                  static_cast<long long>(s.netChips), s.bbPer100, s.ci95);
+    }
+
+    if (!scaling.empty()) {
+      std::printf("\nscaling\n  %8s %12s %9s %11s\n", "threads", "hands/s",
+                  "speedup", "efficiency");
+      for (const auto &p : runner.measureScaling(scaling)) {
+        std::printf("  %8zu %12.0f %8.2fx %10.1f%%\n", p.threads,
+                    p.handsPerSecond, p.speedup, 100.0 * p.efficiency);
+      }
+    }
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return usage();
+  }
+  return 0;
+}